@@ -3,7 +3,8 @@
 /** \Author redstoner_35
 /** \Project Xtern Ripper Laser Edition
 /** \Description ļϵͳADCϵͳĸģң񣬰첽
-תADCʵ
+תADCʵ֡ADCתжÿͨӵжۼ
+λţѭֻҪŷ仯ͨ
 **
 **	History: Initial Release
 **	
@@ -17,16 +18,23 @@
 #include "GPIO.h"
 #include "ADCASync.h"
 #include "delay.h"
+#include "TaskProfiler.h"
+#include "FastOp.h"
 
 /****************************************************************************/
 /*	Local pre-processor symbols/macros('#define')
 ****************************************************************************/
+#define ADCSyncTimeout 50000 //ͬģʽȴתѯ(Զƽʱ䣬ʱֱʹн)
 
 /****************************************************************************/
 /*	Global variable definitions(declared in header file with 'extern')
 ****************************************************************************/
 bit IsNotAllowAsync;	 //ǷADC첽ģʽ
 ADCResultStrDef Data;	 //ADC
+#ifdef EnableTaskProfiler
+xdata unsigned long ADCConvCounter; //ADCɵЧתڵڶԱζĲֵɵõÿת
+xdata unsigned long ADCDiscardCounter; //ADCΪͨͻ׼лת
+#endif
 
 /****************************************************************************/
 /*	Local type definitions('typedef')
@@ -35,193 +43,251 @@ ADCResultStrDef Data;	 //ADC
 /****************************************************************************/
 /*	Local variable  definitions('static')
 
-ע⣡ºΪADC첽תʵֹڲԼڲȫֱ
+ע⣡ºΪADCжתʵֹڲԼڲȫֱ
 벻Ҫ޸ĺݣڳ˱ļڵκεطã
 ᵼADC湤쳣	
 ****************************************************************************/
-static xdata ADCConvertTemp ADCTemp;
-static ADCAsyncStateDef ADCState;	
-static xdata char ADCConvertQueue[ADCConvertQueueDepth];	
+static xdata ADCChannelStrDef ADCCh[ADCChannelCount]; //ÿͨۼͻλ(ADCжд)
+static xdata unsigned char ADCLastSeq[ADCChannelCount]; //ѭѾÿͨ
+static volatile unsigned char ADCChIdx; //ǰתͨͨеλ
+static unsigned char ADCRRIdx; //ͨѯȵλ(VOUTģʽ²VOUTתӰѯλ)
+static volatile bit IsADCVOUTBoost; //VOUTģʽÿתһͨͲһVOUTת
+static unsigned char ADCVOUTChIdx; //ѹͨͨеλ(ʼʱͨвңҲʱΪADCChannelCount)
+static bit IsADCUsingVDDRef; //ADCǰʹõĻ׼(1=MCUVDD0=Ƭ2.0V׼)
+static unsigned char ADCDiscardCnt; //ǰͨҪת
 
 /****************************************************************************/
 /*	Local function implantation('static')
 ****************************************************************************/
-//ADCύµת	
-static void ADC_SubmitMisson(char Ch)	
+//ADCõѹο(ADCжϵ)
+static void ADC_SetVREF(bit IsUsingVDD)
 	{
-	unsigned char i=ADCWaitChannelSelTime;
-	//鴫ͨǷϷ
-	if(ADCTemp.IsMissionProcessing)return;
-	if(ADC_CheckIfChInvalid(Ch))return; 
-	//гʼ
-	ADCTemp.avgbuf=0;
-	ADCTemp.Count=0;
-	ADCTemp.Ch=Ch;
-	ADCTemp.IsMissionProcessing=true;
-	//ADCͨ		
-	if(Ch&0x10)ADCON0|=0x80;
-	else ADCON0&=0x7F; //ADCHS[4]
-	ADCON1&=0xF0;
-	ADCON1|=(Ch&0x0F); //ADCHS[3:0]					
-	//ת
-	while(--i);  			//ʱȴͨѡͨʼ
-	ADC_StartConv();
-	}	
+	IsADCUsingVDDRef=IsUsingVDD; //¼ǰ׼
+	ADC_DisableCmd(); //תADC׼ҪʱرADC	
+	_nop_();
+	ADC_SetVREFReg(IsUsingVDD); //оƬڲ׼
+	_nop_();
+	ADC_EnableCmd(); //׼лϣ
+	}
 
-//ȡ
-static int ADC_ReadBackResult(int *Result,char *Queue)	
+//ѡָͨͨλõͨת(ADCжϵ)
+static void ADC_SelectChannel(unsigned char Idx)
 	{
-	//ADCδɱת
-	if(ADC_GetIfStillConv())return 0; 
-	//ȡ
-	ADCTemp.Count++; //ֵ+1
-	ADCTemp.avgbuf+=(long)ADC_ReadConvResult(); //ADĴȡƽۼ
-	if(ADCTemp.Count<ADCAverageCount) 
+	ADCChCfgDef code *Cfg=&ADCChCfg[Idx];
+	//ֻл׼ͬʱû׼л׼Ҫת
+	if(Cfg->IsUsingVDDRef!=(unsigned char)IsADCUsingVDDRef)
 		{
-		ADC_StartConv();
-		return 0;//ƽδADCһֵĴ
+		ADC_SetVREF(Cfg->IsUsingVDDRef);
+		ADCDiscardCnt=ADCRefSwitchDiscard;
 		}
-	//תؽ׼ύµ
-	ADCTemp.avgbuf/=(long)ADCAverageCount;
-	*Result=(int)ADCTemp.avgbuf; //ؽ
-	*Queue=ADCTemp.Ch; //תĶ
-	ADCTemp.IsMissionProcessing=false; //Ѵ
-  return 1;	
+	else ADCDiscardCnt=ADCChSwitchDiscard;
+	//ADCͨתͨڼתᱻ
+	ADC_SetChannelReg(Cfg->Ch);
+	ADC_StartConv();
 	}
 
-//ADCõѹο	
-static void ADC_SetVREF(bit IsUsingVDD)
+//ÿͨתѡһҪתͨ(ADCжϵ)
+static unsigned char ADC_GetNextChIdx(void)
 	{
-	ADC_DisableCmd(); //תADC׼ҪʱرADC	
-	_nop_();
-	ADC_SetVREFReg(IsUsingVDD); //оƬڲ׼
-	_nop_();
-	ADC_EnableCmd(); //׼лϣ
+	ADCChannelStrDef xdata *Chn;
+	//VOUTģʽͨתϺһVOUTת
+	if(IsADCVOUTBoost&&ADCChIdx!=ADCVOUTChIdx)return ADCVOUTChIdx;
+	//תѯͨ(ͬģʽͨÿֶҪת)
+	do
+		{
+		if(++ADCRRIdx>=ADCChannelCount)ADCRRIdx=0;
+		Chn=&ADCCh[ADCRRIdx];
+		if(IsNotAllowAsync)break;
+		//ûеתʱ䣬
+		if(Chn->SkipCnt)
+			{
+			Chn->SkipCnt--;
+			continue;
+			}
+		//VOUTģʽƳٺVOUTʹòͬ׼ͨ(ִת״̬)л׼Ƴٴﵽ޺һ
+		if(IsADCVOUTBoost&&ADCChCfg[ADCRRIdx].IsUsingVDDRef!=ADCChCfg[ADCVOUTChIdx].IsUsingVDDRef&&Chn->DeferCnt<ADCBoostMaxDefer)
+			{
+			Chn->DeferCnt++;
+			continue;
+			}
+		break;
+		}
+	while(1);
+	Chn->DeferCnt=0;
+	Chn->SkipCnt=ADCChCfg[ADCRRIdx].Interval-1; //װת
+	return ADCRRIdx;
 	}
 	
+/****************************************************************************/
+/*	Interrupt Handler functions(Process ADC Interrupts)
+****************************************************************************/
+void ADC_IRQHandler(void) interrupt ADC_VECTOR  //ADCתжϴ
+{
+	ADCChannelStrDef xdata *Chn;
+	unsigned char Idx;
+	//жϱ־
+	ADC_ClearIntFlag();
+	//ͨ׼лν
+	if(ADCDiscardCnt)
+		{
+		ADCDiscardCnt--;
+		#ifdef EnableTaskProfiler
+		ADCDiscardCounter++;
+		#endif
+		ADC_StartConv(); 
+		return;
+		}
+	#ifdef EnableTaskProfiler
+	ADCConvCounter++;
+	#endif
+	//ȡ
+	Chn=&ADCCh[ADCChIdx];
+	Chn->AccBuf+=ADC_ReadConvResult(); //ADĴȡƽۼ
+	if(++Chn->Count<ADCChCfg[ADCChIdx].AvgDepth)
+		{
+		ADC_StartConv(); //ƽδADCһֵת
+		return;
+		}
+	//ƽд뻷λһλ֮ٸţ֤ѭȡŶӦѾд
+	Chn->Ring[(Chn->Seq+1)&(ADCRingDepth-1)]=Chn->AccBuf/Chn->Count;
+	Chn->Seq++;
+	Chn->AccBuf=0;
+	Chn->Count=0;
+	//лһͨתһͨ͵ǰͨͬʱֱת
+	Idx=ADC_GetNextChIdx();
+	if(Idx==ADCChIdx)ADC_StartConv();
+	else
+		{
+		ADCChIdx=Idx;
+		ADC_SelectChannel(Idx);
+		}
+}
+	
 //תϺд
-int	CalcNTCTemp(bool *IsNTCOK,unsigned long NTCRes); //		
+int	CalcNTCTemp(bool *IsNTCOK,unsigned int ADCCode); //		
 
 static void ADC_WriteOutputBuf(int ADCResult,char Ch)
 	{
-	float Buf,Rt,Vadc;
-	unsigned long NTCRES;
 	extern bit IsEnable2SMode;
-	//ADC
-	Rt=ADC_IsUsingIVREF()?ADCVREF:Data.MCUVDD; //ݻ׼õõADǰĻ׼ѹ
-	Vadc=(float)ADCResult*(Rt/(float)4096);//ADֵתΪԭʼѹ
 	//״̬
   switch(Ch)
 		{
 		//οѹ
 		case ADC_INTVREFCh:
-			Data.MCUVDD=ADCBGVREF*(float)4096/(float)ADCResult; //MCUVDD(VREF)
+		  if(!ADCResult)break; //쳣
+		  Data.VBGADCode=(unsigned int)ADCResult; //ԭʼADֵVDDڸֵû
+			Data.MCUVDD=(int)(((unsigned long)ADCBGVREFmV*4096UL)/(unsigned long)ADCResult); //MCUVDD(VREF)
+		  //VDDĵڴ϶׼ADֵQ16=ADֵ*65536/(4096*VBG)Ҫɵõ
+		  Data.MCUVDDRecip=(unsigned int)(((unsigned long)ADCResult*(65536000UL/4096UL))/ADCBGVREFmV);
 		  break; 
 		//صѹ
 		case VBATInputAIN:
-			//ԭʼصѹ
-			#define VBatTotalResistor (VBattLowerResK+VBattUpperResK)
-			Buf=(float)VBattLowerResK/(float)VBatTotalResistor;//ѹϵ
-			Data.RawBattVolt=Vadc/Buf; //ݷѹϵƳصѹ
-			#undef VBatTotalResistor
+			//ԭʼصѹ(ϵѾ˻׼ѹͷѹ)
+			Data.RawBattVolt=(int)(((unsigned long)ADCResult*VBattScaleK)>>12);
 		  //ϵͳģʽ2S/1Sģʽ
-		  if(IsEnable2SMode)Data.BatteryVoltage=Data.RawBattVolt/2;
+		  if(IsEnable2SMode)Data.BatteryVoltage=Data.RawBattVolt>>1;
 		  else Data.BatteryVoltage=Data.RawBattVolt;	  
 		  break;
 	  //ѹ
 		case VOUTFBAIN:		
-			#define VoutTotalResistor (VoutLowerResK+VoutUpperResK)
-			Buf=(float)VoutLowerResK/(float)VoutTotalResistor;//ѹϵ
-			Data.OutputVoltage=Vadc/Buf;          //ݷѹϵƳDCDCѹ
-		  #undef VoutTotalResistor
+			Data.OutputVoltage=(int)(((unsigned long)ADCResult*VoutScaleK)>>12); //ݷѹϵƳDCDCѹ
 		  break;
     //¶
 		case NTCInputAIN:
-			Rt=((float)NTCUpperResValueK*Vadc)/(Data.MCUVDD-Vadc);//õNTC+ƬIOͨĴֵ
-			Rt*=1000; //ֵKŷתΪ
-			NTCRES=(unsigned long)Rt; //ȡ
-			Data.Systemp=CalcNTCTemp(&Data.IsNTCOK,NTCRES); //¶
+			//NTCVDDϣʹVDDΪ׼תʱADֵֵֻйأֱʹADֵ
+			Data.SystempX10=CalcNTCTemp(&Data.IsNTCOK,ADCResult); //¶
+			//õ¶
+			if(IsNegative16(Data.SystempX10))Data.Systemp=(Data.SystempX10-5)/10;
+			else Data.Systemp=(Data.SystempX10+5)/10;
 			break;
 		}
   }
 
-//ADC첽
-static void ADCEngineHandler(void)
-	{
-	int result;
-	char Ch,i;
-	//תѭ
-  do
-		{
-		if(ADCState==ADC_ConvertComplete)ADCState=ADC_SubmitQueue; //һת¿ʼ
-		switch(ADCState)
-			{		
-			//ʼύת
-			case ADC_SubmitQueue: 
-				ADC_SetVREF(1); //ÿύ֮ǰû׼ʹMCUVDDת¶ȺMCUVDDѹ
-				for(i=0;i<ADCConvertQueueDepth;i++)ADCConvertQueue[i]=ADCChQueue[i]; //תݸƹȥ
-			  ADCState=ADC_SubmitChFromQueue;
-			  break;
-		  //ADCת߳ύ
-			case ADC_SubmitChFromQueue: 
-			  i=0;
-			  while(i<ADCConvertQueueDepth)
-					{
-					if(!ADC_CheckIfChInvalid(ADCConvertQueue[i]))break; //ҵδɵĺϷתĿ
-					i++;
-					}
-				//תĿδ
-				if(i<ADCConvertQueueDepth)	
-					{
-					Ch=ADCConvertQueue[i]; //Ŀֵͨ
-          if(Ch==VBATInputAIN||Ch==VOUTFBAIN)ADC_SetVREF(0); //غѹתʹڲͨ
-					ADC_SubmitMisson(Ch); //ύĿ
-					ADCState=ADC_WaitMissionDone;
-					}
-				//תɣתɽ׶
-  			else ADCState=ADC_ConvertComplete;		
-			  break;	
-			//ύ߳ȴ
-      case ADC_WaitMissionDone:
-          if(!ADC_ReadBackResult(&result,&Ch))break; //Զȡתδ
-			    ADC_WriteOutputBuf(result,Ch);
-			    for(i=0;i<ADCConvertQueueDepth;i++)if(ADCConvertQueue[i]==Ch)ADCConvertQueue[i]=-2; //ǰѾתͨΪ-2ת
-			    ADCState=ADC_SubmitChFromQueue; //»صύĽ׶
-			    break;
-			//
-			case ADC_ConvertComplete:break;
-			//κηǷ״̬תʼ׶
-			default:ADCState=ADC_SubmitQueue;
-			}
-		}
-	while(IsNotAllowAsync&&ADCState!=ADC_ConvertComplete);
-	}	
-
 /****************************************************************************/
 /* Global Function implementation
 	
-ע⣺ºΪADC첽תԼADCĳʼͳܲȡⲿͨ
+ע⣺ºΪADCжתԼADCĳʼͳܲȡⲿͨ
 ĵѹⲿáڳʼ׶κڵ
-ĺADCгʼͳܲԼADC첽
+ĺADCгʼͳܲԼת
 ****************************************************************************/	
 
+//ȡָͨѾдDataת(ÿһƽת+1)ű仯˵DataڸͨѾ
+unsigned char ADC_GetChSeq(char Ch)
+	{
+	unsigned char i;
+	for(i=0;i<ADCChannelCount;i++)if(ADCChCfg[i].Ch==Ch)return ADCLastSeq[i];
+	return 0;
+	}
+
+//VOUTģʽͨ͹ڼ俪ʹVOUTת
+void ADC_SetVOUTBoost(bit IsEnable)
+	{
+	//ͨûVOUTͨģʽЧ
+	if(ADCVOUTChIdx>=ADCChannelCount)return;
+	IsADCVOUTBoost=IsEnable;
+	}
+
+//дݵͨ
+static void ADC_ProcessNewData(void)
+	{
+	unsigned char i,Seq;
+	for(i=0;i<ADCChannelCount;i++)
+		{
+		Seq=ADCCh[i].Seq;
+		if(Seq==ADCLastSeq[i])continue;
+		ADCLastSeq[i]=Seq;
+		ADC_WriteOutputBuf(ADCCh[i].Ring[Seq&(ADCRingDepth-1)],ADCChCfg[i].Ch);
+		}
+	}
+
 //ݻȡ	
 void SystemTelemHandler(void)
 	{
-  //ADC첽
-	ADCEngineHandler();
+	unsigned char i;
+	unsigned int Timeout=ADCSyncTimeout;
+	//жѾɵת
+	ADC_ProcessNewData();
+	if(!IsNotAllowAsync)return;
+	//ADCжУжϱرʱ(Flashڼ)ܵȵ½ֱʹн
+	if(!EA)return;
+	//ͬģʽȴÿͨƽ(ȷһȫڱε֮)ʱת
+	for(i=0;i<ADCChannelCount;i++)while((unsigned char)(ADCCh[i].Seq-ADCLastSeq[i])<2)
+		{
+		if(!Timeout)return; //ȴʱADCѾֹͣУܿ
+		Timeout--;
+		}
+	//
+	ADC_ProcessNewData();
 	}	
 	
-//λADC첽
+//λADCж
 static void ResetADCAsyncEngine(void)	
 	{
 	unsigned char i;	
-	for(i=0;i<ADCConvertQueueDepth;i++)ADCConvertQueue[i]=-2;	
-	ADCState=ADC_SubmitQueue;
-	ADCTemp.avgbuf=0;
-	ADCTemp.Count=0;
-	ADCTemp.Ch=0;
-	ADCTemp.IsMissionProcessing=false;
+	//رADCж
+	ADC_DisableInt();
+	ADC_ClearIntFlag();
+	//λÿͨۼ
+	for(i=0;i<ADCChannelCount;i++)
+		{
+		ADCCh[i].AccBuf=0;
+		ADCCh[i].Count=0;
+		ADCCh[i].Seq=0;
+		ADCCh[i].SkipCnt=0;
+		ADCCh[i].DeferCnt=0;
+		ADCLastSeq[i]=0;
+		}
+	ADCChIdx=0;
+	ADCRRIdx=0;
+	ADCDiscardCnt=ADCRefSwitchDiscard; //һתǰ׼ոҪ
+	IsADCVOUTBoost=0;
+	//ͨҵVOUTͨλ
+	ADCVOUTChIdx=0;
+	while(ADCVOUTChIdx<ADCChannelCount&&ADCChCfg[ADCVOUTChIdx].Ch!=VOUTFBAIN)ADCVOUTChIdx++;
+	#ifdef EnableTaskProfiler
+	ADCConvCounter=0;
+	ADCDiscardCounter=0;
+	#endif
 	IsNotAllowAsync=1; //ʼʱֹ첽	
 	}
 
@@ -229,12 +295,12 @@ static void ResetADCAsyncEngine(void)
 void ADC_DeInit(void)
 	{
 	GPIOCfgDef ADCDeInitCfg;	
+	//նвλж(ͬʱرADCж)
+  ResetADCAsyncEngine();
 	//üĴرADC
 	ADCON1=0x00; //رADC
 	ADCLDO=0x00; //رƬڻ׼
 	
-	//նвλ첽
-  ResetADCAsyncEngine();
 	//ҪõADCGPIOΪͨGPIOģʽ
 	GPIO_SetMUXMode(VOUTFBIOG,VOUTFBIOx,GPIO_AF_GPIO);
 	GPIO_SetMUXMode(VBATInputIOG,VBATInputIOx,GPIO_AF_GPIO);
@@ -276,8 +342,14 @@ void ADC_Init(void)
 	ADCMPL=0xFF; //ADCȽĬֵΪ0x0FFF
   ADCLDO=0xA0; //ʹоƬADC׼2.0V
 	
-	//ʼ첽ADC
+	//ʼADCж
 	ResetADCAsyncEngine();
-	//ADCϣʹADCģ
+	//ѡͨͨеĵһͨ(ADC_SelectChannelֻжڵãֱӲĴ)
+	IsADCUsingVDDRef=ADCChCfg[0].IsUsingVDDRef?1:0;
+	ADC_SetVREFReg(IsADCUsingVDDRef);
+	ADC_SetChannelReg(ADCChCfg[0].Ch);
+	//ADCϣʹADCģжϲһת֮жԶתͨ
 	ADC_EnableCmd(); 
+	ADC_EnableInt();
+	ADC_StartConv();
 	}	
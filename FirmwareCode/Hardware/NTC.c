@@ -2,16 +2,19 @@
 /** \file NTC.c
 /** \Author [NTC resistor LUT generator BOT] @ redstoner_35
 /** \Project Xtern Ripper Laser Edition 
-/** \Description 这个文件负责实现根据NTC读回的阻值反向计算温度的功能（该文件由
-机器自动生成，未经允许不得随意修改！！）
+/** \Description 这个文件负责实现根据NTC分压的ADC转换结果反向计算温度的功能（该文件
+由机器自动生成，未经允许不得随意修改！！）
 
 /** \AdditionINFO  
 		This is an automatically generated file by NTC resistor LUT 
 		generator. DO NOT EDIT UNLESS YOU FULLY UNDERSTAND WHAT THIS
 		FILE ACTUALLY DOES!
 		NTC PARAMETER:100.00KΩ @ 25℃ B4250
-		Table temperature range:-19℃ to 90℃
-		Total ROM space for table:378 Bytes
+		Pull-up resistor:470.00KΩ
+		Table domain:12bit ADC code
+		Table temperature range:-19℃ to 75℃,1℃ step
+		Max lookup error:0.20℃
+		Total ROM space for table:190 Bytes
 		Target MCU Architecture:8051 Based MCU
 
 **	History: Initial Release
@@ -21,6 +24,7 @@
 /*	include files
 *****************************************************************************/
 #include <stdbool.h>
+#include "ADCCfg.h"
 
 /****************************************************************************/
 /*	Local pre-processor symbols/macros('#define')
@@ -28,79 +32,91 @@
 #define TemperatureReportOffset 0	//温度反馈的偏移值（如果你发现温度不准，可以在这里对温度监测系统进行TRIM）
 //#define NoTempReport  //禁止系统进行温度监视
 
+//查找表参数(由生成器自动计算)
+#define NTCTableSize 95 //查找表的项数
+#define NTCTableMinTemp -19 //查找表第一项对应的温度(℃)
+#define NTCTableMaxTemp 75 //查找表最后一项对应的温度(℃)
+#define NTCTableStep 1 //查找表相邻两项的温度间隔(℃)
+#define NTCTablePullUpK 470 //生成查找表时使用的上拉电阻阻值(KΩ)
+
+//查找表是按照指定的上拉电阻生成的，上拉电阻变更后必须重新生成
+#if (NTCTablePullUpK != NTCUpperResValueK)
+	#error "Error 003:NTC lookup table was generated for a different pull-up resistor,please regenerate it!"
+#endif
+
 /****************************************************************************/
 /*	Local constant definitions('static const')
 ****************************************************************************/
-static code unsigned long NTCTableTop[54]={
-1179691,1104854, 1035294,   			//-19 到 -17 摄氏度
-970604, 910411, 854373, 802176,   //-16 到 -13 摄氏度
-753532, 708176, 665863, 626371,   //-12 到 -9 摄氏度
-589493, 555039, 522834, 492718,   //-8 到 -5 摄氏度
-464541, 438167, 413468, 390328,   //-4 到 -1 摄氏度
-368638, 348299, 329218, 311309,   //0 到 3 摄氏度
-294493, 278697, 263852, 249895,   //4 到 7 摄氏度
-236769, 224417, 212791, 201842,   //8 到 11 摄氏度
-191528, 181807, 172643, 163999,   //12 到 15 摄氏度
-155843, 148145, 140876, 134011,   //16 到 19 摄氏度
-127523, 121390, 115591, 110105,   //20 到 23 摄氏度
-104914, 100000, 95346, 90938,   //24 到 27 摄氏度
-86762, 82802, 79048, 75487,   //28 到 31 摄氏度
-72108, 68901, 65857  };
-
-static code unsigned int NTCTableBottom[46]={
-62965, 60218, 57607, 55125,   //35 到 38 摄氏度
-52765, 50520, 48384, 46350,   //39 到 42 摄氏度
-44415, 42572, 40816, 39143,   //43 到 46 摄氏度
-37548, 36027, 34577, 33194,   //47 到 50 摄氏度
-31874, 30615, 29412, 28263,   //51 到 54 摄氏度
-27166, 26118, 25116, 24159,   //55 到 58 摄氏度
-23243, 22367, 21529, 20728,   //59 到 62 摄氏度
-19960, 19226, 18522, 17848,   //63 到 66 摄氏度
-17203, 16584, 15991, 15422,   //67 到 70 摄氏度
-14877, 14354, 13853, 13371,   //71 到 74 摄氏度
-12909                         //75摄氏度
+//NTC分压的ADC转换结果(AD=4096*Rt/(Rt+Rup))，随温度升高单调递减
+static code unsigned int NTCTable[NTCTableSize]={
+2929, 2874, 2817, 2760,       //-19 到 -16 摄氏度
+2701, 2642, 2583, 2523,       //-15 到 -12 摄氏度
+2462, 2401, 2340, 2279,       //-11 到 -8 摄氏度
+2218, 2157, 2096, 2036,       //-7 到 -4 摄氏度
+1976, 1917, 1858, 1800,       //-3 到 0 摄氏度
+1743, 1687, 1632, 1578,       //1 到 4 摄氏度
+1525, 1473, 1422, 1372,       //5 到 8 摄氏度
+1324, 1277, 1231, 1186,       //9 到 12 摄氏度
+1142, 1100, 1060, 1020,       //13 到 16 摄氏度
+982, 945, 909, 874,           //17 到 20 摄氏度
+841, 809, 777, 747,           //21 到 24 摄氏度
+719, 691, 664, 638,           //25 到 28 摄氏度
+614, 590, 567, 545,           //29 到 32 摄氏度
+524, 503, 484, 465,           //33 到 36 摄氏度
+447, 430, 413, 398,           //37 到 40 摄氏度
+382, 368, 354, 340,           //41 到 44 摄氏度
+327, 315, 303, 292,           //45 到 48 摄氏度
+281, 270, 260, 250,           //49 到 52 摄氏度
+241, 232, 224, 216,           //53 到 56 摄氏度
+208, 200, 193, 186,           //57 到 60 摄氏度
+179, 173, 167, 161,           //61 到 64 摄氏度
+155, 150, 145, 140,           //65 到 68 摄氏度
+135, 130, 126, 121,           //69 到 72 摄氏度
+117, 113, 109                 //73 到 75 摄氏度
 };
+
 /****************************************************************************/
 /*	Function implementation - global ('extern') and local('static')
 ****************************************************************************/
 #ifdef NoTempReport
 //特殊debug模式，mask掉温度控制使得系统永远不保护
-int CalcNTCTemp(bool *IsNTCOK,unsigned long NTCRes)
+int CalcNTCTemp(bool *IsNTCOK,unsigned int ADCCode)
 	{
 	*IsNTCOK=true;
-  return 25;	
+  return 250;	
 	}
 #else
 //NTC温度换算函数
-//传入参数：NTC阻值(Ω),温度是否有效的bool指针输出
-//返回参数：温度值(℃)
-int CalcNTCTemp(bool *IsNTCOK,unsigned long NTCRes){
-unsigned char i;
-volatile unsigned long NTCTableValue;
-//电阻值大于查找表阻值上限，温度异常
-if(NTCRes>(unsigned long)1179691)
+//传入参数：NTC分压的ADC转换结果(使用VDD作为基准),温度是否有效的bool指针输出
+//返回参数：温度值(1LSB=0.1℃)
+int CalcNTCTemp(bool *IsNTCOK,unsigned int ADCCode){
+unsigned char Low,High,Mid;
+unsigned int Span;
+//AD值大于查找表上限，NTC开路或温度过低，温度异常
+if(ADCCode>NTCTable[0])
   {
   *IsNTCOK=false;
-  return -19+TemperatureReportOffset;
+  return (NTCTableMinTemp+TemperatureReportOffset)*10;
   }
-//电阻值小于查找表阻值的阻值下限，温度异常
-if(NTCRes<(unsigned long)12909)
+//AD值小于查找表下限，NTC短路或温度过高，温度异常
+if(ADCCode<NTCTable[NTCTableSize-1])
   {
   *IsNTCOK=false;
-  return 75+TemperatureReportOffset;
+  return (NTCTableMaxTemp+TemperatureReportOffset)*10;
   }
-//温度正常，开始查表
+//温度正常，使用二分法查找AD值所在的区间，使NTCTable[Low]>=ADCCode>=NTCTable[High]
 *IsNTCOK=true;
-if(NTCRes>(unsigned long)62965)for(i=0;i<54;i++)if(NTCTableTop[i]<=NTCRes)return (-19+TemperatureReportOffset)+i;
-for(i=0;i<46;i++)
+Low=0;
+High=NTCTableSize-1;
+while((High-Low)>1)
   {
-  NTCTableValue=(unsigned long)NTCTableBottom[i];
-  NTCTableValue&=0xFFFF;
-  if(NTCTableValue<=NTCRes)return (TemperatureReportOffset+35)+i;
+  Mid=(Low+High)>>1;
+  if(NTCTable[Mid]>=ADCCode)Low=Mid;
+  else High=Mid;
   }
-//数值查找失败，返回错误值
-*IsNTCOK=false;
-return 0;
+//在区间内进行线性插值得到0.1℃分辨率的结果(四舍五入)
+Span=NTCTable[Low]-NTCTable[High];
+Span=(((NTCTable[Low]-ADCCode)*(10*NTCTableStep))+(Span>>1))/Span;
+return ((NTCTableMinTemp+TemperatureReportOffset+((int)Low*NTCTableStep))*10)+(int)Span;
 }
 #endif
-
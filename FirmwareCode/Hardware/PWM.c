@@ -18,23 +18,24 @@
 #include "GPIO.h"
 #include "PWMCfg.h"
 
-/****************************************************************************/
-/*	Local pre-processor symbols/macros for Parameter definition ('#define')
-****************************************************************************/ 
-#define PWMFreq 4000 //IDACPWMƵ(λHz)	
-
 /****************************************************************************/
 /*	Local pre-processor symbols/macros for Parameter Processing and Fast Op-
 /*  eration with Register Operation('#define')
 ****************************************************************************/ 
 #define iabsf(x) (x>0?x:-x) 												//ֵ
 
-#define PWMStepConstant ((SysFreq/PWMFreq)-1) 			//PWMԶ
 #define PWM_Enable() 	do{PWMCNTE=0x1D;}while(0) 		//PWMʹ
 
 #define IPWMDACMSB ((PWMStepConstant>>8)&0xFF)
 #define IPWMDACLSB (PWMStepConstant&0xFF)           //PWMDACLSBMSB
 
+#ifdef EnablePWMDACDither
+	#define PWMLoadMask 0x10 //ͨ0ռձжÿڶװأύʱֻͨ4
+#else
+	#define PWMLoadMask 0x11 //ύʱͬʱװͨ04
+#endif
+#define PWMDitherOne (1<<PWMDACDitherBits) //ۼ1PWM
+
 #if (PWMStepConstant > 0xFFFE | CVPWMDACFullScale > 0xFFFE)
   //ԶPWMֵǷϷ
 	#error "PWM Frequency is too low which causing PWM Counter to overflow!"
@@ -42,16 +43,32 @@
 /****************************************************************************/
 /*	Global variable definitions(declared in header file with 'extern')
 ****************************************************************************/
-xdata float PWMDuty;
+xdata unsigned int PWMDuty; //·׼PWMDAC(PWMֵ)
 xdata unsigned int PreChargeDACDuty; //ԤPWMDAC
 bit IsNeedToUploadPWM; //ǷҪPWM
+#ifdef EnablePWMDACDither
+xdata unsigned char PWMDutyFrac; //·׼PWMDACռձȵС
+#endif
 
 /****************************************************************************/
 /*	Local variable definitions('static')
 ****************************************************************************/
-static bit IsPWMLoading; //PWMڼ
-static bit IsNeedToEnableOutput; //ǷҪ
-static bit IsNeedToEnableMOS; //ǷҪʹMOS
+//ݴĴ(ѭд룬жύ)
+static xdata unsigned int StageDuty; //ͨ0ռձ
+static xdata unsigned int StagePreChargeDuty; //ͨ4ռձ
+static unsigned char StageMask; //Ҫεͨ(PWMMASKEbit 04)
+#ifdef EnablePWMDACDither
+static unsigned char StageFrac; //ͨ0ռձȵС
+#endif
+static volatile bit IsStagePending; //ݴĴδύֵ
+//װصֵ(жʹ)
+static unsigned char CommitMask; //ύװϺҪӦõ
+static volatile bit IsCommitLoading; //ύֵڵȴPWMڱ߽װ
+#ifdef EnablePWMDACDither
+static xdata unsigned int DitherBase; //жʹõռձ
+static unsigned char DitherFrac; //жʹõռձС
+static unsigned char DitherAcc; //һsigma-deltaƵۼ
+#endif
 
 /****************************************************************************/
 /*	Local Special Register definitions('sfr' and 'sbit')
@@ -60,15 +77,53 @@ sbit PWMDACPin=PWMDACIOP^PWMDACIOx;
 sbit PreChargeDACPin=PreChargeDACIOP^PreChargeDACIOx;
 
 /****************************************************************************/
-/*	Local Function implementation ('static')
-****************************************************************************/	
-
-//ϴPWMֵȴ
-static void UploadPWMValue(void)	
-	{
-	PWMLOADEN=0x11; //ͨ0PWMֵ
-	while(PWMLOADEN&0x11); //ȴؽ
-	}
+/*	Interrupt Handler functions(Process PWM Interrupts)
+****************************************************************************/
+void PWM_IRQHandler(void) interrupt EPWM_VECTOR  //ͨ0PWMжϴ(ύݴĴ)
+{
+	#ifdef EnablePWMDACDither
+	unsigned int Duty;
+	#endif
+	//ͨ0жϱ־
+	PWMPIF&=~0x01;
+	//ϴύֵڱ߽װϣʱٸΣ֤ͨʱռձѾµֵ
+	if(IsCommitLoading&&!(PWMLOADEN&PWMLoadMask))
+		{
+		PWMMASKE=(PWMMASKE&0xEE)|CommitMask;
+		IsCommitLoading=0;
+		}
+	//ݴĴֵһύɣдĴһڱ߽װ
+	if(IsStagePending&&!IsCommitLoading)
+		{
+		PWMD4H=(StagePreChargeDuty>>8)&0xFF;
+		PWMD4L=StagePreChargeDuty&0xFF;
+		#ifdef EnablePWMDACDither
+		DitherBase=StageDuty;
+		DitherFrac=StageFrac;
+		#else
+		PWMD0H=(StageDuty>>8)&0xFF;
+		PWMD0L=StageDuty&0xFF;
+		#endif
+		CommitMask=StageMask;
+		IsStagePending=0;
+		IsCommitLoading=1;
+		PWMLOADEN|=PWMLoadMask;
+		}
+	#ifdef EnablePWMDACDither
+	//һsigma-deltaƣСۼ+1ƽֵΪСռձ
+	Duty=DitherBase;
+	DitherAcc+=DitherFrac;
+	if(DitherAcc>=PWMDitherOne)
+		{
+		DitherAcc-=PWMDitherOne;
+		Duty++;
+		}
+	//װһڵռձ
+	PWMD0H=(Duty>>8)&0xFF;
+	PWMD0L=Duty&0xFF;
+	PWMLOADEN|=0x01;
+	#endif
+}
 
 /****************************************************************************/
 /*	Global Function implementation - Initialization and De-Initialization
@@ -80,6 +135,9 @@ void PWM_DeInit(void)
 	//ΪͨGPIO
 	GPIO_SetMUXMode(PWMDACIOG,PWMDACIOx,GPIO_AF_GPIO);
   GPIO_SetMUXMode(PreChargeDACIOG,PreChargeDACIOx,GPIO_AF_GPIO);
+	//رύݴĴʹõж
+	EIE2&=~IRQ_EIE2_PWMIE_Msk;
+	PWMPIE=0x00; 
 	//رPWMģ
 	PWMOE=0x00;
 	PWMCNTE=0x00;		//رPWM
@@ -126,11 +184,22 @@ void PWM_Init(void)
 	//ʼ
 	PWMDuty=0;
 	PreChargeDACDuty=0;
-	IsPWMLoading=0; 
 	IsNeedToUploadPWM=0;
-	//PWM
+	IsStagePending=0;
+	IsCommitLoading=0;
+	#ifdef EnablePWMDACDither
+	PWMDutyFrac=0;
+	DitherBase=0;
+	DitherFrac=0;
+	DitherAcc=0;
+	#endif
+	//PWMװسʼֵ(ʱԱΣҪȴװ)
 	PWM_Enable();
-	UploadPWMValue();	
+	PWMLOADEN=0x11;
+	//ͨ0жϣڱ߽ύݴĴ
+	PWMPIF=0x00;
+	PWMPIE=0x01;
+	EIE2|=IRQ_EIE2_PWMIE_Msk;
 	//PWMʼϣΪù
 	GPIO_SetMUXMode(PWMDACIOG,PWMDACIOx,GPIO_AF_PWMCH0);
   GPIO_SetMUXMode(PreChargeDACIOG,PreChargeDACIOx,GPIO_AF_PWMCH4);
@@ -139,47 +208,42 @@ void PWM_Init(void)
 /****************************************************************************/
 /*	Global Function implementation - Logic Handler
 ****************************************************************************/		
+
+//PWMֵǷѾЧ
+bit PWM_IsCommitDone(void)
+	{
+	if(IsNeedToUploadPWM||IsStagePending||IsCommitLoading)return 0;
+	return 1;
+	}
 	
-//PWMṹڵý
+//PWMֵдݴĴ飬жһPWMύݴĴ
+//ڻûύľֵᱻֱӸǣ߲ҪȴһεֵӦ
 void PWM_OutputCtrlHandler(void)	
 	{
-	int value;
-	float buf;
+	unsigned char Mask;
 	//ǰϵͳδ
 	if(!IsNeedToUploadPWM)return; //Ҫ
-	//μѿʼн
-	else if(IsPWMLoading) 
-		{
-	  if(PWMLOADEN&0x11)return;//ؼĴλΪ0ʾسɹ
-	  //ؽ
-		if(IsNeedToEnableMOS)PWMMASKE&=0xEF;
-		else PWMMASKE|=0x10;
-		if(IsNeedToEnableOutput)PWMMASKE&=0xFE;
-		else PWMMASKE|=0x01;   //PWMMASKEĴ״̬öӦͨ
-		IsNeedToUploadPWM=0;
-		IsPWMLoading=0;  //ڼ״̬Ϊ
-		}
-	//μѱʼмش
-	else
-		{
-		//PWMռձȲ
-		if(PWMDuty>100)PWMDuty=100;
-		if(PWMDuty<0)PWMDuty=0;
-		if(PreChargeDACDuty>CVPWMDACFullScale)PreChargeDACDuty=CVPWMDACFullScale;
-		//PWMֵѡMASKĴǷ
-		IsNeedToEnableOutput=PWMDuty>0?1:0; //ǷҪ
-		IsNeedToEnableMOS=PreChargeDACDuty?1:0;  //ǷҪʹFET
-		//üĴװPWMֵ
-		buf=PWMDuty*(float)PWMStepConstant;
-		buf/=(float)100;
-		value=(int)buf;
-		PWMD4H=(PreChargeDACDuty>>8)&0xFF;
-		PWMD4L=PreChargeDACDuty&0xFF;
-		PWMD0H=(value>>8)&0xFF;
-		PWMD0L=value&0xFF;			
-		//PWMĴֵװ룬Ӧֵ		
-		IsPWMLoading=1; //Ǽع̽
-		PWMLOADEN|=0x11; //ʼ
-		}
+	//PWMռձȲ
+	if(PWMDuty>PWMStepConstant)PWMDuty=PWMStepConstant;
+	if(PreChargeDACDuty>CVPWMDACFullScale)PreChargeDACDuty=CVPWMDACFullScale;
+	#ifdef EnablePWMDACDither
+	if(PWMDuty>=PWMStepConstant)PWMDutyFrac=0; //ռձʱ޷϶
+	#endif
+	//PWMֵѡMASKĴǷ
+	Mask=0;
+	if(!PWMDuty)Mask|=0x01; //ǷҪ
+	if(!PreChargeDACDuty)Mask|=0x10;  //ǷҪʹFET
+	//дݴĴ(дڼͣжϣύдһֵ)
+	EIE2&=~IRQ_EIE2_PWMIE_Msk;
+	StageDuty=PWMDuty;
+	StagePreChargeDuty=PreChargeDACDuty;
+	#ifdef EnablePWMDACDither
+	StageFrac=PWMDutyFrac&(PWMDitherOne-1);
+	#endif
+	StageMask=Mask;
+	IsStagePending=1;
+	EIE2|=IRQ_EIE2_PWMIE_Msk;
+	//ѾתݴĴ
+	IsNeedToUploadPWM=0;
 	}
 /*********************************  End Of File  ************************************/
@@ -0,0 +1,166 @@
+/****************************************************************************/
+/** \file SC8721.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļΪײӲļRAMάSC8721AüĴӰ
+дʱֻݷ仯ļĴ͵ϣͨI2Cжϴں̨ȡ
+״̬Ĵʹѯ߹һ߶ȡҲѭ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include "cms8s6990.h"
+#include "i2c.h"
+#include "delay.h"
+#include "SC8721.h"
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+#define SC8721ADDR 0x62   //SC8721оƬ7bitַ
+#define SC8721ShadowBase SC8721_REG_CSOSET  //ӰӼĴǵĵһĴַ
+#define SC8721ShadowDepth 8  //ӰӼĴǵļĴ(0x01-0x08)
+
+/****************************************************************************/
+/*	Local variable  definitions('static')
+****************************************************************************/
+static xdata char SC8721Shadow[SC8721ShadowDepth]; //üĴӰӸ
+static xdata char SC8721Status[2]; //STATUS1STATUS2Ļ
+static xdata char SC8721StatusBuf[2]; //̨ȡ״̬ĴĽջ
+static xdata I2CReqStrDef StatusReq; //̨ȡ״̬ĴĴ
+static unsigned int StatusStamp; //״̬ʱ(ȡôζȡύʱ)
+static unsigned int StatusPostStamp; //ڽеĺ̨ȡύʱ
+static bit IsShadowValid=0; //ӰӼĴǷоƬһ
+static bit IsStatusValid=0; //״̬ǷЧ
+
+/****************************************************************************/
+/*	Function implementation - local('static')
+****************************************************************************/
+
+//ĴΧǷλӰӼĴ֮
+static bit SC8721_IsRangeInvalid(char Reg,unsigned char Len)
+	{
+	if(!Len||Reg<SC8721ShadowBase)return 1;
+	if((Reg-SC8721ShadowBase+Len)>SC8721ShadowDepth)return 1;
+	return 0;
+	}
+
+//ں̨ύһSTATUS1STATUS2ȡ(˾´ύ)
+static void SC8721_PostStatusRead(void)
+	{
+	StatusReq.SlaveAddr=SC8721ADDR;
+	StatusReq.Reg=SC8721_REG_STATUS1;
+	StatusReq.Data=SC8721StatusBuf;
+	StatusReq.Len=2;
+	StatusReq.IsRead=1;
+	StatusPostStamp=GetSysTickMS();
+	I2C_PostRequest(&StatusReq);
+	}
+
+//оƬһȡȫüĴӰӸ
+static bit SC8721_LoadShadow(void)
+	{
+	if(IsShadowValid)return 0;
+	if(I2C_ReadByte(SC8721ADDR,SC8721Shadow,SC8721ShadowBase,SC8721ShadowDepth))return 1;
+	IsShadowValid=1;
+	return 0;
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+
+//ӰӼĴ״̬(DCDCϵ߶ϵоƬݻḴλҪ¶ȡ)
+void SC8721_InvalidateCache(void)
+	{
+	IsShadowValid=0;
+	IsStatusValid=0;
+	//Ѿĺ̨ȡ(I2CرʱδɵĶȡᱻʧ)
+	if(StatusReq.State==I2C_Req_Done||StatusReq.State==I2C_Req_Error)StatusReq.State=I2C_Req_Idle;
+	}
+
+//ӰӸȡָĴĵǰֵӰӸЧʱԶоƬȡһ
+bit SC8721_GetShadow(char Reg,char *Data,unsigned char Len)
+	{
+	unsigned char i;
+	if(SC8721_IsRangeInvalid(Reg,Len))return 1;
+	if(SC8721_LoadShadow())return 1;
+	//
+	Reg-=SC8721ShadowBase;
+	for(i=0;i<Len;i++)Data[i]=SC8721Shadow[Reg+i];
+	return 0;
+	}
+
+//дָļĴֻݷ仯ĲֲŻͨ߷
+bit SC8721_WriteReg(char Reg,char *Data,unsigned char Len)
+	{
+	unsigned char i,First,Last;
+	char Offset;
+	if(SC8721_IsRangeInvalid(Reg,Len))return 1;
+	if(SC8721_LoadShadow())return 1;
+	//ҳһһҪдļĴ
+	Offset=Reg-SC8721ShadowBase;
+	First=0xFF;
+	Last=0;
+	for(i=0;i<Len;i++)
+		{
+		//ûб仯ļĴҪд롣Load bitдᴥоƬãÿζд
+		if(Data[i]==SC8721Shadow[Offset+i]&&!((Reg+i)==SC8721_REG_GLOBALCTRL&&(Data[i]&SC8721_Cmd_ApplyDCDCSetting)))continue;
+		if(First==0xFF)First=i;
+		Last=i;
+		}
+	//ȫͬҪ
+	if(First==0xFF)return 0;
+	//д뷢仯ķΧдʧܺоƬδ֪ӰӸ
+	if(I2C_SendByte(SC8721ADDR,&Data[First],Reg+First,(Last-First)+1))
+		{
+		IsShadowValid=0;
+		return 1;
+		}
+	//дɹӰӸ
+	for(i=First;i<=Last;i++)SC8721Shadow[Offset+i]=Data[i];
+	return 0;
+	}
+
+//ȡSTATUS1STATUS2Ĵ泬ˢʱں̨ύһȡ
+//ȡ֮ĵȡأڼ䷵ػһεĽʱȡȡύʱ
+//ȡʱ䣬ѭȡصĽԵñʵʸ
+SC8721StatusResultDef SC8721_ReadStatus(char *Status)
+	{
+	unsigned int Age;
+	//ȡѾĺ̨ȡ
+	if(StatusReq.State==I2C_Req_Done)
+		{
+		SC8721Status[0]=SC8721StatusBuf[0];
+		SC8721Status[1]=SC8721StatusBuf[1];
+		StatusStamp=StatusPostStamp;
+		IsStatusValid=1;
+		StatusReq.State=I2C_Req_Idle;
+		}
+	else if(StatusReq.State==I2C_Req_Error)
+		{
+		IsStatusValid=0;
+		StatusReq.State=I2C_Req_Idle;
+		return SC8721_Status_CommErr;
+		}
+	//̫ɣΪûн
+	Age=GetSysTickMS()-StatusStamp;
+	if(Age>=SC8721StatusMaxAge)IsStatusValid=0;
+	//泬ˢʱûڽеĶȡύµĶȡ
+	if(StatusReq.State==I2C_Req_Idle&&(!IsStatusValid||Age>=SC8721StatusCacheTime))SC8721_PostStatusRead();
+	//ؽ
+	if(!IsStatusValid)return SC8721_Status_Pending;
+	Status[0]=SC8721Status[0];
+	Status[1]=SC8721Status[1];
+	return SC8721_Status_OK;
+	}
+
+//ֻں̨ύ״̬ȡȡؽ(ѽĶȡʹһSC8721_ReadStatus)
+//ڵƵļ֮ǰԤȶȡüʱõ״̬㹻
+void SC8721_PrefetchStatus(void)
+	{
+	if(StatusReq.State==I2C_Req_Idle)SC8721_PostStatusRead();
+	}
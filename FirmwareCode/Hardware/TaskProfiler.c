@@ -0,0 +1,141 @@
+/****************************************************************************/
+/** \file TaskProfiler.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļʵѭִʱͳƹܡʹ
+Timer1Ϊеʱ(Fsys/12=4MHz0.25uSֱ)ͨжչ32
+λ¼ÿ̡ƽִʱ䣬ڵеȽϲͬ
+̼ִʱ䡣
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include "cms8s6990.h"
+#include "TaskProfiler.h"
+
+#ifdef EnableTaskProfiler
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+#define ProfMeanWindowBit 7 //ƽֵͳƴ(2^7=128β)
+#define ProfMaxSampleTime 0xFFFF //βֵ(65.535mS)󱥺
+
+/****************************************************************************/
+/*	Global variable definitions(declared in header file with 'extern')
+****************************************************************************/
+xdata ProfTaskStrDef ProfTable[ProfTaskCount]; //ͳƽ
+
+/****************************************************************************/
+/*	Local variable  definitions('static')
+****************************************************************************/
+static xdata unsigned long ProfTaskStartTick; //ǰʱʱ(ͬһʱִֻһ)
+static xdata unsigned long ProfLoopStartTick; //ѭȦʼʱ
+static volatile unsigned int T1OVFCount; //Timer1(ʱ16λ)
+
+/****************************************************************************/
+/*	Interrupt Handler functions(Process Timer Interrupts)
+****************************************************************************/
+void Timer1_IRQHandler(void) interrupt TMR1_VECTOR  //ʱʱжϴ
+{
+	T1OVFCount++; //TF1ڽжʱӲԶ
+}
+
+/****************************************************************************/
+/*	Function implementation - local('static')
+****************************************************************************/
+
+//ȡ32λʱ
+static unsigned long TaskProfiler_GetTick(void)
+	{
+	unsigned char H,L;
+	unsigned int OVF;
+	ET1=0; //ȡڼͣжϣ16λڶȡб޸
+	do
+		{
+		H=TH1;
+		L=TL1;
+		}
+	while(H!=TH1); //ȡе8λλ¶ȡ
+	OVF=T1OVFCount;
+	if(TF1&&!(H&0x80))OVF++; //պ÷жϻû
+	ET1=1; //ж(ϵͳ˯лѺStartSystemTimeBaseḴλIE˳ָ)
+	//ϲõ
+	return ((unsigned long)OVF<<16)|((unsigned int)H<<8)|L;
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+
+//λͳƽ
+void TaskProfiler_Reset(void)
+	{
+	unsigned char i;
+	for(i=0;i<ProfTaskCount;i++)
+		{
+		ProfTable[i].Min=0xFFFF;
+		ProfTable[i].Max=0;
+		ProfTable[i].Mean=0;
+		ProfTable[i].Sum=0;
+		ProfTable[i].SampleCount=0;
+		}
+	ProfTaskStartTick=0;
+	ProfLoopStartTick=0;
+	}
+
+//ʼ
+void TaskProfiler_Init(void)
+	{
+	//Timer1
+	TR1=0;
+	TF1=0; //رնʱ
+	TMOD&=0x0F;
+	TMOD|=0x10; //T1Ϊ16bitʱģʽ
+	CKCON&=0xEF; //T1M=0T1ʱΪFsys/12=4MHz
+	TH1=0x00;
+	TL1=0x00;
+	T1OVFCount=0;
+	//λͳƽʱ
+	TaskProfiler_Reset();
+	ET1=1; //ж
+	TR1=1; //ʱʼʱ
+	}
+
+//ʼִ
+void TaskProfiler_Start(unsigned char Task)
+	{
+	if(Task==Prof_LoopPeriod)ProfLoopStartTick=TaskProfiler_GetTick();
+	else ProfTaskStartTick=TaskProfiler_GetTick();
+	}
+
+//ִϣͳƽرεִʱ(uS)
+unsigned int TaskProfiler_Stop(unsigned char Task)
+	{
+	unsigned long Time;
+	ProfTaskStrDef xdata *Prof;
+	//ִʱ䲢ΪuS(Timer1һΪ0.25uS)
+	Time=TaskProfiler_GetTick();
+	Time-=(Task==Prof_LoopPeriod)?ProfLoopStartTick:ProfTaskStartTick;
+	Time>>=2;
+	if(Time>ProfMaxSampleTime)Time=ProfMaxSampleTime;
+	//Сֵ
+	Prof=&ProfTable[Task];
+	if(Time<Prof->Min)Prof->Min=Time;
+	if(Time>Prof->Max)Prof->Max=Time;
+	//ۼƽֵ֮½
+	Prof->Sum+=Time;
+	Prof->SampleCount++;
+	if(Prof->SampleCount>=(1<<ProfMeanWindowBit))
+		{
+		Prof->Mean=(unsigned int)(Prof->Sum>>ProfMeanWindowBit);
+		Prof->Sum=0;
+		Prof->SampleCount=0;
+		}
+	return (unsigned int)Time;
+	}
+
+#endif
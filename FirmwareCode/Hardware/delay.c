@@ -2,8 +2,8 @@
 /** \file delay.c
 /** \Author redstoner_35
 /** \Project Xtern Ripper Laser Edition 
-/** \Description ļʵϵͳĵЧ8Hzʱ͸ִСʱĴ
-
+/** \Description ļʵϵͳ1mSϵͳġЧ8Hzʱ͸
+СʱĴ
 
 **	History: Initial Release
 **	
@@ -17,11 +17,13 @@
 /****************************************************************************/
 /*	Local pre-processor symbols/macros('#define')
 ****************************************************************************/
+#define HBTickHalfPeriod 62 //flagǰ(mS)
+#define HBTickPeriod 125 //flag(mS)λƽΪ62.5mS
 
 /****************************************************************************/
 /*	Global variable definitions(declared in header file with 'extern')
 ****************************************************************************/
-volatile bit SysHFBitFlag; //ƵFlag(65.5mS)
+volatile bit SysHFBitFlag; //ƵFlag(62.5mS)
 
 /****************************************************************************/
 /*	Local type definitions('typedef')
@@ -30,7 +32,8 @@ volatile bit SysHFBitFlag; //
 /****************************************************************************/
 /*	Local variable  definitions('static')
 ****************************************************************************/
-static bit IntDivFlag; //ڲƵflag
+static volatile unsigned int SysTickMS; //еϵͳļ(1LSB=1mS)
+static unsigned char HBDivCounter; //flagƵ
 static volatile bit IsT0OVF; //T0
 
 /****************************************************************************/
@@ -40,9 +43,16 @@ void Timer2_IRQHandler(void) interrupt TMR2_VECTOR	//ϵͳ
 { 
 	//T2ж
 	T2IF=0x00; 
-  //б2Ƶ
-  IntDivFlag=~IntDivFlag; //TStrobe=31.25*2=62.5mS
-	if(IntDivFlag)SysHFBitFlag=1;  //ÿ62.5mSflag1
+	//ϵͳۼ
+	SysTickMS++;
+  //Ƶ62-63mSλflagƽÿ62.5mSflag1
+	HBDivCounter++;
+	if(HBDivCounter==HBTickHalfPeriod)SysHFBitFlag=1;
+	else if(HBDivCounter>=HBTickPeriod)
+		{
+		HBDivCounter=0;
+		SysHFBitFlag=1;
+		}
 }		
 	
 void Timer0_IRQHandler(void) interrupt TMR0_VECTOR  //ʱʱжϴ
@@ -55,6 +65,17 @@ void Timer0_IRQHandler(void) interrupt TMR0_VECTOR  //
 /*	Function implementation - global ('extern') and local('static')
 ****************************************************************************/
 
+//ȡϵͳļ(1LSB=1mSԶƣȽʱҪʹòֵ)
+unsigned int GetSysTickMS(void)
+	{
+	unsigned int buf;
+	//16bit8λ治ԭӶȡȡֱνһ
+	do
+		buf=SysTickMS;
+	while(buf!=SysTickMS);
+	return buf;
+	}
+
 #ifndef UseUnifiedSystemTimeBase
 //ʱʼ
 void delay_init(void)
@@ -66,22 +87,22 @@ void delay_init(void)
 	TL0=0x00; //ʼֵ
 	IE=0x82; //ET0=1öʱж,EA=1ȫж
 	}
-//8Hzʱʼ
+//1mSϵͳĺ8Hzʱʼ
 void EnableSysHBTIM(void)
 	{
 	//öʱģʽ			
   CCEN=0x00; //رձȽϺͲ
-	RLDH=0x0B;
-	RLDL=0xDB; //װֵΪ31.25mSӳ(1/32)㹫ʽΪ65535-(48/24(0.5uS)=2000*31.25mS)=3035[0x0BDB]
-  TH2=0x5D;
-  TL2=0x66; //Ϊ31.25mSӳٵĳֵ
+	RLDH=0xF8;
+	RLDL=0x30; //װֵΪ1mSӳ٣㹫ʽΪ65536-(48/24(0.5uS)=2000*1mS)=63536[0xF830]
+  TH2=0xF8;
+  TL2=0x30; //Ϊ1mSӳٵĳֵ
 	//ж
   IE|=0x20;   //ET2=1T2ж
 	T2IF=0x00; //T2ж
 	T2IE=0x80; //T2OVIE=1T2 OVFж
 	//ʱ
 	SysHFBitFlag=0;
-	IntDivFlag=0;	 //λflag
+	HBDivCounter=0;	 //λflag(ϵͳļλ֤˯߻֮ʱ)
 	T2CON=0x91; //T2ʱԴΪfSys/24=1MHzʱ
 	}
 #else
@@ -97,10 +118,10 @@ void StartSystemTimeBase(void)
 	
 	//T2ʱģʽ			
   CCEN=0x00; //رձȽϺͲ
-	RLDH=0x0B;
-	RLDL=0xDB; //װֵΪ31.25mSӳ(1/32)㹫ʽΪ65535-(48/24(0.5uS)=2000*31.25mS)=3035[0x0BDB]
-  TH2=0x5D;
-  TL2=0x66; //Ϊ31.25mSӳٵĳֵ	
+	RLDH=0xF8;
+	RLDL=0x30; //װֵΪ1mSӳ٣㹫ʽΪ65536-(48/24(0.5uS)=2000*1mS)=63536[0xF830]
+  TH2=0xF8;
+  TL2=0x30; //Ϊ1mSӳٵĳֵ	
 	
 	//ж
 	T2IF=0x00; //T2ж
@@ -109,7 +130,7 @@ void StartSystemTimeBase(void)
 	
 	//λflagʱ
 	SysHFBitFlag=0;
-	IntDivFlag=0;	 //λflag
+	HBDivCounter=0;	 //λflag(ϵͳļλ֤˯߻֮ʱ)
 	T2CON=0x91; //T2ʱԴΪfSys/24=1MHzʱ
 	}
 #endif		
@@ -25,7 +25,7 @@
 /*	Local pre-processor symbols/macros('#define')
 ****************************************************************************/
 
-#define ActiveBeaconOFFVolt 2.90 //õЧڵصѹǷѹرԴҹضֵ(mV)
+#define ActiveBeaconOFFVolt 2900 //õЧڵصѹǷѹرԴҹضֵ(mV)
 
 /****************************************************************************/
 /*	Global variable definitions(declared in header file with 'extern')
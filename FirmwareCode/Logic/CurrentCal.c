@@ -0,0 +1,180 @@
+/****************************************************************************/
+/** \file CurrentCal.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļǶӦòļʵÿ̨У׼
+У׼õΪɸУ׼㣬ÿ洢һУ׼ϵʱ
+֮Բֵ衢PWMDAC˲ͷѹĸ졣У׼洢
+Flashڣҿڹͨఴϵֻ
+EnableFactoryCurrentCalĹ̼ڱ룬ֻ̼ȡӦУ׼
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include "ModeControl.h"
+#include "CurrentCal.h"
+#include "SysConfig.h"
+#include "SideKey.h"
+#include "LEDMgmt.h"
+#include "TempControl.h"
+#include "BattDisplay.h"
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+#define CalMinBattVolt 3350 //άУ׼Ҫ͵صѹ(mV)У׼Ҫ޵
+
+/****************************************************************************/
+/*	Global variable definitions(declared in header file with 'extern')
+****************************************************************************/
+xdata CurrentCalFSMDef CalFSMState=CurrentCal_InAct;
+
+/****************************************************************************/
+/*	Local constant definitions('static const')
+****************************************************************************/
+static code int CalSetPoint[CalPointCount]=CalSetPointList; //У׼õ
+
+/****************************************************************************/
+/*	Local variable  definitions('static')
+****************************************************************************/
+static xdata CalTableDef CalTable; //ǰʹõУ׼
+static xdata unsigned int CalGainQ12[CalPointCount]; //Q12ʽУ׼ϵ(4096=1.0)
+static xdata long CalSlope[CalPointCount-1]; //У׼֮У׼ϵб(Q12ϵÿmAٷŴ4096)
+static xdata unsigned char CalPointIdx; //ǰڵУ׼
+static bit IsCalTableUpdated; //У׼ѱ޸ģͨҪ¼ռձ
+
+/****************************************************************************/
+/*	Function implementation - local('static')
+****************************************************************************/
+
+//У׼ϵֵʹõĶ(Ԥбʣʱг)
+static void CurrentCal_CalcCoeff(void)
+	{
+	unsigned char i;
+	for(i=0;i<CalPointCount;i++)CalGainQ12[i]=(unsigned int)((((long)CalTable.Gain[i]<<12)+(CalGainUnity/2))/CalGainUnity);
+	for(i=0;i<(CalPointCount-1);i++)CalSlope[i]=(((long)CalGainQ12[i+1]-(long)CalGainQ12[i])<<12)/(long)(CalSetPoint[i+1]-CalSetPoint[i]);
+	IsCalTableUpdated=1;
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+
+//ȡУ׼У׼ڡ𻵻߳ΧʱʹòĬֵ
+void CurrentCal_Init(void)
+	{
+	unsigned char i;
+	bit IsTableOK;
+	IsTableOK=ReadCalTable(&CalTable)?0:1;
+	for(i=0;i<CalPointCount;i++)if(CalTable.Gain[i]<CalGainMin||CalTable.Gain[i]>CalGainMax)IsTableOK=0;
+	if(!IsTableOK)for(i=0;i<CalPointCount;i++)CalTable.Gain[i]=CalGainUnity;
+	//ֵ
+	CurrentCal_CalcCoeff();
+	CalFSMState=CurrentCal_InAct;
+	}
+
+//õӦУ׼͸PWMDACĵֵ
+int CurrentCal_Apply(int Current)
+	{
+	unsigned char i;
+	long Gain;
+	//ڵһ߸һУ׼ʱʹö˵У׼ϵ
+	if(Current<=CalSetPoint[0])Gain=CalGainQ12[0];
+	else if(Current>=CalSetPoint[CalPointCount-1])Gain=CalGainQ12[CalPointCount-1];
+	else
+		{
+		//ҵڵ䲢Բֵ
+		i=0;
+		while(Current>=CalSetPoint[i+1])i++;
+		Gain=CalGainQ12[i]+(((long)(Current-CalSetPoint[i])*CalSlope[i])>>12);
+		}
+	//ӦУ׼ϵ()У׼
+	Gain=(((long)Current*Gain)+2048)>>12;
+	if(Gain>CalCurrentCeiling)Gain=CalCurrentCeiling;
+	return (int)Gain;
+	}
+
+//У׼Ƿ޸ĹȡԶ
+bit CurrentCal_IsTableUpdated(void)
+	{
+	if(!IsCalTableUpdated)return 0;
+	IsCalTableUpdated=0;
+	return 1;
+	}
+
+#ifdef EnableFactoryCurrentCal
+//빤У׼
+void CurrentCal_Trigger(void)
+	{
+	if(CalFSMState!=CurrentCal_InAct)return;
+	//صѹ¶ȹߣ޷޵ܾ
+	if(CellVoltage<CalMinBattVolt||IsDisableTurbo)
+		{
+		LEDMode=LED_RedBlinkFifth;
+		return;
+		}
+	//ӵһУ׼㿪ʼеУ׼ϵϵ
+	CalPointIdx=0;
+	CalFSMState=CurrentCal_Trim;
+	MakeFastStrobe(LED_Amber);
+	}
+#endif
+
+/*******************************************************************************
+У׼̵İǰУ׼õԱյУ׼ϵ
+ֱõһ¡
+:+0.1% ˫:-0.1% :+1% Ļ:-1% :ǰָΪ
+:ȷϵǰУ׼㲢һ㣬һȷϺ󱣴У׼˳(̵)
+:У׼ָԭУ׼˳()
+*******************************************************************************/
+void CurrentCal_FSM(char ClickCount)
+	{
+	int *Gain;
+	if(CalFSMState==CurrentCal_InAct)return;
+	//ϵͳȻߵصѹ㣬У׼
+	if(IsForceLeaveTurbo||CellVoltage<CalMinBattVolt)ClickCount=5;
+	//ǰУ׼У׼ϵ
+	Gain=&CalTable.Gain[CalPointIdx];
+	switch(ClickCount)
+		{
+		case 1:*Gain+=CalFineStep;break;
+		case 2:*Gain-=CalFineStep;break;
+		case 3:*Gain+=CalCoarseStep;break;
+		case 4:*Gain-=CalCoarseStep;break;
+		case 5:
+			//¶ȡԭУ׼˳
+			CurrentCal_Init();
+			LEDMode=LED_RedBlinkThird;
+			return;
+		case 6:*Gain=CalGainUnity;break;
+		default:break;
+		}
+	if(ClickCount)
+		{
+		//У׼ϵ޷Ȼ¼ֵ
+		if(*Gain>CalGainMax)*Gain=CalGainMax;
+		if(*Gain<CalGainMin)*Gain=CalGainMin;
+		CurrentCal_CalcCoeff();
+		}
+	//ȷϵǰУ׼
+	if(!getSideKeyLongPressEvent())return;
+	CalPointIdx++;
+	if(CalPointIdx<CalPointCount)MakeFastStrobe(LED_Amber);
+	else
+		{
+		//еУ׼㶼ȷϣУ׼˳
+		SaveCalTable(&CalTable);
+		CalFSMState=CurrentCal_InAct;
+		LEDMode=LED_GreenBlinkThird;
+		}
+	}
+
+//ȡУ׼Ҫĵ
+int CurrentCal_QueryCurrent(void)
+	{
+	if(CalFSMState==CurrentCal_InAct)return -1;
+	return CalSetPoint[CalPointIdx];
+	}
@@ -23,6 +23,7 @@
 #include "SelfTest.h"
 #include "ModeControl.h"
 #include "VersionCheck.h"
+#include "CurrentCal.h"
 #include "SOS.h"
 #include "BreathMode.h"
 #include "Beacon.h"
@@ -41,7 +42,7 @@
 ****************************************************************************/
 
 //ȫֱ(λ)
-ModeStrDef *CurrentMode; //λṹָ
+ModeStrDef code *CurrentMode; //λṹָ
 xdata ModeIdxDef LastMode; //λ洢
 xdata ModeIdxDef LastModeBeforeTurbo; //һ뼫ĵλ
 xdata SysConfigDef SysCfg; //ϵͳ	
@@ -79,7 +80,9 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Disable,        //͵Ƶ
 		//λл
 		Mode_OFF,
-		Mode_OFF	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		Mode_OFF,	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		//
+		LDDefaultSlewRate     //ʱ(mA/S)Ĭϻӵ
 		}, 
 		//
 		{
@@ -96,13 +99,15 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Disable,        //͵Ƶ
 		//λл
 		Mode_OFF,
-		Mode_OFF	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		Mode_OFF,	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		//
+		LDDefaultSlewRate     //ʱ(mA/S)Ĭϻӵ
 		}, 	
 	  //޼		
 		{
 		Mode_Ramp,
-		2000,  // 2A
-		125,   //С 0.125A
+		LDRampCurrent,  //
+		LDRampMinCurrent,   //С
 		3200,  //3.2Vض
 		false, //ܴ  
 		true,
@@ -113,12 +118,14 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Disable,        //͵Ƶ
 		//λл
 		Mode_OFF,
-		Mode_OFF	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		Mode_OFF,	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		//
+		LDRampSlewRate     //ʱ(mA/S)޼ʹ2ٶ
 		},
 		//
 		{
 		Mode_ExtremeLow,
-		125,  //0.125A
+		LDExtremeLowCurrent,  //
 		0,   //Сûõ
 		2850,  //2.85Vض
 		true,
@@ -130,12 +137,14 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Enable_OFF,        //͵Ƶ
 		//λл
 		Mode_Low,
-		Mode_OFF		//ģʽλлã͵+лĿ굲λ(OFFʾл)
+		Mode_OFF,		//ģʽλлã͵+лĿ굲λ(OFFʾл)
+		//
+		LDDefaultSlewRate     //ʱ(mA/S)Ĭϻӵ
 		},
     //
 		{
 		Mode_Low,
-		250,  //0.25A
+		LDLowCurrent,  //
 		0,   //Сûõ
 		2900,  //2.90Vض
 		true,
@@ -147,12 +156,14 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Enable_Jump,        //͵Ƶ
 		//λл
 		Mode_Mid,
-		Mode_ExtremeLow		//ģʽλлã͵+лĿ굲λ(OFFʾл)
+		Mode_ExtremeLow,		//ģʽλлã͵+лĿ굲λ(OFFʾл)
+		//
+		LDDefaultSlewRate     //ʱ(mA/S)Ĭϻӵ
 		},
     //
 		{
 		Mode_Mid,
-		500,  //0.5A
+		LDMidCurrent,  //
 		0,   //Сûõ
 		3000,  //3Vض
 		true,
@@ -164,12 +175,14 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Enable_Jump,        //͵Ƶ
 		//λл
 		Mode_MHigh,
-		Mode_Low	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		Mode_Low,	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		//
+		LDDefaultSlewRate     //ʱ(mA/S)Ĭϻӵ
 		}, 	
     //и
 		{
 		Mode_MHigh,
-		1000,  //1A
+		LDMHighCurrent,  //и
 		0,   //Сûõ
 		3100,  //3.1Vض
 		true,
@@ -181,12 +194,14 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Enable_Jump,        //͵Ƶ
 		//λл
 		Mode_High,
-		Mode_Mid	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		Mode_Mid,	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		//
+		LDDefaultSlewRate     //ʱ(mA/S)Ĭϻӵ
 		}, 	
     //
 		{
 		Mode_High,
-		2000,  //2A
+		LDHighCurrent,  //
 		0,   //Сûõ
 		3200,  //3.2Vض
 		true,
@@ -198,7 +213,9 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Enable_Jump,        //͵Ƶ
 		//λл
 		Mode_ExtremeLow,
-		Mode_MHigh	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		Mode_MHigh,	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		//
+		LDDefaultSlewRate     //ʱ(mA/S)Ĭϻӵ
 		}, 	
     //
 		{
@@ -215,12 +232,14 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Disable,        //͵Ƶ
 		//λл
 		Mode_OFF,
-		Mode_High	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		Mode_High,	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		//
+		LDDefaultSlewRate     //ʱ(mA/S)Ĭϻӵ
 		},
 	  //SOSȵλ
 		{
 		Mode_SOS,
-		1400,  //1.4A	
+		LDSOSCurrent,  //SOS	
 		0,   //Сûõ
 		2850,  //2.85Vض
 		false, //⵲λܴ
@@ -232,12 +251,14 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Enable_OFF,        //͵Ƶ
 		//λл
 		Mode_Breath,
-		Mode_Beacon	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		Mode_Beacon,	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		//
+		LDSOSSlewRate     //ʱ(mA/S)SOSģʽ¿ӵβӰж
 		},
 		//ԹѧĶԽλ
 		{
 		Mode_Focus,
-		50,  //0.05A	
+		LDFocusCurrent,  //Խ	
 		0,   //Сûõ
 		2850,  //2.85Vض
 		false, //⵲λܴ
@@ -249,13 +270,15 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Enable_OFF,        //͵Ƶ
 		//λл
 		Mode_ExtremeLow,
-		Mode_OFF	 //ģʽλлã͵+лĿ굲λ(OFFʾл)		
+		Mode_OFF,	 //ģʽλлã͵+лĿ굲λ(OFFʾл)		
+		//
+		LDDefaultSlewRate     //ʱ(mA/S)Ĭϻӵ
 		},
 		//նĵ㶯ģʽ
 		{
 		Mode_Burn,
 		TurboLDICCMAX,  //ִм
-		150,   //ڰɿ״̬150mA
+		LDBurnIdleCurrent,   //ɿ״̬µĵ
 		3350,  //3.35Vض
 		false, //⵲λܴ
 		true,
@@ -266,13 +289,15 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Enable_OFF,        //͵Ƶ
 		//λл
 		Mode_OFF,
-		Mode_OFF	 //ģʽλлã͵+лĿ굲λ(OFFʾл)		
+		Mode_OFF,	 //ģʽλлã͵+лĿ굲λ(OFFʾл)		
+		//
+		LDDefaultSlewRate     //ʱ(mA/S)Ĭϻӵ
 		},
 	  //űλ
 		{
 		Mode_Breath,
-		2500,  //2.5A	
-		20,   //ģʽ20mA
+		LDBreathCurrent,  //ģʽߵ	
+		LDBreathMinCurrent,   //ģʽ͵
 		3000,  //3Vض
 		false, //⵲λܴ
 		true,
@@ -283,12 +308,14 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Enable_OFF,   //͵Ƶ
 		//λл
 		Mode_Beacon,
-		Mode_SOS	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		Mode_SOS,	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		//
+		LDDefaultSlewRate     //ʱ(mA/S)Ĭϻӵ
 		},
 		//ڿű
 		{
 		Mode_Beacon,
-		2500,  //2.5A	
+		LDBeaconCurrent,  //ű	
 		0,   	 //Сûõ
 		3000,  //3Vض
 		false, //⵲λܴ
@@ -300,12 +327,14 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Enable_OFF,   //͵Ƶ
 		//λл
 		Mode_SOS,
-		Mode_Breath	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		Mode_Breath,	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		//
+		LDBeaconSlewRate     //ʱ(mA/S)űģʽ
 		},
 		//޵ƵĽSOSģʽ
 		{
 		Mode_SOS_NoProt,
-		700,  //0.7A	
+		LDSOSNoProtCurrent,  //ޱSOS	
 		0,   //Сûõ
 		2850,  //2.85Vض
 		false, //⵲λܴ
@@ -317,7 +346,9 @@ code ModeStrDef ModeSettings[ModeTotalDepth]=
 		LVPROT_Disable,        //͵Ƶ
 		//λл
 		Mode_OFF,
-		Mode_OFF	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		Mode_OFF,	 //ģʽλлã͵+лĿ굲λ(OFFʾл)
+		//
+		LDSOSSlewRate     //ʱ(mA/S)SOSģʽ¿ӵβӰж
 		},		
 	};
 /****************************************************************************/
@@ -452,13 +483,21 @@ static void ProcessNClickAndHoldHandler(void)
 		    //洢֮ǰ
 		    Last2SModeState=IsEnable2SMode;
 				//ݵĽ
-		    if(Data.RawBattVolt>4.35)IsEnable2SMode=1; 	//ǰװĵ2ڣʼձֿ2Sģʽ
+		    if(Data.RawBattVolt>4350)IsEnable2SMode=1; 	//ǰװĵ2ڣʼձֿ2Sģʽ
 				else IsEnable2SMode=IsEnable2SMode?0:1; 		//ǰװĵ1ڣת״̬1S/2S֮л
 		    //ûиģб
 		    if(Last2SModeState==IsEnable2SMode)break;
 		    //÷仯ಿ˸ʾûǰĽò
 				TriggerCellCountChangeINFO();
 				SaveSysConfig(0);
+		    break;
+		#ifdef EnableFactoryCurrentCal
+		case 7:
+			  //ػ״̬7+빤У׼(Զָıģʽ²룬ֻй̼)
+			  if(CurrentMode->ModeIdx!=Mode_OFF||IsSystemEnteredAutoLocked)break;
+				CurrentCal_Trigger();
+		    break;
+		#endif
 		
 		//ʲô
 		default:break;			
@@ -547,7 +586,7 @@ static void ModeSwitchFSMTableDriver(char ClickCount)
 ****************************************************************************/
 
 //ָIndexindexҵĿģʽṹ岢ָ
-ModeStrDef *FindTargetMode(ModeIdxDef Mode,bool *IsResultOK)
+ModeStrDef code *FindTargetMode(ModeIdxDef Mode,bool *IsResultOK)
 	{
 	unsigned char i;
 	*IsResultOK=false;
@@ -571,6 +610,7 @@ void ModeFSMInit(void)
 	//ʼ޼
 	SysCfg.RampLimitReachDisplayTIM=0;
   ReadSysConfig(); //EEPROMڶȡ޼
+	CurrentCal_Init(); //EEPROMڶȡУ׼
 	
 	CurrentMode=FindTargetMode(Mode_Ramp,&Result);//λýṹѰ޼ĵλȡ
 	if(Result)
@@ -616,7 +656,7 @@ void ModeFSMTIMHandler(void)
 void SwitchToGear(ModeIdxDef TargetMode)
 	{
 	bool IsLastModeNeedStepDown,Result;
-	ModeStrDef *ModeBuf;
+	ModeStrDef code *ModeBuf;
 	//ǰλѾĿִֵ
 	if(TargetMode==CurrentMode->ModeIdx)return;
 	//¼ǰĽ	
@@ -689,7 +729,8 @@ void ModeSwitchFSM(void)
 		
 	//FSM߼		
   ModeBeforeFSMSwitch=CurrentMode->ModeIdx;		 //½֮ǰĵλ
-	if(VChkFSMState==VersionCheck_InAct)switch(ModeBeforeFSMSwitch)	
+	if(CalFSMState!=CurrentCal_InAct)CurrentCal_FSM(ClickCount); //У׼УУ׼̴
+	else if(VChkFSMState==VersionCheck_InAct)switch(ModeBeforeFSMSwitch)	
 		{
 		//ػ״̬
 		case Mode_OFF:		  
@@ -851,7 +892,7 @@ void ModeSwitchFSM(void)
 		}
 		
 	//FSMеı
-	if(ModeBeforeFSMSwitch==CurrentMode->ModeIdx&&VChkFSMState==VersionCheck_InAct)
+	if(ModeBeforeFSMSwitch==CurrentMode->ModeIdx&&VChkFSMState==VersionCheck_InAct&&CalFSMState==CurrentCal_InAct)
 		{
 		//״̬FSMвߵǰڰ汾״ִ̬б
 		ModeSwitchFSMTableDriver(ClickCount); 
@@ -863,6 +904,7 @@ void ModeSwitchFSM(void)
   //Ӧ
 	if(DisplayLockedTIM||(LockINDTimer&&IsDisplayLocked))Current=250; //û˳(״̬µ+)230mAݵʾһ
 	else if(VChkFSMState!=VersionCheck_InAct)Current=VersionCheckFSM()?300:-1; //汾ʾʼ
+	else if(CalFSMState!=CurrentCal_InAct)Current=CurrentCal_QueryCurrent(); //У׼̣ǰУ׼ĵ
 	else if(LowPowerStrobe())Current=30; //ѹʱ˸ʾ
 	else switch(CurrentMode->ModeIdx)
 		{
@@ -130,11 +130,18 @@ void DisplayErrorIDHandler(void)
 void MCUVDDFaultDetect(void)
 	{
 	//صѹLDO VdroopMCUVDDǷѹ
-	if(Data.RawBattVolt>3.2&&Data.MCUVDD<2.9)ReportError(Fault_MCUVDD_Error); 
+	if(Data.RawBattVolt>3200&&Data.MCUVDD<2900)ReportError(Fault_MCUVDD_Error); 
 	//MCUVDDߣ
-	if(Data.MCUVDD>3.1)ReportError(Fault_MCUVDD_Error); 
+	if(Data.MCUVDD>3100)ReportError(Fault_MCUVDD_Error); 
 	}
 	
+//ϼǰǰ1mSں̨ύDCDC״̬ȡʹùϼʱȡ״̬
+//SC8721StatusMaxAgeÿζΪڵõPending(ֻύȡأͨŴɼ⴦)
+void OutputFaultPrefetch(void)
+	{
+	if(GetIfOutputEnabled()&&ShortBlankTIM>=FaultBlankingInterval)OutputChannel_PrefetchDCDCState();
+	}
+
 //ϼ
 void OutputFaultDetect(void)
 	{
@@ -147,7 +154,7 @@ void OutputFaultDetect(void)
 		buf=ShortDetectTIM&0x1F; //ȡʱֵ					
 		//ѹԼMCUѹ
 		MCUVDDFaultDetect();
-		if(Data.BatteryVoltage>4.35)ReportError(Fault_InputOVP);	
+		if(Data.BatteryVoltage>4350)ReportError(Fault_InputOVP);	
 		//DCDC״̬м
 		else switch(OutputChannel_GetDCDCState())
 			{
@@ -156,9 +163,11 @@ void OutputFaultDetect(void)
 			case DCDC_OutputShort:  
 				//·ԼƬں
 				buf=ErrTIMCounter(buf,4); 					 //ʱۼ
-				if(Data.OutputVoltage>1.0)OErrID=3;
+				if(Data.OutputVoltage>1000)OErrID=3;
 				else OErrID=0;                       //1V򱨸Ƿط򱨸LD
 			  break;
+			//DCDC״̬ں̨ȡֲм
+			case DCDC_StatuPending:return;
 			//DCDC״̬δ֪,ͨ쳣
 			case DCDC_StatuUnknown:   
 			  buf=ErrTIMCounter(buf,1); //ʱۼ
@@ -167,7 +176,7 @@ void OutputFaultDetect(void)
 			//DCDC״ִ̬п·
 			case DCDC_Normal:
 				//ѹλ
-				if(Data.OutputVoltage<5.9)buf=0;
+				if(Data.OutputVoltage<5900)buf=0;
 				//ѹ쳣ʱۼȻ󴥷
 				else buf=ErrTIMCounter(buf,2); 
 				OErrID=1; //ID=1
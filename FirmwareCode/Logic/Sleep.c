@@ -29,6 +29,7 @@ CPU
 #include "SysConfig.h"
 #include "LEDMgmt.h"
 #include "VersionCheck.h"
+#include "CurrentCal.h"
 #include "ActiveBeacon.h"
 
 /****************************************************************************/
@@ -54,14 +55,18 @@ CPU
 	#error "Auto Lock TimeOut should be any number larger than zero!"
 
 #elif (AutoLockTimeOut > 0)
-  //ϷԶʱܿ
+  //ϷԶʱܿ(#messageKeilרеָ)
+	#ifdef __C51__
 	#message "Auto Lock Function of this firmware is enabled."
+	#endif
 	
 #else
   //Զʱر
+	#ifdef __C51__
 	#message "Auto Lock Function of this firmware is disabled.To enable this function"
 	#message "you need to define the time of auto lock by add a <AutoLockTimeOut>=[time(Sec)]"
 	#message "define in project global definition screen on Complier preference menu."
+	#endif
 	#warning "Auto lock function set to disabled state will causing major security issues,USE AS YOUR OWN RISK!!!"
 #endif
 
@@ -118,6 +123,8 @@ static char QueryIsSystemNotAllowToSleep(void)
 	{
 	//ϵͳʾصѹͰ汾ţ˯
 	if(VshowFSMState!=BattVdis_Waiting||VChkFSMState!=VersionCheck_InAct)return 1;
+	//ϵͳڽеУ׼
+	if(CalFSMState!=CurrentCal_InAct)return 1;
 	//ϵͳ
 	if(Current>0||IsLargerThanOneU8(CurrentMode->ModeIdx))return 1;
 	//˯
@@ -135,8 +142,8 @@ void LoadSleepTimer(void)
   #if (AutoLockTimeOut > 0)
 	AutoLockTimer=(unsigned char)AutoLockCNTValue;
 	#endif
-	//˯ʱ
-	if(CurrentMode->ModeIdx==Mode_Fault)SleepTimer=480; //ϱģʽϵͳ˯ʱΪ480S
+	//˯ʱ(ఴʼʱλ״̬ûгʼCurrentModeΪָ)
+	if(CurrentMode!=0&&CurrentMode->ModeIdx==Mode_Fault)SleepTimer=480; //ϱģʽϵͳ˯ʱΪ480S
 	else SleepTimer=8*SleepTimeOut; 		
 	}
 
@@ -181,7 +188,7 @@ void SleepMgmt(void)
 				//ఴļⶨʱ(ʹ62.5mSʱ,ͨ2Ƶ)
 				if(!SysHFBitFlag)continue; 
 				SysHFBitFlag=0;
-				sleepsel=~sleepsel;
+				sleepsel=!sleepsel;
 				if(sleepsel)SideKey_TIM_Callback();
 				}
 			while(!IsKeyEventOccurred()); //ȴ		
@@ -208,7 +215,7 @@ void SleepMgmt(void)
 				while(LEDMode==LED_RedBlinkThird)if(SysHFBitFlag)
 					{
 					//κɫ
-					sleepsel=~sleepsel;
+					sleepsel=!sleepsel;
 					if(sleepsel)LEDControlHandler();	
 					SysHFBitFlag=0;
 					}	
@@ -32,18 +32,51 @@
 #define SlowStepDownTime 60 //ʹûжʱۼӵʱִһε(λ)
 #define IntegralCurrentTrimValue 2500 //ĵ޵ֵ(mA)
 #define IntegralFactor 12 //ϵ(ÿλ=1/8룬Խʱ䳣Խߣ6=ÿӽ40mAĵ)
-#define MinumumILED 390 //ϵͳܴﵽ͵(mA)
+#define MinumumILED LDMinumumILED //ϵͳܴﵽ͵(mA)
 
 //
-#define ILEDConstant 750 //ϵͳ¿صĳ(mA)
-#define ILEDConstantFoldback 500 //ڽӽ¶ȼʱĽϵͳڵĳ(mA)
+#define ILEDConstant LDILEDConstant //ϵͳ¿صĳ(mA)
+#define ILEDConstantFoldback LDILEDConstantFoldback //ڽӽ¶ȼʱĽϵͳڵĳ(mA)
 
 //¶
-#define ForceOffTemp 65 //ȹػ¶
-#define ForceDisableTurboTemp 50 //¶޷뼫
-#define ConstantTemperature 45 //Ǽλ¿άֵ¶
-#define ReleaseTemperature 40 //¿ͷŵ¶
-#define LeaveTurboTemperature ForceOffTemp-10   //˳¶Ϊػ¶-10
+#define ForceOffTemp LDForceOffTemp //ȹػ¶
+#define ForceDisableTurboTemp LDForceDisableTurboTemp //¶޷뼫
+#define ConstantTemperature LDConstantTemperature //Ǽλ¿άֵ¶
+#define ReleaseTemperature LDReleaseTemperature //¿ͷŵ¶
+#define LeaveTurboTemperature (ForceOffTemp-10)   //˳¶Ϊػ¶-10
+
+//ǰ
+#define TempSlopeWindow 8 //ʵĲִ(ÿλ=1/8룬8=1)
+#define TempSlopeFilterShift 2 //ʵĵͨ˲ϵ(1/4)
+#define TempSlopeDeadband 1 //ʵڴֵ(0.1/)ʱǰNTC󽵵
+#define TempSlopeFFDiv 100 //ǰϵÿ1/8ύĵۼֵ=(-)*/ֵ(mA)
+#define TempSlopeLookAhead 10 //յǰԤ֮¶ȣԤֵ¶ʱǰ¿()
+
+//Ԥ
+#define TurboHostCapacity 40 //ǵ(J/K)ģ¿ģͿʱʹñʶĽ
+#define TurboSustainPower (((long)ILEDConstant*LDConstantVolt)/1000) //ǿԳɢĹ(mW)ճLDĵ繦ʹ
+#define TurboBurstOverTemp 3 //ڼǳ¶ȵķ()Ԥ꽻PI䵽¶
+#define TurboRampTemp 1 //ʣԤ㲻¸ֵ()ʱʼԽ͵
+#define TurboHandOverDiv 16 //ʣԤ㽵Խ1/ֵʱPI
+#define TurboNTCLagTime 8 //NTCͺǵʱ()Ԥ޿۳յǰʱڻ¶
+#define TurboHandOverLockTime 240 //PIʱ¶ʱ(ÿλ=1/8룬240=30)
+#define TurboBudgetBlendShift 4 //ԤNTC¶ȶӦϵ(1/16Լ2)ɢȹʹ
+
+//ģ¿ز
+#define ModelSamplePeriod 32 //ģͱʶĲ(ÿλ=1/8룬32=4)
+#define ModelForgetShift 6 //ʶϵ(1/64Լʹ256)
+#define ModelMinSamples 16 //ģɶٴЧӹ¿
+#define ModelMaxDeltaT 50 //¶ȱ仯(0.1)ΪЧ(մ˯߻)
+#define ModelMinPowerVar 6400 //ʶСʷ(Q8Լ0.5WĲ)ڴֵ˵
+#define ModelExciteShift 3 //ʺ¶ȵس̶ȳ(1-1/8)ʱ޷ݺ裬ģ
+#define ModelInvGainMin 320
+#define ModelInvGainMax 32000 //ģͲĺΧ(5-500J/K)
+#define ModelConductMin 5
+#define ModelConductMax 512 //ģͲĺΧ(ȵ0.02-2W/K)
+#define ModelCtrlPeriod 8 //ģ¿صļ(ÿλ=1/8)
+#define ModelHorizon 8 //¶ڶٸ(8=32)
+#define ModelRecoverRate 100 //ģ¿ÿֵ(mA)
+#define ModelMinVout 1000 //ѹڴֵ(mV)ʱ޷м
 
 /*   Զ壬޸ģ    */
 #define IntegrateFullScale IntegralCurrentTrimValue*IntegralFactor
@@ -57,6 +90,16 @@
 	//ĻΪ0ֵ
 	#error "Error 002:Invalid Integral Configuration,Trim Value or time-factor must not be zero or less than zero!"
 #endif
+
+#if defined(EnableTurboEnergyBudget)&&(LDConstantVolt <= LDThresholdVolt)
+	//µĹѹܵLDֵѹ
+	#error "Error 003:LDConstantVolt of the selected LD profile must be higher than LDThresholdVolt!"
+#endif
+
+#if defined(EnableTurboEnergyBudget)&&((ConstantTemperature+TurboBurstOverTemp) >= ForceDisableTurboTemp)
+	//¶ޱڽֹ뼫¶ȣ򱬷ǰͻᴥ¶ȱ
+	#error "Error 004:Turbo burst temperature must be lower than ForceDisableTurboTemp!"
+#endif
 /****************************************************************************/
 /*	Global variable definitions(declared in header file with 'extern')
 ****************************************************************************/
@@ -64,6 +107,13 @@
 bit IsPauseStepDownCalc; //Ƿͣ¿صļ̣bit=1ǿƸλ¿ϵͳǻͣ㣩
 bit IsDisableTurbo;  //ֹٶȽ뵽
 bit IsForceLeaveTurbo; //Ƿǿ뿪
+xdata unsigned char ThermalILIMSeq; //¿ֵı仯
+#ifdef EnableModelThermalCtrl
+xdata ThermalModelStrDef ThermalModel; //߱ʶģ
+#endif
+#ifdef EnableTurboEnergyBudget
+xdata long TurboBudget; //ʣԤ(mJ)
+#endif
 
 /****************************************************************************/
 /*	Local type definitions('typedef')
@@ -76,6 +126,16 @@ bit IsForceLeaveTurbo; //
 static xdata int TempIntegral;
 static xdata int TempProtBuf;
 static xdata unsigned char StepUpLockTIM; //ʱ
+static xdata int ThermalILIMResult; //¿ֵ(mA)
+static xdata int ThermalILIMCurrent; //㻺ֵʱʹõĵλ(mA)
+static xdata int TempSlopeBuf[TempSlopeWindow]; //õ¶ʷ(0.1)
+static xdata int TempSlope; //˲֮(Q40.1/)
+static xdata unsigned char TempSlopeIdx; //¶ʷдλ
+static bit IsTempSlopeReady; //¶ʷǷѾ
+#ifdef EnableTurboEnergyBudget
+static bit IsTurboBudgetInit; //ԤǷѾʼ
+static bit IsTurboBurstDone; //μԤѾ꣬PI
+#endif
 
 //ڲ״̬λ
 static bit IsNearThermalFoldBack; //λǷӽ˳¶
@@ -83,6 +143,37 @@ static bit IsThermalStepDown; //
 static bit IsTempLIMActive;  //¿ǷѾ
 static bit IsSystemShutDown; //Ƿ񴥷¿ǿƹػ
 
+#ifdef EnableModelThermalCtrl
+//ģͱʶ(ʺ¶ȾΪQ8ʽĻƽЭΪPP,PT,TT,PY,TY)
+static xdata long ModelMeanP,ModelMeanT,ModelMeanDT;
+static xdata long ModelCov[5];
+static xdata long ModelPowerAcc; //ڵĹۼ(mW)
+static xdata int ModelLastTemp; //һβ¶(0.1)
+static xdata unsigned char ModelSampleTIM,ModelCtrlTIM; //ʱ
+static bit IsModelPrimed; //ǷѾõһβ
+static bit IsModelCtrlActive; //ǰǷģͽ¿
+
+//¿ͷΪ0һҪ(ģ¿ûлΪ0)
+#define IsThermalLoopReleased() (!TempProtBuf&&(IsModelCtrlActive||IsNegative16(TempIntegral)))
+#else
+#define IsThermalLoopReleased() (!TempProtBuf&&IsNegative16(TempIntegral))
+#endif
+
+#ifdef EnableTurboEnergyBudget
+//ģʽ
+#define IsTurboMode() (CurrentMode->ModeIdx==Mode_Turbo||CurrentMode->ModeIdx==Mode_Burn)
+//ģʽԤ֮ǰԤʹPI
+#define IsTurboGoverned() (IsTurboMode()&&!IsTurboBurstDone)
+//TempX10(0.1)(mJ)
+#define TurboTempToEnergy(Cap,TempX10) ((long)(Cap)*(TempX10)*100)
+#else
+//ԤرգչΪ
+#define TurboBudgetUpdate()
+#endif
+
+//¶ȿԤ¶ȼֵ
+#define IsThermalRisingFast() (TempSlope>(TempSlopeDeadband<<4)&&(Data.SystempX10+((TempSlope*TempSlopeLookAhead)>>4))>(ConstantTemperature*10))
+
 /****************************************************************************/
 /*	Function implementation - local('static')
 ****************************************************************************/
@@ -115,6 +206,124 @@ static void ThermalIntegralCommitToProtHandler(void)
 	TempIntegral=0;						
 	}
 
+//ʹ0.1ֱʵ¶ȼ˲֮
+static void ThermalSlopeCalc(void)
+	{
+	int Diff;
+	//NTCʱλ¶ʷ
+	if(!Data.IsNTCOK)
+		{
+		IsTempSlopeReady=0;
+		TempSlopeIdx=0;
+		TempSlope=0;
+		return;
+		}
+	//¶ʷ֮󣬼㵱ǰ¶Ⱥһ֮ǰ¶Ȳ(0.1/)һ׵ͨ˲
+	if(IsTempSlopeReady)
+		{
+		Diff=Data.SystempX10-TempSlopeBuf[TempSlopeIdx];
+		TempSlope+=((Diff<<4)-TempSlope)>>TempSlopeFilterShift;
+		}
+	//¶ʷ
+	TempSlopeBuf[TempSlopeIdx]=Data.SystempX10;
+	if(++TempSlopeIdx>=TempSlopeWindow)
+		{
+		TempSlopeIdx=0;
+		IsTempSlopeReady=1;
+		}
+	}
+
+//ǰ¶ȿʱֱύۼֵصȴ¶
+static void ThermalSlopeFeedForward(void)
+	{
+	int Slope;
+	//㳬(Q4)
+	Slope=TempSlope-(TempSlopeDeadband<<4);
+	if(Slope<=0)return;
+	//ʺ͵ǰύۼֵԽĵλԽ
+	TempProtBuf+=(int)(((long)Slope*CurrentBuf)/(TempSlopeFFDiv<<4))+1;
+	if(TempProtBuf>(Current-MinumumILED))TempProtBuf=(Current-MinumumILED);
+	StepUpLockTIM=24; //¶ڿֹͣ3
+	}
+
+#ifdef EnableTurboEnergyBudget
+//ȡǵ(J/K)
+static int TurboGetHostCapacity(void)
+	{
+	#ifdef EnableModelThermalCtrl
+	if(ThermalModel.IsValid)return (int)((ThermalModel.InvGain*(ModelSamplePeriod/8))>>8); //ʹģͱʶĽ
+	#endif
+	return TurboHostCapacity;
+	}
+
+//ʣԤ㼫ֵԤ㲻ʱԽ͵
+static int TurboBudgetILIMCalc(void)
+	{
+	long Reserve;
+	if(Current<=ILEDConstant)return Current;
+	Reserve=TurboTempToEnergy(TurboGetHostCapacity(),TurboRampTemp*10);
+	if(TurboBudget>=Reserve)return Current;
+	return ILEDConstant+(int)(((long)(Current-ILEDConstant)*TurboBudget)/Reserve);
+	}
+//עǵǵɢ¼Ԥ(ÿ1/8)
+static void TurboBudgetUpdate(void)
+	{
+	long Power,Limit;
+	int Headroom,Cap;
+	//NTCϣ޷ʣԤ
+	if(!Data.IsNTCOK)
+		{
+		TurboBudget=0;
+		return;
+		}
+	//ɢȲԤ㣬LDĵ繦Ԥ
+	Power=TurboSustainPower;
+	if(GetIfOutputEnabled())Power-=((long)Data.OutputVoltage*(long)CurrentBuf)/1000;
+	TurboBudget+=Power>>3;
+	/**************************************************************
+	Ǵӵǰ¶¶ȼTurboBurstOverTempɵ
+	ԤޡPIں¶ȸſʼNTCͺ
+	ͻᳬȣⲿȷԤ꽻
+	PIʱǸպõﱬޣ䵽¶ȡNTCĶͺ
+	ǣѾ۵ûдNTCյǰʺ
+	NTCͺʱп۳ֵĽǰӳⲿ
+	ɢȹֻǹֵԤͬʱڼ
+	ɢõϻָԤ㡣
+	**************************************************************/
+	Cap=TurboGetHostCapacity();
+	Headroom=((ConstantTemperature+TurboBurstOverTemp)*10)-Data.SystempX10;
+	if(TempSlope>0)Headroom-=(TempSlope*TurboNTCLagTime)>>4;
+	if(IsNegative16(Headroom))Headroom=0;
+	Limit=TurboTempToEnergy(Cap,Headroom);
+	if(!IsTurboBudgetInit)TurboBudget=Limit; //ϵʱֱʹ
+	else TurboBudget+=(Limit-TurboBudget)>>TurboBudgetBlendShift;
+	if(TurboBudget>Limit)TurboBudget=Limit;
+	if(TurboBudget<0)TurboBudget=0;
+	IsTurboBudgetInit=1;
+	//뿪ģʽ´νʱ¿ʼ
+	if(!IsTurboMode())IsTurboBurstDone=0;
+	/**************************************************************
+	αԤѾ꣬յǰĵPI¡ɢ
+	ϵͣڽڣ¶ͣں¶֮²Ԥ
+	Ҳ٣ʱͬPIʱڻûNTC
+	¶ʱPIں¶֮°ѵȥ
+	ɳ
+	**************************************************************/
+	else if(!IsTurboBurstDone&&(TurboBudget<(TurboTempToEnergy(Cap,TurboRampTemp*10)/TurboHandOverDiv)||
+		(TurboBudget<TurboTempToEnergy(Cap,TurboRampTemp*10)&&TempSlope<=0&&
+		Data.SystempX10>=((ConstantTemperature+TurboBurstOverTemp-TurboRampTemp)*10))))
+		{
+		TempProtBuf=Current-TurboBudgetILIMCalc();
+		if(IsNegative16(TempProtBuf))TempProtBuf=0;
+		TempIntegral=0;
+		IsTempLIMActive=1;
+		IsTurboBurstDone=1;
+		if(TempSlope>0)StepUpLockTIM=TurboHandOverLockTime;
+		}
+	}
+
+#endif
+
 //¶ʹܿƵʩش
 static bit TempSchmittTrigger(bit ValueIN,char HighThreshold,char LowThreshold)	
 	{
@@ -124,6 +333,209 @@ static bit TempSchmittTrigger(bit ValueIN,char HighThreshold,char LowThreshold)
 	return ValueIN;
 	}
 
+#ifdef EnableModelThermalCtrl
+//Num/DenQ(Frac)ʽӹʱͬʱСӷĸ
+static long ThermalFixDiv(long Num,long Den,unsigned char Frac)
+	{
+	while(Num>=(1L<<(30-Frac))||Num<=-(1L<<(30-Frac)))
+		{
+		Num>>=1;
+		Den>>=1;
+		}
+	if(!Den)return 0x7FFFFFFF;
+	return (Num<<Frac)/Den;
+	}
+
+//ģͼ¶һڱ仯DeltaT(0.1)Ĺ(0.1W)
+static long ThermalModelPower(int Temp,int DeltaT)
+	{
+	long Power;
+	/**************************************************************
+	һRCģͣdT=a*P-b*(T-Ta)ڻƽֵչд
+	dT-dTm=a*(P-Pm)-b*(T-Tm)P=Pm+(dT-dTm)/a+(b/a)*(T-Tm)
+	1/aΪݣb/aΪȵ¶Taƽֵ
+	**************************************************************/
+	Power=ModelMeanP>>8;
+	Power+=((((long)DeltaT<<8)-ModelMeanDT)*ThermalModel.InvGain)>>16;
+	Power+=((((long)Temp<<8)-ModelMeanT)*ThermalModel.Conductance)>>16;
+	return Power;
+	}
+
+//ѹ(0.1W)յǰѹΪ(mA)Limit
+static int ThermalPowerToCurrent(long Power,int Limit)
+	{
+	if(IsNegative16(Limit)||Power<=0)return 0;
+	if(Power>10000)Power=10000; //޷
+	Power=(Power*100000)/Data.OutputVoltage;
+	return Power>Limit?Limit:(int)Power;
+	}
+
+//ʹЭģͲ
+static void ThermalModelSolve(void)
+	{
+	long S[5],Max,Det,NumA,NumB,InvGain,Conductance;
+	unsigned char i;
+	//Эͳһŵ15bitڱ(ͳһŲӰıֵ)
+	Max=0;
+	for(i=0;i<5;i++)
+		{
+		S[i]=ModelCov[i];
+		if(S[i]>Max)Max=S[i];
+		if(-S[i]>Max)Max=-S[i];
+		}
+	while(Max>32767)
+		{
+		Max>>=1;
+		for(i=0;i<5;i++)S[i]>>=1;
+		}
+	//С[PP PT;PT TT][a;-b]=[PY;TY]
+	Det=(S[0]*S[2])-(S[1]*S[1]);
+	NumA=(S[3]*S[2])-(S[4]*S[1]);
+	NumB=(S[1]*S[3])-(S[0]*S[4]);
+	//ʲ̫Сߺ¶ȸ߶أ޷ʶһεĽ
+	if(ModelCov[0]<ModelMinPowerVar||Det<((S[0]*S[2])>>ModelExciteShift))return;
+	//ϵɢϵΪ
+	if(NumA<=0||NumB<=0)
+		{
+		ThermalModel.IsValid=0;
+		return;
+		}
+	//ݺȵǷںΧ
+	InvGain=ThermalFixDiv(Det,NumA,8);
+	Conductance=ThermalFixDiv(NumB,NumA,8);
+	if(InvGain<ModelInvGainMin||InvGain>ModelInvGainMax||Conductance<ModelConductMin||Conductance>ModelConductMax)
+		{
+		ThermalModel.IsValid=0;
+		return;
+		}
+	ThermalModel.InvGain=InvGain;
+	ThermalModel.Conductance=Conductance;
+	ThermalModel.IsValid=ThermalModel.SampleCount<ModelMinSamples?false:true;
+	//Ԥ¶¿Գάֵĵ
+	if(GetIfOutputEnabled()&&Data.OutputVoltage>ModelMinVout)
+		ThermalModel.SustainCurrent=ThermalPowerToCurrent(ThermalModelPower(ConstantTemperature*10,0),LDICCMAX);
+	}
+
+//ʺ¶ȣ߱ʶǵģ
+static void ThermalModelUpdate(void)
+	{
+	int Power,DeltaT,LastTemp,x[3];
+	long Buf;
+	//ۼӲLDĵ繦
+	if(GetIfOutputEnabled())ModelPowerAcc+=((long)Data.OutputVoltage*(long)CurrentBuf)/1000;
+	if(++ModelSampleTIM<ModelSamplePeriod)return;
+	ModelSampleTIM=0;
+	//㱾βƽ(0.1W)¶ȱ仯
+	Power=(int)(ModelPowerAcc/(ModelSamplePeriod*100L));
+	ModelPowerAcc=0;
+	LastTemp=ModelLastTemp;
+	ModelLastTemp=Data.SystempX10;
+	DeltaT=Data.SystempX10-LastTemp;
+	//NTCϡ״β¶ȷʱβ
+	if(!Data.IsNTCOK||!IsModelPrimed||DeltaT>ModelMaxDeltaT||DeltaT<-ModelMaxDeltaT)
+		{
+		IsModelPrimed=Data.IsNTCOK?1:0;
+		return;
+		}
+	//һЧʹòֵʼƽֵ
+	if(!ThermalModel.SampleCount)
+		{
+		ModelMeanP=(long)Power<<8;
+		ModelMeanT=(long)LastTemp<<8;
+		ModelMeanDT=(long)DeltaT<<8;
+		}
+	if(ThermalModel.SampleCount<0xFF)ThermalModel.SampleCount++;
+	//»ƽֵ
+	ModelMeanP+=(((long)Power<<8)-ModelMeanP)>>ModelForgetShift;
+	ModelMeanT+=(((long)LastTemp<<8)-ModelMeanT)>>ModelForgetShift;
+	ModelMeanDT+=(((long)DeltaT<<8)-ModelMeanDT)>>ModelForgetShift;
+	//ֵƽֵƫ(Q4)
+	x[0]=(int)((((long)Power<<8)-ModelMeanP)>>4);
+	x[1]=(int)((((long)LastTemp<<8)-ModelMeanT)>>4);
+	x[2]=(int)((((long)DeltaT<<8)-ModelMeanDT)>>4);
+	//Э(Q8)
+	Buf=(long)x[0]*x[0];
+	ModelCov[0]+=(Buf-ModelCov[0])>>ModelForgetShift;
+	Buf=(long)x[0]*x[1];
+	ModelCov[1]+=(Buf-ModelCov[1])>>ModelForgetShift;
+	Buf=(long)x[1]*x[1];
+	ModelCov[2]+=(Buf-ModelCov[2])>>ModelForgetShift;
+	Buf=(long)x[0]*x[2];
+	ModelCov[3]+=(Buf-ModelCov[3])>>ModelForgetShift;
+	Buf=(long)x[1]*x[2];
+	ModelCov[4]+=(Buf-ModelCov[4])>>ModelForgetShift;
+	//ģͲ
+	ThermalModelSolve();
+	}
+
+//ʹģͼ¿صĵۼֵ
+static void ThermalModelCtrl(void)
+	{
+	int Target,ILIM,Buf;
+	//δѹ޷
+	if(++ModelCtrlTIM<ModelCtrlPeriod)return;
+	ModelCtrlTIM=0;
+	if(Data.OutputVoltage<ModelMinVout)return;
+	/**************************************************************
+	Ԥƣ¶ModelHorizonڰ
+	ģĹʲΪ¶ȸںֵʱĹʵ
+	̬ʣ¶Խ߽Խ࣬ڵֵ֮ǰͿʼС
+	ٹ壻¶ȵںֵʱֱӻصģԤֵ̬
+	Ҫȴ
+	**************************************************************/
+	Target=ConstantTemperature*10;
+	ILIM=ThermalPowerToCurrent(ThermalModelPower(Data.SystempX10,(Target-Data.SystempX10)/ModelHorizon),Current);
+	//沢޷
+	Buf=Current-ILIM;
+	if(Buf>(Current-MinumumILED))Buf=Current-MinumumILED;
+	if(IsNegative16(Buf))Buf=0;
+	//Ƶٶȣģµ
+	if(Buf<(TempProtBuf-ModelRecoverRate))Buf=TempProtBuf-ModelRecoverRate;
+	TempProtBuf=Buf;
+	}
+#endif
+
+//¼¿صֵֵ仯ʱ仯1
+static void ThermalILIMUpdate(void)
+	{
+	int result;
+	//¼ʱʹõĵλЧ(رջͣ)ʱ㣬ȴЧټ
+	ThermalILIMCurrent=Current;
+	if(Current<=0)return;
+	//ж¿ǷҪм
+	if(!IsTempLIMActive)
+		{
+		result=Current; 				//¿ررգƽٷȥ
+		IsThermalStepDown=0;  	//ָʾ¿ѱر
+		#ifdef EnableTurboEnergyBudget
+		if(IsTurboGoverned())
+			{
+			result=TurboBudgetILIMCalc(); //ģʽԤ
+			if(result<(Current-150))IsThermalStepDown=1;
+			}
+		#endif
+		}
+	//ʼ¿ؼ
+	else
+		{
+		result=TempProtBuf+(TempIntegral/IntegralFactor); //ݻ
+		if(IsNegative16(result))result=0; //ֵ
+		result=Current-result; //ֵ
+		if(result<MinumumILED) //ѾˣֹPIDۼ
+			{
+		  TempProtBuf=Current-MinumumILED; //޷ΪС
+		  TempIntegral=0;
+		  result=MinumumILED; //ƲС͵
+			}
+    //ж¿ǷѾ			
+		if(result<(Current-150))IsThermalStepDown=1;	//¿Ѿµ200mAʾ¿ش
+		}
+	//
+	if(result==ThermalILIMResult)return;
+	ThermalILIMResult=result;
+	ThermalILIMSeq++;
+	}
+
 /****************************************************************************/
 /*	Function implementation - global ('extern')
 ****************************************************************************/
@@ -156,41 +568,21 @@ void RecalcPILoop(int LastCurrent)
 		}
 	//
 	TempIntegral=0;
+	//PI״̬ѱ¼ֵ
+	ThermalILIMUpdate();
 	}
 	
-//ǰ¿صֵ
+//ǰ¿صֵ(λûб仯ʱֱӷػĽ)
 int ThermalILIMCalc(void)
 	{
-	int result;
-	//ж¿ǷҪм
-	if(!IsTempLIMActive)
-		{
-		result=Current; 				//¿ررգƽٷȥ
-		IsThermalStepDown=0;  	//ָʾ¿ѱر
-		}
-	//ʼ¿ؼ
-	else
-		{
-		result=TempProtBuf+(TempIntegral/IntegralFactor); //ݻ
-		if(IsNegative16(result))result=0; //ֵ
-		result=Current-result; //ֵ
-		if(result<MinumumILED) //ѾˣֹPIDۼ
-			{
-		  TempProtBuf=Current-MinumumILED; //޷ΪС
-		  TempIntegral=0;
-		  result=MinumumILED; //ƲС͵
-			}
-    //ж¿ǷѾ			
-		if(result<(Current-150))IsThermalStepDown=1;	//¿Ѿµ200mAʾ¿ش
-		}
-	//ؽ	                               
-	return result; 
+	if(Current!=ThermalILIMCurrent)ThermalILIMUpdate();
+	return ThermalILIMResult;
 	}
 
 //¿PI
-void ThermalPILoopCalc(void)	
+static void ThermalPILoopHandler(void)	
 	{
-	int ProtFact,Err,ConstantILED;
+	int ProtFact,Err,ErrX10,ConstantILED;
 	bool IsSwitchToITGTrack;
 	//PIرգλֵ
 	if(!IsTempLIMActive)
@@ -207,6 +599,8 @@ void ThermalPILoopCalc(void)
 		ConstantILED=ILEDConstant;
 		if(IsNearThermalFoldBack)ConstantILED=ILEDConstantFoldback; //ӽ¶ޣʹöµĳ
 		else ConstantILED=ILEDConstant;
+		//¶ȿҵڳִǰ
+		if(CurrentBuf>ConstantILED)ThermalSlopeFeedForward();
 		//¶Ϊ¶ȴںֵ
 		if(Data.Systemp>ConstantTemperature)
 			{		
@@ -218,10 +612,11 @@ void ThermalPILoopCalc(void)
 			if(Data.Systemp>LeaveTurboTemperature-3)IsNearThermalFoldBack=1;
 			//(P)
 			Err=Data.Systemp-ConstantTemperature;  //ֵĿ¶-¶
+			ErrX10=Data.SystempX10-(ConstantTemperature*10); //0.1ֱʵֵڼ
 			StepUpLockTIM=24; //֮¶ȹֹ֮ͣ3
 				
 			//λߵǿʱؽ
-			if((CurrentMode->ModeIdx==Mode_Turbo||CurrentMode->ModeIdx==Mode_Burn)&&CurrentBuf>2850)
+			if((CurrentMode->ModeIdx==Mode_Turbo||CurrentMode->ModeIdx==Mode_Burn)&&CurrentBuf>LDTurboFoldbackCurrent)
 				{
 				//Ѹٽ
 				TempProtBuf+=(20*Err); 
@@ -246,7 +641,7 @@ void ThermalPILoopCalc(void)
 					{
 					//ûдﵽޣύ
 					if(IsLargerThanThreeU16(Err))ProtFact*=(Err+2); 			//¶3϶ȣűϵ
-				  TempProtBuf+=(ProtFact*Err);													//bufύ	
+				  TempProtBuf+=(int)(((long)ProtFact*ErrX10)/10);			//bufύ(ʹ0.1ֱʵֵ)	
 					}
 				//ƱֻܴﵽILEDMIN
 				if(TempProtBuf>(Current-MinumumILED))TempProtBuf=(Current-MinumumILED); 
@@ -293,28 +688,80 @@ void ThermalPILoopCalc(void)
 		}
 	}
 
+#ifdef EnableModelThermalCtrl
+//ģ͵¿ؼ
+static void ThermalModelLoopHandler(void)
+	{
+	//߱ʶģ(¿ؼǰ¹мֵʼս)
+	ThermalModelUpdate();
+	//¿δģδţʹԭеPI
+	if(!IsTempLIMActive||!ThermalModel.IsValid)
+		{
+		IsModelCtrlActive=0;
+		ThermalPILoopHandler();
+		}
+	//ʹģͽ¿ؼ(ûͣʱ)
+	else if(!IsPauseStepDownCalc&&GetIfOutputEnabled())
+		{
+		//PIлѻڵĿۼֵϲ沢һ
+		if(!IsModelCtrlActive)
+			{
+			TempProtBuf+=TempIntegral/IntegralFactor;
+			if(IsNegative16(TempProtBuf))TempProtBuf=0;
+			TempIntegral=0;
+			IsNearThermalFoldBack=0;
+			ModelCtrlTIM=ModelCtrlPeriod-1;
+			IsModelCtrlActive=1;
+			}
+		ThermalModelCtrl();
+		}
+	}
+#endif
+
+//¿ػ·
+void ThermalPILoopCalc(void)
+	{
+	//ʺͼԤ
+	ThermalSlopeCalc();
+	TurboBudgetUpdate();
+	//ִ¿ػ·
+	#ifdef EnableModelThermalCtrl
+	ThermalModelLoopHandler();
+	#else
+	ThermalPILoopHandler();
+	#endif
+	//¿״̬Ѹ£¼ֵ
+	ThermalILIMUpdate();
+	}
+
 //¶ȹ
 void ThermalMgmtProcess(void)
 	{
-	bit ThermalStatus;
+	bit ThermalStatus,IsLastLIMActive;
+	IsLastLIMActive=IsTempLIMActive;
 	//¶ȴִ¶ȿ
 	if(Data.IsNTCOK)
 		{
 		//ֵ¶ȹʱԼ
 		IsForceLeaveTurbo=TempSchmittTrigger(IsForceLeaveTurbo,LeaveTurboTemperature,ForceDisableTurboTemp-10);	//¶Ⱦػļ಻10ȣ˳
-		IsDisableTurbo=TempSchmittTrigger(IsDisableTurbo,ForceDisableTurboTemp,ForceDisableTurboTemp-10); //¶ȴﵽرռֵرռ
+		IsDisableTurbo=TempSchmittTrigger(IsDisableTurbo,ForceDisableTurboTemp,ForceDisableTurboTemp-10); //¶ȴﵽرռֵرռ(Ԥģʽ½뼫һ£Ԥ㲻ʱԤ)
 		//ȹػ
 		IsSystemShutDown=TempSchmittTrigger(IsSystemShutDown,ForceOffTemp,ConstantTemperature-5);
 		if(IsSystemShutDown)ReportError(Fault_OverHeat); //
 		else if(ErrCode==Fault_OverHeat)ClearError(); //ǰ
 		//PIʹܿ
 		if(!CurrentMode->IsNeedStepDown)IsTempLIMActive=0; //ǰλҪ
+		#ifdef EnableTurboEnergyBudget
+		else if(IsTurboGoverned())IsTempLIMActive=0; //ģʽԤ
+		#endif
 		else //ʹʩغ¿Ƿ񼤻
 			{
 			ThermalStatus=TempSchmittTrigger(IsTempLIMActive,ConstantTemperature,ReleaseTemperature); //ȡʩشĽ
-			if(ThermalStatus)IsTempLIMActive=1;//ʩغҪ󼤻¿أ
-			else if(!ThermalStatus&&!TempProtBuf&&IsNegative16(TempIntegral))IsTempLIMActive=0; //ʩغҪر¿أȴΪ0ر
+			if(ThermalStatus||IsThermalRisingFast())IsTempLIMActive=1;//ʩغҪ󼤻¿ػ¶ȼٳֵ
+			else if(!ThermalStatus&&IsThermalLoopReleased())IsTempLIMActive=0; //ʩغҪر¿أȴΪ0ر
 			}
+		//¿ͣ״̬仯¼ֵ
+		if(IsLastLIMActive!=IsTempLIMActive)ThermalILIMUpdate();
 		}
 	//¶ȴϣش
 	else ReportError(Fault_NTCFailed);
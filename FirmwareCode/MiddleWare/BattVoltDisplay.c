@@ -332,8 +332,8 @@ void TriggerTShowDisplay(void)	//
 	VShowFSMPrepare();
 	//¶ȡ
 	IsReportingTemperature=1;
-	if(IsNegative8(Data.Systemp))VbattSample=(int)Data.Systemp*-10;
-	else VbattSample=(int)Data.Systemp*10;
+	if(IsNegative16(Data.SystempX10))VbattSample=-Data.SystempX10;
+	else VbattSample=Data.SystempX10;
 	}
 
 //صѹʾ
@@ -342,7 +342,7 @@ void TriggerVshowDisplay(void)
 	if(VshowFSMState!=BattVdis_Waiting)return; //ǵȴʾ״ֹ̬
 	VShowFSMPrepare();
 	//еѹȡ(ΪLSB=0.01V)
-	VbattSample=(int)(Data.RawBattVolt*100); 		
+	VbattSample=Data.RawBattVolt/10; 		
 	}		
 
 //ɵ͵ʾ
@@ -378,7 +378,7 @@ char RuntimeBatteryUpdateDetect(void)
 	//MCUѹ
 	MCUVDDFaultDetect();
 	//⵽صѹߣǰûп2Sģʽ
-	if(Data.BatteryVoltage>4.35)
+	if(Data.BatteryVoltage>4350)
 		{
 	  if(!IsEnable2SMode)
 			{
@@ -406,7 +406,7 @@ void DisplayVBattAtStart(bit IsPOR)
 	do
 		{
 		SystemTelemHandler();
-		CellVoltage=(int)(Data.BatteryVoltage*1000); //ȡµصѹ
+		CellVoltage=Data.BatteryVoltage; //ȡµصѹ
 		BatteryStateFSM(); //ѭִ״̬µյĵ״̬
 		}
 	while(--i);	
@@ -456,7 +456,7 @@ void BattDisplayTIM(void)
 	//ƽģ
 	if(BattVolt.Count<VBattAvgCount)		
 		{
-		buf=(long)(Data.BatteryVoltage*1000);
+		buf=(long)Data.BatteryVoltage;
 		BattVolt.Count++;
 		BattVolt.AvgBuf+=buf;
 		if(BattVolt.Min>buf)BattVolt.Min=buf;
@@ -22,32 +22,41 @@
 #include "SelfTest.h"
 #include "TempControl.h"
 #include "i2c.h"
-#include "SC8721_REG.h"
+#include "SC8721.h"
+#include "FastOp.h"
+#include "TaskProfiler.h"
+#include "CurrentCal.h"
 
 /****************************************************************************/
 /*	Local pre-processor symbols/macros('#define')
 ****************************************************************************/
 
 //PWMDAC
-#define CurrentOffset 99.0 //ߵͨµĵƫֵ(λ%)
+#define CurrentOffset LDCurrentOffset //ߵͨµĵƫֵ(λ0.1%)LDļ
 
 //DCDC I2C
-#define DCDCADDR 0x62   //DCDCоƬ7bitַ
 #define DCDCSWEnReg SC8721_REG_GLOBALCTRL  //DCDCоƬʹܵļĴַ
 #define DCDCSWEnPos SC8721_SWEnCmd_BitPos  //DCDCоƬʹܵbitλ
 #define DCDCSWEnPolar 0x00  //DCDCоƬʹܵļԣ1=Ч0=Ч(SC8721A˵ǵЧ0)
 
 //DCDC ʼ
-#define DCDCInitStrDepth 8  //DCDCʼ
+#define DCDCInitStrDepth 9  //DCDCʼ
 #define DCDCPostCfgStrDepth 2 //DCDCò
+#define DCDCMaxBurstLen 6 //DCDC·ʱдĴ
 
 //״̬
-#define DCDCInitialCurrent 35     //DCDCʼֵ(LSB=1mA) 
+#define DCDCInitialCurrent LDStartUpCurrent     //DCDCʼֵ(LSB=1mA)LDļ
 #define DCDCTestVoltOffset 1015     //DCDCԵoffset(LSB=0.1%)
 #define DCDCTestVolt 285          //DCDC׶ʱõĳʼѹ(LSB=0.1V)
-#define DCDCStartUpMinVolt 2.70
-#define DCDCStartUpMaxVolt 3.15   //DCDCʱĵѹСֵ
+#define DCDCStartUpMinVolt 2700
+#define DCDCStartUpMaxVolt 3150   //DCDCʱĵѹСֵ(mV)
 #define WaitDACSettleTime 15      //ʱȴPWMDACʱ䣬һ15mSOK
+#define DCDCVOUTReadySamples 15    //ȴ׶ҪڷΧڵVOUT
+#define DCDCVOUTReadyTime 15       //ȴ׶VOUTҪڷΧڵʱ(mS)VOUTܿʱ֤ԭ15mS
+#define DCDCLoadDetectSamples 10   //ʶ׶ҪڷΧڵVOUT
+#define DCDCLoadDetectTime 10      //ʶ׶VOUTҪڷΧڵʱ(mS)VOUTܿʱ֤ԭ10mS
+#define BurnModeSlewRate LDBurnSlewRate  //ģʽʱ𶯵ĵ(mA/S)ѸӵЧ
+#define SlewMaxElapsedTime 10      //𶯵μ(mS)ѭʱͻ
 
 /****************************************************************************/
 /*	Local pre-processor symbols/macros for Parameter processing('#define')
@@ -55,6 +64,42 @@
 #define _PreChargeDACCalc(x) ((39992000UL-(64706UL*x))/10000UL)
 #define PreChargeDACCalc(x)  ((_PreChargeDACCalc(x)*DCDCTestVoltOffset)/1000UL)  //ħʽʹýڵ㲢ֵPWMDAC
 
+/*******************************************************************************
+PWMֵĶ㻻档SC8721AVcsoʽVcso(mV)=I*59/200Ե
+ϵΪPWMDACķѹΪ1/3ٳ3õDACѹDACѹ/VDD*PWMڼΪ
+PWM0ıȽֵPWMֵ=I*VDD*(59*3*ϵ*PWM)/(200*1000*1000)
+VDD=VBG*4096/ADֵPWMֵ=I*ADֵ*X/(3*2^22*5^7)X=177*ϵ*PWMڡ
+ֱʹô϶׼ԭʼADֵ(Q161/3LSBڴ»Ŵ
+1)ΪQ16ٳ2^12X*2^28/(3*2^22*5^7)=X*64/234375
+X*6432λ˲ֱ̺㣬ȡ֤ᳬȷֵ
+ֶ8λõС(DutyGainKFrac)ADֵԸóõQ28ʽ棬λ
+ΪQ16棬Ᵽ8λС(DutyGainFrac)³Q16Ľض(
+ԼΪ/65536)Խ͵ԺԵˮƽ;ȷֵȡ1
+*******************************************************************************/
+#define DutyGainX (177UL*CurrentOffset*PWMStepConstant)
+#define DutyGainRem (((DutyGainX%234375UL)*16384UL)/234375UL) //֣Q8ʽ
+#define DutyGainK (((DutyGainX/234375UL)*64UL)+(DutyGainRem>>8))
+#define DutyGainKFrac (DutyGainRem&0xFF)
+
+//DCDCԵѹǷLDĵֵͨ(ڼLDᱻ)Եѹ285Ӧ2.85V
+#if ((DCDCTestVolt*10) >= LDThresholdVolt)
+	#error "DCDC startup test voltage must be lower than the threshold voltage of the selected LD!"
+#endif
+
+//϶׼ADֵʱǷᳬ32λ
+#if (DutyGainK > (0xFFFFFFFFUL/4095UL))
+	#error "Current offset of the selected LD is too large for the fixed-point duty gain!"
+#endif
+
+#if (DCDCStartUpMaxVolt >= LDThresholdVolt)
+	#error "DCDC startup check voltage window exceeds the threshold voltage of the selected LD!"
+#endif
+
+//(x+ϴ)Ƿᳬ32λ
+#if (LDBeaconSlewRate > ((0xFFFFFFFFUL-1000UL)/SlewMaxElapsedTime))||(LDSOSSlewRate > ((0xFFFFFFFFUL-1000UL)/SlewMaxElapsedTime))||(LDBurnSlewRate > ((0xFFFFFFFFUL-1000UL)/SlewMaxElapsedTime))
+	#error "Ramp slew rate in the LD profile is too large for the slew step calculation!"
+#endif
+
 /****************************************************************************/
 /*	Global variable definitions(declared in header file with 'extern')
 ****************************************************************************/
@@ -70,11 +115,13 @@ typedef enum
 
   //ػ		
 	OCFSM_WaitVoutDecay,     //ȴѹ½
+	OCFSM_WaitDCDCDisable,   //ѹ½˳ʱرDCDCEN͸·MOS
 	OCFSM_GraceShutOFF,      //ͨػ̣I2C׹رDCDC
 	
 	//	
 	OCFSM_PWMDACPreCharge,   //ͨ1CV/CCעPWMDACPWMDACԤ
-	OCFSM_EnableDCDC,        //ͨ2ʹDCDCоƬʼضI2C Host
+	OCFSM_EnableDCDC,        //ͨ2ȴPWMDACʹDCDCоƬ
+	OCFSM_WaitDCDCPowerUp,   //ͨ2.1DCDCʹ1mSʼضI2C Host
 	OCFSM_PushDCDCConfig,    //ͨ3ͨʹʱDCDC֮·DCDCI2Cã״·ðȫñըأ
 
 	OCFSM_WaitVOUTReady,     /**********************************************************************************************
@@ -100,6 +147,7 @@ typedef enum
 	OCFSM_ReadyEnterIdleMode, 	 //ͨԽIdle״̬
 	OCFSM_IdleMode,              //ͨ
 	OCFSM_BackToNormalOperation, //ͨ״̬
+	OCFSM_WaitDCDCSoftStart,     //ͨѻDCDCȴDCDCϺ¿
 
 	}OCFSMStateDef;
 
@@ -121,6 +169,7 @@ static code DCDCConfigDef DCDCInitSeq[DCDCInitStrDepth]= //DCDC
 		SC8721_GLOBALCTRL_CLR,
 	  SC8721_Cmd_DisableDCDC
 		},
+	//Step 2~7ΪĴַһ(0x01-0x06)PushDCDCCfgϲΪһһд
 	//Step 2дCSOĴCSOΪ50(ȫֵըLD)
 	  {
 		SC8721_REG_CSOSET,
@@ -146,21 +195,27 @@ static code DCDCConfigDef DCDCInitSeq[DCDCInitStrDepth]= //DCDC
 		//ѡⲿֹڲĴ޸
 		SC8721_USING_ExtFB|SC8721_IntFB_ADJOFF|SC8721_IntFB_PosOFFSET|SC8721_SET_VOUTLSB(0)   
 		},
-	//Step 6дSYS_SETĴFCCM/DCMԼǷVINREG
+	//Step 6GLOBAL_CTRLĴλдķΧڣֹֽDCDCе״̬ʹVOUT_SETSYS_SETԺϲ·
+		{
+	  SC8721_REG_GLOBALCTRL,
+		SC8721_GLOBALCTRL_CLR,
+	  SC8721_Cmd_DisableDCDC
+		},
+	//Step 7дSYS_SETĴFCCM/DCMԼǷVINREG
 		{
 		SC8721_REG_SYSSET,
 		SC8721_SYSSET_CLR,
 		//ᾭ͸ҪFPWMرӦĬֵ
 		SC8721_CtrlMode_PFM|SC8721_DrvDT_20nS|SC8721_VINREG_Disable
 		},
-	//Step 7дFREQ_SETĴÿƵ
+	//Step 8дFREQ_SETĴÿƵ(0x07ΪĴд룬FREQ_SET·)
 	  {
 		SC8721_REG_FREQSET,
 		SC8721_FREQSET_CLR,
 		//ѹʹõ500KHzƵ
 		SC8721_FSW_500KHz  
 		},
-	//Step 8дGLOBAL_CTRLĴ,Load bitӦѡ
+	//Step 9дGLOBAL_CTRLĴ,Load bitӦѡ(ȫд֮󵥶·)
 	  {
 		SC8721_REG_GLOBALCTRL,
 		0x00,
@@ -188,9 +243,30 @@ static code DCDCConfigDef DCDCPostCfgSeq[DCDCPostCfgStrDepth]= //DCDC
 /*	Local variable and SFR definitions('static and sfr')
 ****************************************************************************/
 static bit IsSlowRamp;
+static xdata unsigned int SlewLastTick;  //ϴμʱ(mS)
+static xdata unsigned int SlewRemain;    //𶯵1mA(1LSB=0.001mA)
+static bit IsOCFaultBlanking;            //(ҪADCתVOUT)
+static bit IsOCSteady;                   //״̬ȶн׶Σ벻ʱ¼
+static xdata int OCSteadyCurrent;        //ȶ״̬ʱĿ(mA)
+static xdata unsigned char OCSteadyILIMSeq; //ȶ״̬ʱ¿ֵı仯
 static xdata unsigned char OCFSMTimer;	
 static xdata unsigned char OCFSMCounter; //ڲʹõļ
+static xdata unsigned int OCFSMDeadline; //״̬ʱĽֹʱ(ϵͳģmS)
+static bit IsOCFSMDelayActive;           //״̬ڽзʱ
+static xdata unsigned int OCFSMDACSettleStamp; //PWMDACԤ佨ϵʱ(mS)
+static xdata unsigned int OCFSMWindowStart; //VOUTʼڷΧڵʱ(mS)OCFSMCounterһλ
+static xdata unsigned char OCFSMVOUTSeq; //ʱϴδVOUT ADC
+
+#ifdef EnableTaskProfiler
+xdata ProfStartupStrDef ProfStartup[ModeTotalDepth]; //ÿλӳͳ
+static xdata unsigned int ProfStartupStamp; //ʼʱ
+static xdata unsigned char ProfStartupMode; //ʱĵλ
+static bit IsProfStartupRunning; //ͳӳ
+#endif
 static OCFSMStateDef OCFSMState;         //ͨ״̬״̬
+static xdata unsigned int DutyGainCode;   //ϴμʱʹõĴ϶׼ADֵ
+static xdata unsigned long DutyGain;      //PWMֵ(Q16ʽ1LSB=1/65536ÿmA)
+static xdata unsigned char DutyGainFrac;  //Q16µ8λС(1LSB=1/2^24ÿmA)
 	
 sbit LDMOSEN=LDMOSENIOP^LDMOSENIOx;      //LED·MOS
 sbit DCDCSDA=DCDCSDAGPIOP^DCDCSDAGPIOx;  //DCDC_SDA
@@ -199,14 +275,73 @@ sbit DCDCEN=DCDCENIOP^DCDCENIOx; //DCDCʹ
 /****************************************************************************/
 /*	Function implementation - local('static')
 ****************************************************************************/
+#ifdef EnableTaskProfiler
+//ӳͳƣͨ뿪ʱʼʱ
+static void ProfStartup_Begin(void)
+	{
+	ProfStartupStamp=GetSysTickMS();
+	ProfStartupMode=CurrentMode->ModeIdx;
+	IsProfStartupRunning=1;
+	}
+
+//ӳͳƣLDʼ(IsTarget=0)ߵﵽĿֵ(IsTarget=1)ʱ¼
+static void ProfStartup_Mark(bit IsTarget)
+	{
+	unsigned int Time;
+	ProfStartupStrDef xdata *Prof;
+	if(!IsProfStartupRunning||ProfStartupMode>=ModeTotalDepth)return;
+	Time=GetSysTickMS()-ProfStartupStamp;
+	Prof=&ProfStartup[ProfStartupMode];
+	if(!IsTarget)
+		{
+		Prof->LightOnTime=Time;
+		return;
+		}
+	//ѴﵽĿֵͳƽ
+	Prof->TargetTime=Time;
+	if(Time>Prof->MaxTargetTime)Prof->MaxTargetTime=Time;
+	if(Prof->Count<0xFF)Prof->Count++;
+	IsProfStartupRunning=0;
+	}
+#else
+//رգͳƺչΪ
+#define ProfStartup_Begin()
+#define ProfStartup_Mark(IsTarget)
+#endif
+
+//м¼ʱǷѾ
+static bit OCFSM_IsStampReached(unsigned int Stamp)
+	{
+	Stamp=GetSysTickMS()-Stamp;
+	return IsNegative16(Stamp)?0:1;
+	}
+
+//״̬ķʱʱڼ״ִ̬ͣУϵͳ(ʵʱΪmsms+1)
+static void OCFSM_SetDelay(unsigned char ms)
+	{
+	OCFSMDeadline=GetSysTickMS()+ms+1;
+	IsOCFSMDelayActive=1;
+	}
+
+//״̬ķʱǷѾ
+static bit OCFSM_IsDelayDone(void)
+	{
+	unsigned int Diff;
+	if(!IsOCFSMDelayActive)return 1;
+	Diff=GetSysTickMS()-OCFSMDeadline;
+	if(IsNegative16(Diff))return 0; //ʱ仹û
+	IsOCFSMDelayActive=0; //ʱ(ϵͳĻƺɵĽֹʱ䱻Ϊδ)
+	return 1;
+	}
+
 //ʹܺͳָ
 static bit OutputChannel_SentDCDCSwEnCmd(bit EN)	
 	{
 	char buf;
 	//Bit MaskԶ
 	#define DCDCENBitMask (1 << DCDCSWEnPos)
-	//ȡ
-	if(I2C_ReadOneByte(DCDCADDR,&buf,DCDCSWEnReg))return 0;
+	//ӰӼĴȡǰֵ
+	if(SC8721_GetShadow(DCDCSWEnReg,&buf,1))return 0;
 	#if (DCDCSWEnPolar == 0)
 		if(EN)buf&=(~DCDCENBitMask);
 		else buf|=DCDCENBitMask;
@@ -214,8 +349,8 @@ static bit OutputChannel_SentDCDCSwEnCmd(bit EN)
  		if(!EN)buf&=(~DCDCENBitMask);
 		else buf|=DCDCENBitMask;		
 	#endif
-	//maskϣд	
-	if(I2C_SendOneByte(DCDCADDR,buf,DCDCSWEnReg))return 0;
+	//maskϣд(ʹλûб仯ʱ)	
+	if(SC8721_WriteReg(DCDCSWEnReg,&buf,1))return 0;
 	//ͨųɹ1
 	return 1;
 	#undef DCDCENBitMask
@@ -227,7 +362,8 @@ static void OCFSMErrorHandler(FaultCodeDef Error)
 	//ʱʱδ򱨴
 	if(OCFSMCounter)
 		{
-		delay_ms(1);
+		IsOCFaultBlanking=1;
+		OCFSM_SetDelay(1); //1mSٴμ
 		OCFSMCounter--;
 		}
 	//ʱʱ䵽
@@ -242,28 +378,63 @@ static void OCFSMErrorHandler(FaultCodeDef Error)
 		}
 	}	
 
-//ڲDCDC·
-static bit PushDCDCCfg(DCDCConfigDef *Cfg)
+//ڲDCDC·áOCFSMCounterָĲ迪ʼѼĴַ
+//ɸϲΪһдرγɹ·Ĳ(0ʾͨʧ)
+static unsigned char PushDCDCCfg(DCDCConfigDef code *Cfg,unsigned char Depth)
 	{
-	char buf;
-	//ȡ
-	if(I2C_ReadOneByte(DCDCADDR,&buf,Cfg[OCFSMCounter].RegAddr))return 0;
-	buf&=(~Cfg[OCFSMCounter].AndMask);
-	buf|=Cfg[OCFSMCounter].ORMask;
-	//ݴϣд
-	if(I2C_SendOneByte(DCDCADDR,buf,Cfg[OCFSMCounter].RegAddr))return 0;
-	//ɹд룬1
-	return 1;
+	char buf[DCDCMaxBurstLen];
+	unsigned char i,Len;
+	//ͳƴӵǰ迪ʼжٸַĲ
+	Cfg=&Cfg[OCFSMCounter];
+	Depth-=OCFSMCounter;
+	Len=1;
+	while(Len<Depth&&Len<DCDCMaxBurstLen&&Cfg[Len].RegAddr==(Cfg[0].RegAddr+Len))Len++;
+	//ӰӼĴȡǰֵ(ӰӼĴЧʱԶоƬȡһ)
+	if(SC8721_GetShadow(Cfg[0].RegAddr,buf,Len))return 0;
+	for(i=0;i<Len;i++)
+		{
+		buf[i]&=(~Cfg[i].AndMask);
+		buf[i]|=Cfg[i].ORMask;
+		}
+	//ݴϣֻݷ仯ļĴд
+	if(SC8721_WriteReg(Cfg[0].RegAddr,buf,Len))return 0;
+	//ɹд룬·Ĳ
+	return Len;
 	}	
 
+//ڲݾϴμ㾭ʱ͵ǰλʼ𶯵ĵ(ʣĲֵ)
+static int OutputChannel_CalcSlewStep(int Remain)
+	{
+	unsigned int Now,Elapsed;
+	unsigned long Step,Rate;
+	extern bit IsBurnMode;
+	//㾭ʱ
+	Now=GetSysTickMS();
+	Elapsed=Now-SlewLastTick;
+	if(!Elapsed)return 0; //ûһģβ
+	SlewLastTick=Now;
+	if(Elapsed>SlewMaxElapsedTime)Elapsed=SlewMaxElapsedTime;
+	//ʼ޷
+	Rate=IsBurnMode?BurnModeSlewRate:CurrentMode->RampSlewRate;
+	Step=((unsigned long)Elapsed*Rate)+SlewRemain;
+	SlewRemain=(unsigned int)(Step%1000);
+	Step/=1000; //ʵλΪmA/S1mAĲ´ۼ
+	if(Remain<=0||Step>(unsigned long)Remain)
+		{
+		SlewRemain=0;
+		return Remain;
+		}
+	return (int)Step;
+	}
+
 //ڲMCUVDDԤDACռձȲдֵ
 static void SetPreChargeDAC(void)
 	{
-	#define PrechargeDACMagicNum (CVPWMDACFullScale*PreChargeDACCalc(DCDCTestVolt))
+	#define PrechargeDACMagicNum ((CVPWMDACFullScale*PreChargeDACCalc(DCDCTestVolt))/1000UL)
 	unsigned long buf;
-	//עPWM=ѹֵ*MCU/CVPWMDACFullScale
-	buf=PrechargeDACMagicNum;
-	buf/=(unsigned long)(Data.MCUVDD*1000);
+	//עPWM=ѹֵ/MCU*CVPWMDACFullScaleʹVDDQ16ѳתΪ˷
+	buf=PrechargeDACMagicNum*(unsigned long)Data.MCUVDDRecip;
+	buf>>=16;
 	//дPWMֵֵ
   PreChargeDACDuty=buf&0xFFFF; //ֵҲûϵΪPWMԼǯλ
   IsNeedToUploadPWM=1;
@@ -272,20 +443,38 @@ static void SetPreChargeDAC(void)
 	}	
 	
 //ڲڼPWMDACռձȵĺ
-static float Duty_Calc(int CurrentInput)			
+static unsigned int Duty_Calc(int CurrentInput)			
 	{
-	float buf;
-	//ݵֵ
-  buf=((float)CurrentInput*(float)59)/(float)200;  //SC8721A VcsoӦĹʽVcso˵ĵѹ(mV)
-	buf*=(float)CurrentOffset/(float)100; //Խϵ
-	buf*=(float)3;                        //ΪӲPWMDACĲ1/3Գ3õյѹ
-		
-	//PWMDACռձ	
-	buf/=Data.MCUVDD*(float)1000; //ĿDACѹPWMDACѹ(MCUVDD)֮ıֵ
-	buf*=100; //תΪٷֱ
-
-	//ûǯλҲûϵΪPWMǿƶΣûϵģ
-	return buf;
+	unsigned long buf;
+	//϶׼ADֵֻADCVREFͨʱ仯ʱ¼
+	if(Data.VBGADCode!=DutyGainCode)
+		{
+		DutyGainCode=Data.VBGADCode;
+		buf=(unsigned long)DutyGainCode*DutyGainK;
+		buf+=((unsigned long)DutyGainCode*DutyGainKFrac)>>8;
+		DutyGain=buf>>12;
+		DutyGainFrac=(buf>>4)&0xFF;
+		}
+	//ֵǷ0
+	if(CurrentInput<=0)
+		{
+		#ifdef EnablePWMDACDither
+		PWMDutyFrac=0;
+		#endif
+		return 0;
+		}
+	//ӦñĵУ׼PWMDACԪĸ
+	CurrentInput=CurrentCal_Apply(CurrentInput);
+	//Q16ʽPWMֵûǯλҲûϵΪPWMǿƶΣûϵģ
+	buf=(unsigned long)CurrentInput*DutyGain;
+	buf+=((unsigned long)CurrentInput*DutyGainFrac)>>8;
+	#ifdef EnablePWMDACDither
+	buf>>=16-PWMDACDitherBits;
+	PWMDutyFrac=buf&((1<<PWMDACDitherBits)-1); //СֽPWMжϽж
+	return (unsigned int)(buf>>PWMDACDitherBits);
+	#else
+	return (unsigned int)(buf>>16);
+	#endif
 	}
 
 //ͨ״̬ı
@@ -299,6 +488,12 @@ static void OutputChannel_ResetSysVar(void)
 	OCFSMCounter=0;
   OCFSMState=OCFSM_Idle;
 	IsSlowRamp=0;	
+	IsOCFaultBlanking=0;
+	IsOCSteady=0;
+	IsOCFSMDelayActive=0;
+	DutyGainCode=0;
+	DutyGain=0;
+	DutyGainFrac=0;
 	}	
 	
 //DCDCI2C
@@ -318,6 +513,8 @@ static void OutputChannel_DCDCI2CCfg(bit IsEnable)
 	GPIO_SetMUXMode(DCDCSDAGPIOG,DCDCSDAGPIOx,IsEnable?GPIO_AF_SDA:GPIO_AF_GPIO); //ΪSDA
 	GPIO_ConfigGPIOMode(DCDCSDAGPIOG,GPIOMask(DCDCSDAGPIOx),&OCInitCfg); 
 	
+	//DCDCϵ߶ϵоƬĴḴλӰӼĴ
+	SC8721_InvalidateCache();
 	//I2C
 	if(IsEnable)
 		{
@@ -330,11 +527,20 @@ static void OutputChannel_DCDCI2CCfg(bit IsEnable)
 //DCDC״̬
 static void OutputChannel_DetectDCDCState(void)	
 	{
-	switch(OutputChannel_GetDCDCState())
+	unsigned char Seq;
+	DCDCStateDef State;
+	//ÿյһµVOUTŽһμ⣬ADCVOUTתʾ
+	Seq=ADC_GetChSeq(VOUTFBAIN);
+	if(Seq==OCFSMVOUTSeq)return;
+	//ȡDCDC״̬״̬ں̨ȡʱVOUTһټ
+	State=OutputChannel_GetDCDCState();
+	if(State==DCDC_StatuPending)return;
+	OCFSMVOUTSeq=Seq;
+	switch(State)
 		{
 		//عش·
 		case DCDC_OutputShort:									 
-			if(OCFSMTimer&0x08||Data.OutputVoltage>1.0)break;             //·ֻѹС1VΪ·
+			if(OCFSMTimer&0x08||Data.OutputVoltage>1000)break;             //·ֻѹС1VΪ·
 			OCFSMErrorHandler(Fault_DCDCShort);
 			break;
 		case DCDC_Normal:		  
@@ -342,10 +548,10 @@ static void OutputChannel_DetectDCDCState(void)
 			if(Data.OutputVoltage<DCDCStartUpMinVolt||Data.OutputVoltage>DCDCStartUpMaxVolt)
 				{
 				OCFSMCounter=50;
-				if(!IsNeedToUploadPWM)SetPreChargeDAC();  //ⲻͨԸPWMDACռձ
+				OCFSMWindowStart=GetSysTickMS();
+				SetPreChargeDAC();  //ⲻͨԸPWMDACռձ
 				}
-			else OCFSMCounter++; 
-			delay_ms(1);
+			else if(OCFSMCounter<0xFF)OCFSMCounter++; //ȴʱڼ
 		  break;
 		case DCDC_Warn_CBCOCP:
 		case DCDC_INTILIM:
@@ -364,6 +570,7 @@ static void OutputChannel_DetectDCDCState(void)
 			OCFSMErrorHandler(Fault_DCDC_TSD);
 		  break; 						 																		 //DCDCоƬ¹ػ
 		case DCDC_StatuUnknown:OCFSMErrorHandler(Fault_DCDC_I2C_CommFault);break; //ͨ쳣
+		case DCDC_StatuPending:break; //״̬ں̨ȡ(ϷѾǰأֻǱ֤֧)
 		}	
 	}
 
@@ -374,20 +581,30 @@ static void OutputChannel_DetectDCDCState(void)
 //ȡDCDC״̬ϵͳҪԼʵ֣SC8721Ĵ룩
 DCDCStateDef OutputChannel_GetDCDCState(void)
 	{
-	char buf;
-	//ȡSTATUS1Ĵ
-	if(I2C_ReadOneByte(DCDCADDR,&buf,SC8721_REG_STATUS1))return DCDC_StatuUnknown;
+	char buf[2];
+	//ȡغ̨ȡSTATUS1STATUS2Ĵ(ȡI2Cжɣѭ)
+	switch(SC8721_ReadStatus(buf))
+		{
+		case SC8721_Status_Pending:return DCDC_StatuPending; //ûнһٲѯ
+		case SC8721_Status_CommErr:return DCDC_StatuUnknown; //ͨ쳣
+		default:break;
+		}
 	//жǷ񴥷hiccup͹±
-	if(buf&SC8721_Fault_VOUTShort_Msk)return DCDC_OutputShort; //·
-	if(buf&SC8721_Fault_TSD_Msk)return DCDC_ThermalShutDown; //THD=1IC±
-	if(buf&SC8721_Warning_CBCOCP_Msk)return DCDC_Warn_CBCOCP; //ƬCBC OCP
-	//ȡ0x0AĴ
-	if(I2C_ReadOneByte(DCDCADDR,&buf,SC8721_REG_STATUS2))return DCDC_StatuUnknown;
-	if(buf&SC8721_STATU_BUSILIM_Msk)return DCDC_INTILIM;   //оƬڲ
+	if(buf[0]&SC8721_Fault_VOUTShort_Msk)return DCDC_OutputShort; //·
+	if(buf[0]&SC8721_Fault_TSD_Msk)return DCDC_ThermalShutDown; //THD=1IC±
+	if(buf[0]&SC8721_Warning_CBCOCP_Msk)return DCDC_Warn_CBCOCP; //ƬCBC OCP
+	//ж0x0AĴ
+	if(buf[1]&SC8721_STATU_BUSILIM_Msk)return DCDC_INTILIM;   //оƬڲ
   //ϵͳ
 	return DCDC_Normal;
 	}	
 
+//ں̨ԤύDCDC״̬ȡ֮OutputChannel_GetDCDCStateȡµĽ
+void OutputChannel_PrefetchDCDCState(void)
+	{
+	SC8721_PrefetchStatus();
+	}
+
 	
 //ȡǷ
 bit GetIfOutputEnabled(void)
@@ -439,7 +656,14 @@ void OutputChannel_Init(void)
 void OutputChannel_Calc(void)
 	{
 	int TargetCurrent;
-	extern bit IsBurnMode;
+	unsigned char Step;
+	//״̬ȶУĿ¿ֵûб仯¼
+	if(IsOCSteady&&Current==OCSteadyCurrent&&ThermalILIMSeq==OCSteadyILIMSeq)
+		{
+		if(!CurrentCal_IsTableUpdated())return;
+		OCFSMState=OCFSM_RaiseCurrent; //У׼µУ׼¼ռձ
+		}
+	IsOCSteady=0;
 	//ȡĿӦ¿ؼȨ
 	if(Current>0)
 		{
@@ -450,13 +674,18 @@ void OutputChannel_Calc(void)
 		}
 	//ֵΪ0-1ֱӶȡĿֵ
 	else TargetCurrent=Current;
-	//ǰϵͳ̬=0ʾҪϵͳر	
+	//ǰϵͳ̬=0ʾҪϵͳر(Ҫʱ֮ǰȷػԴеʱ)
 	if(OCFSMState>OCFSM_GraceShutOFF&&!TargetCurrent)
 		{
 		//ͨ״̬صȫرս׶
 		if(OCFSMState==OCFSM_IdleMode)LDMOSEN=1;                       //ϵͳͣ׶ΣȫػҪŵ
 		OCFSMState=OCFSM_GraceShutOFF;
+		IsOCFSMDelayActive=0;                                          //ȡеʱִйػ
 		}
+	//״̬ڽзʱֱӷϵͳִ
+	if(!OCFSM_IsDelayDone())return;
+	//־λɱ״̬ж
+	IsOCFaultBlanking=0;
 	//ִ״̬
 	switch(OCFSMState)	
 		{
@@ -475,13 +704,21 @@ void OutputChannel_Calc(void)
 		//ȴѹ
 		case OCFSM_WaitVoutDecay:
 			 //ǰʱûʱѹûȴ
-			 if(OCFSMTimer&&Data.OutputVoltage>2.5)break;
+			 if(OCFSMTimer&&Data.OutputVoltage>2500)break;
 		   //ѹɹ£ȸλI2C IPʱ2mSرEN
 		   OutputChannel_DCDCI2CCfg(0);
-		   delay_ms(2);
-		   DCDCEN=0;
-		   //ENµ󾭹1mSٶϿأرܵ
-		   delay_ms(1);
+		   OCFSM_SetDelay(2);
+		   OCFSMState=OCFSM_WaitDCDCDisable;
+		   break;
+		//I2CѹرգιرEN͸
+		case OCFSM_WaitDCDCDisable:
+		   //رENENµ󾭹1mSٶϿأرܵ
+		   if(DCDCEN)
+				 {
+				 DCDCEN=0;
+				 OCFSM_SetDelay(1);
+				 break;
+				 }
 	     LDMOSEN=0;	
 		   //صʼ״̬
 		   OCFSMState=OCFSM_Idle;
@@ -492,7 +729,11 @@ void OutputChannel_Calc(void)
 			OCFSMTimer=0;
 			OCFSMCounter=0;
 		  //0̣򱣳
-		  if(TargetCurrent>0)OCFSMState=OCFSM_PWMDACPreCharge;
+		  if(TargetCurrent>0)
+				{
+				ProfStartup_Begin();
+				OCFSMState=OCFSM_PWMDACPreCharge;
+				}
 			break;
 		//ϵͳʼ0ͳPWMDAC
 	  case OCFSM_PWMDACPreCharge:
@@ -500,18 +741,23 @@ void OutputChannel_Calc(void)
 		   CurrentBuf=DCDCInitialCurrent;   //DCDCʼֵ
 			 PWMDuty=Duty_Calc(CurrentBuf);  //Ŀĵֵò
        SetPreChargeDAC();              //ԤPWMDAC
-			 //15mSĵȴPWMDACܵһ
-		   OCFSMCounter=WaitDACSettleTime;
+			 //¼PWMDACϵʱ䣬DCDCҪȵʱܿʼ
+		   OCFSMDACSettleStamp=GetSysTickMS()+WaitDACSettleTime+1;
 		   OCFSMState=OCFSM_EnableDCDC;
 		   break;
 	  //ϵͳʼȴ20mSʹENʼI2C
 		case OCFSM_EnableDCDC:
-		   //ϵͳڵȴPWMDACʼ
-		   delay_ms(1);
-		   if(IsNeedToUploadPWM||--OCFSMCounter)break;
-		   //ȴʹEN1mSʼI2Cʼͨ
+		   //ϵͳڵȴPWMDACʼֵЧ
+		   if(!PWM_IsCommitDone())break;
+		   //ȴPWMDAC
+		   if(!OCFSM_IsStampReached(OCFSMDACSettleStamp))break;
+		   //ʹEN1mSʼI2Cʼͨ
 		   DCDCEN=1;
-		   delay_ms(1);
+		   OCFSM_SetDelay(1);
+		   OCFSMState=OCFSM_WaitDCDCPowerUp;
+		   break;
+		//DCDCʹܣʼI2C
+		case OCFSM_WaitDCDCPowerUp:
        OutputChannel_DCDCI2CCfg(1);
        OCFSMCounter=0;		
 		   OCFSMTimer=8;                     //pushȴ1
@@ -528,22 +774,26 @@ void OutputChannel_Calc(void)
 					if(!OutputChannel_SentDCDCSwEnCmd(1))break;
 					OCFSMTimer=4;                //ѹȴ0.5
 					OCFSMCounter=50;  						//
+					OCFSMWindowStart=GetSysTickMS();
+					OCFSMVOUTSeq=ADC_GetChSeq(VOUTFBAIN); //ֻͳʹ֮VOUT
 					OCFSMState=OCFSM_WaitVOUTReady;
 					}
 			 //δϣָ
-		   else if(PushDCDCCfg(&DCDCInitSeq[0]))OCFSMCounter++;
-			 else delay_ms(1);  										//·ʧܣʱ1mS
+		   else if((Step=PushDCDCCfg(&DCDCInitSeq[0],DCDCInitStrDepth))!=0)OCFSMCounter+=Step;
+			 else OCFSM_SetDelay(1);  							//·ʧܣʱ1mS
 		   break;
 	  //DCDCоƬȴ
 		case OCFSM_WaitVOUTReady:		   
 			 //ϵͳʱѹȻûдﵽ涨Χ˵ϵͳϣ
 			 if(!OCFSMTimer)OCFSMErrorHandler(Fault_DCDCVOUTTestError);	
-		   //ϵͳʱﵽ㹻ʱ䣬
-		   else if(OCFSMCounter==65)
+		   //VOUTڷΧڵĲʱ䶼ﵽҪ󣬼
+		   else if(OCFSMCounter>=(50+DCDCVOUTReadySamples)&&OCFSM_IsStampReached(OCFSMWindowStart+DCDCVOUTReadyTime+1))
 					{
 					LDMOSEN=1;           //·=1ͨ	
 					OCFSMState=OCFSM_LoadDetect; //븺ʶ
 					OCFSMCounter=50;
+					OCFSMWindowStart=GetSysTickMS();
+					OCFSMVOUTSeq=ADC_GetChSeq(VOUTFBAIN); //ֻͳƽ֮ͨVOUT
 					OCFSMTimer=4;        //ִкãȴ0.5
 					}
 			 //ȴѹ	
@@ -554,8 +804,8 @@ void OutputChannel_Calc(void)
 		case OCFSM_LoadDetect:
 			 //ϵͳʱȻ޷ɸʶ˵ϵͳϣ
 			 if(!OCFSMTimer)OCFSMErrorHandler(Fault_InvalidLoad);	
-		   //ϵͳʱﵽ㹻ʱ䣬
-		   else if(OCFSMCounter==60)
+		   //VOUTڷΧڵĲʱ䶼ﵽҪ󣬼
+		   else if(OCFSMCounter>=(50+DCDCLoadDetectSamples)&&OCFSM_IsStampReached(OCFSMWindowStart+DCDCLoadDetectTime+1))
 					{
 					OCFSMState=OCFSM_PostDCDCConfig;
 					OCFSMCounter=0;
@@ -572,16 +822,17 @@ void OutputChannel_Calc(void)
 		   else if(OCFSMCounter==DCDCPostCfgStrDepth)
 					{
 					//к·ɹת̧ѹĽ׶οʼѹ
+					ProfStartup_Mark(0);
 					OCFSMState=OCFSM_IncreaseVOUT;
 					}
 			 //δϣָ
-		   else if(PushDCDCCfg(&DCDCPostCfgSeq[0]))OCFSMCounter++;
-			 else delay_ms(1);  										//·ʧܣʱ1mS
+		   else if((Step=PushDCDCCfg(&DCDCPostCfgSeq[0],DCDCPostCfgStrDepth))!=0)OCFSMCounter+=Step;
+			 else OCFSM_SetDelay(1);  							//·ʧܣʱ1mS
 		   break;			 
 		//ʼ̧ѹĿֵLD
     case OCFSM_IncreaseVOUT:
-		  //ʼµԤռձȰѹֵ
-		  if(!IsNeedToUploadPWM)
+		  //ʼµԤռձȰѹֵÿµһεֵύЧ
+		  if(PWM_IsCommitDone())
 				{
 				//ԤPWMDAC=0˵Ԥ,ʱת״̬
 				if(!PreChargeDACDuty)OCFSMState=OCFSM_NormalOperation;	
@@ -601,28 +852,23 @@ void OutputChannel_Calc(void)
 		  break;
 		//ʼ̧
 		case OCFSM_RaiseCurrent:
-			if(IsNeedToUploadPWM)break; //PWMӦУȴ
-		  
-			if((TargetCurrent-CurrentBuf)>600)IsSlowRamp=1; //⵽ǳĵ˲̬屬
+			if(!IsSlowRamp&&(TargetCurrent-CurrentBuf)>600)
+				{
+				IsSlowRamp=1; //⵽ǳĵ˲̬屬
+				SlewLastTick=GetSysTickMS(); //ڿʼʱ
+				SlewRemain=0;
+				}
 			if(IsSlowRamp)
 				{
 				//ʼӵ
 				if(CurrentBuf==0)
 					{
 					//ǰϵͳΪ0жϴĵֵӵ͵ʼ
-					if(TargetCurrent<300)CurrentBuf=TargetCurrent;
-					else CurrentBuf=300;
-					}
-			  //ϵͳΪ0ʼӵ
-			  else if(IsBurnMode)CurrentBuf+=50;    //ģʽѸӵЧ
-        else switch(CurrentMode->ModeIdx)
-					{
-					case Mode_Ramp:CurrentBuf+=2;break;      //޼ʹ2ٶȱ
-					case Mode_Beacon:CurrentBuf+=1000;break; //űģʽ
-					case Mode_SOS:
-					case Mode_SOS_NoProt:CurrentBuf+=400;break;  //SOSģʽ¿ӵβӰж
-					default:CurrentBuf++;											 	 //൲λĬϻ
+					if(TargetCurrent<LDSlowRampStartCurrent)CurrentBuf=TargetCurrent;
+					else CurrentBuf=LDSlowRampStartCurrent;
 					}
+			  //ϵͳΪ0վʱ͵λӵ
+			  else CurrentBuf+=OutputChannel_CalcSlewStep(TargetCurrent-CurrentBuf);
 				if(CurrentBuf>=TargetCurrent)
 					{
 					IsSlowRamp=0;
@@ -638,13 +884,21 @@ void OutputChannel_Calc(void)
 	    break;	
     //ͨн׶
 		case OCFSM_NormalOperation:
+		  if(TargetCurrent==CurrentBuf)ProfStartup_Mark(1); //ѴﵽĿֵ¼ӳ
 		  if(TargetCurrent==-1)
 				{
 				//ϵͳΪ-1˵ҪͣLEDתͣ
 				OCFSMState=OCFSM_ReadyEnterIdleMode;	
 				OCFSMCounter=100;         //100
 				}
-			if(TargetCurrent!=CurrentBuf)OCFSMState=OCFSM_RaiseCurrent; //ռձȷʼд
+			if(TargetCurrent!=CurrentBuf||CurrentCal_IsTableUpdated())OCFSMState=OCFSM_RaiseCurrent; //ռձȻУ׼ʼд
+			//Ȼн׶Σ¼ֵ룬֮벻ʱ
+			else
+				{
+				IsOCSteady=1;
+				OCSteadyCurrent=Current;
+				OCSteadyILIMSeq=ThermalILIMSeq;
+				}
 			break;
 		//ϵͳIDLEģʽ
 		case OCFSM_ReadyEnterIdleMode:
@@ -671,15 +925,22 @@ void OutputChannel_Calc(void)
 			 //ʹDCDC
 			 if(OutputChannel_SentDCDCSwEnCmd(1))
 				 {
-				 //ɹDCDC1mSDCDCPWMDAC
-				 delay_ms(5); 
-				 PreChargeDACDuty=0;
-				 IsNeedToUploadPWM=1;
-				 //תִн׶
-				 OCFSMState=OCFSM_NormalOperation;
+				 //ɹDCDC5mSDCDCPWMDAC
+				 OCFSM_SetDelay(5); 
+				 OCFSMState=OCFSM_WaitDCDCSoftStart;
 				 }
 			 //ִָʧܣ³ԣ100γδɹ򱨴
 			 else OCFSMErrorHandler(Fault_DCDC_I2C_CommFault);
 		   break;		   
+		//DCDCϣ¿
+		case OCFSM_WaitDCDCSoftStart:
+			 PreChargeDACDuty=0;
+			 IsNeedToUploadPWM=1;
+			 //תִн׶
+			 OCFSMState=OCFSM_NormalOperation;
+			 break;
 		}
+	//ȴѹʶԼڼҪ뼶VOUTݣADCתVOUT
+	if(OCFSMState==OCFSM_WaitVOUTReady||OCFSMState==OCFSM_LoadDetect)ADC_SetVOUTBoost(1);
+	else ADC_SetVOUTBoost(IsOCFaultBlanking);
 	}
@@ -21,13 +21,16 @@
 #include "SysReset.h"
 #include "OutputChannel.h"
 #include "ADCCfg.h"
+#include "CurrentCal.h"
 
 /****************************************************************************/
 /*	Local pre-processor symbols/macros('#define')
 ****************************************************************************/
 
 //Flash
-#define	DataFlashLen 0x3FF  //CMS8S6990Ƭ1KByteѰַΧ0-3FF
+#define	DataFlashLen 0x1FF  //CMS8S6990Ƭ1KByteѰַΧ0-3FFϵͳʹ1(0-1FF)
+#define CalTableBase 0x200  //2(200-3FF)洢У׼ϵͳòдʱӰУ׼
+#define CalTableMagic 0x35  //У׼ıʶ
 #define SysCfgGroupLen (DataFlashLen/sizeof(SysROMImg))-1   //õϳ
 
 //ڲbit fieldĴ洢Mask
@@ -68,6 +71,20 @@ typedef union
 	char ByteBuf[sizeof(SysROMImageDef)];
 	}SysROMImg;
 
+//У׼Ĵ洢(λɵĸʽһ)
+typedef struct
+	{
+	unsigned char Magic;
+	CalTableDef Table;
+	char CheckSum;
+	}CalROMImageDef;
+
+typedef union
+	{
+	CalROMImageDef Data;
+	char ByteBuf[sizeof(CalROMImageDef)];
+	}CalROMImg;
+
 /****************************************************************************/
 /*	Local variable  definitions('static')
 ****************************************************************************/
@@ -116,7 +133,8 @@ static int SearchSysConfig(SysROMImg *ROMData)
 	//ȡһȷ
 	if(Len>0)Len--;
 	for(i=0;i<sizeof(SysROMImageDef);i++)Flash_Operation(DataFlash_Read,i+(Len*sizeof(SysROMImg)),&ROMData->ByteBuf[i]);
-	//ȡһݵindex
+	//ȡflash(ĳ׼ҪжϽADC)һݵindex
+	SetFlashState(0);
 	return Len;
 	}
 
@@ -148,7 +166,7 @@ static void PrepareFactoryDefaultCfg(void)
 	//ADC
   DisableADCAsync();
 	SystemTelemHandler();
-	IsEnable2SMode=Data.RawBattVolt>4.35?1:0;
+	IsEnable2SMode=Data.RawBattVolt>4350?1:0;
 	}	
 	
 //Լûò	
@@ -204,15 +222,13 @@ void ReadSysConfig(void)	//
 		SaveSysConfig(1);  //ؽݺ
 		ShowEPROMCorrupted(); //ʾEEPROM
 		}
-	//ȡϣflash	
-	SetFlashState(0);
 	}
 
 //ָ޼ģʽ͵
 void LoadMinimumRampCurrentToRAM(void)	
 	{
 	bool Result;
-	ModeStrDef *Mode=FindTargetMode(Mode_Ramp,&Result);
+	ModeStrDef code *Mode=FindTargetMode(Mode_Ramp,&Result);
 	if(Result)SysCfg.RampCurrent=Mode->MinCurrent; //ҵλ޼ĵλ
 	else SysCfg.RampCurrent=200; //ĬϻָΪ200mA
 	}	
@@ -241,8 +257,7 @@ void SaveSysConfig(bit IsForceSave)
 	//Ҫ棬ʼǷҪ
 	if(IsForceSave||CurrentIdx>=SysCfgGroupLen) 
 		{
-		//Ѿдˣ01ȫ
-		Flash_Operation(DataFlash_Erase,0x200,&i);  //2=512-1023
+		//Ѿдˣ1ȫ(2洢У׼)
 		Flash_Operation(DataFlash_Erase,0,&i);      //1=0-511
 		//ӵ0λÿʼд
 		CurrentIdx=0;
@@ -254,3 +269,36 @@ void SaveSysConfig(bit IsForceSave)
 	SetFlashState(0);//дϣflash	
 	}	
 
+
+//ȡУ׼1ʾУ׼ڻ
+bit ReadCalTable(CalTableDef *Table)
+	{
+	unsigned char i;
+	xdata CalROMImg ROMData;
+	//flashȡ
+	SetFlashState(1);
+	for(i=0;i<sizeof(CalROMImageDef);i++)Flash_Operation(DataFlash_Read,CalTableBase+i,&ROMData.ByteBuf[i]);
+	SetFlashState(0);
+	//ʶCRC
+	if(ROMData.Data.Magic!=CalTableMagic)return 1;
+	if(ROMData.Data.CheckSum!=PEC8Check(ROMData.ByteBuf,sizeof(CalROMImageDef)-1))return 1;
+	//Уͨ
+	*Table=ROMData.Data.Table;
+	return 0;
+	}
+
+//У׼
+void SaveCalTable(CalTableDef *Table)
+	{
+	unsigned char i;
+	xdata CalROMImg SavedData;
+	//ݲCRC
+	SavedData.Data.Magic=CalTableMagic;
+	SavedData.Data.Table=*Table;
+	SavedData.Data.CheckSum=PEC8Check(SavedData.ByteBuf,sizeof(CalROMImageDef)-1);
+	//flash2д
+	SetFlashState(1);
+	Flash_Operation(DataFlash_Erase,CalTableBase,&i);
+	for(i=0;i<sizeof(CalROMImageDef);i++)Flash_Operation(DataFlash_Write,CalTableBase+i,&SavedData.ByteBuf[i]);
+	SetFlashState(0);//дϣflash	
+	}
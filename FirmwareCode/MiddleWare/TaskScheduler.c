@@ -0,0 +1,183 @@
+/****************************************************************************/
+/** \file TaskScheduler.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļʵϵͳѭıЭʽÿ
+ԼڡλƫƺִʱԤ㣬1mSϵͳͷ񣬲
+Ԥʹڵмʹƻ·ִʲѭٶȡ
+ִʱԤĵλΪuSҪTimer1ṩuSʱֻEnableTaskProfiler
+ʱŻԤ㣬رշʱԤʼΪ0
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include "cms8s6990.h"
+#include "delay.h"
+#include "SideKey.h"
+#include "LEDMgmt.h"
+#include "ADCCfg.h"
+#include "PWMCfg.h"
+#include "i2c.h"
+#include "LowVoltProt.h"
+#include "TempControl.h"
+#include "BattDisplay.h"
+#include "ModeControl.h"
+#include "OutputChannel.h"
+#include "SelfTest.h"
+#include "SOS.h"
+#include "BreathMode.h"
+#include "Beacon.h"
+#include "TaskScheduler.h"
+#include "TaskProfiler.h"
+#include "FastOp.h"
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+#define SchedFastTaskPeriod 1 //1kHz(mS)
+#define SchedSlowTaskPeriod 125 //8Hz(mS)
+#define SchedTask1GroupPhase 62 //ԭTask1Task0λƫ(mS)񽻴ִ
+
+/****************************************************************************/
+/*	Global variable definitions(declared in header file with 'extern')
+****************************************************************************/
+xdata SchedTaskRTDef SchedTaskRT[SchedTaskCount]; //״̬
+
+/****************************************************************************/
+/*	External function prototypes
+****************************************************************************/
+void SleepMgmt(void);
+
+/****************************************************************************/
+/*	Local constant definitions('static code')
+****************************************************************************/
+static code SchedTaskStrDef SchedTaskTable[SchedTaskCount]=
+	{
+	//ID                   (mS)              λ(mS)                  Ԥ(uS)
+	//ÿȦִеʵʱ(Ԥϼ1mSʱ1kHzῪʼ)
+	{Task_SystemTelem,         0,                    0,                        150},
+	{Task_BatteryTelem,        SchedFastTaskPeriod,  0,                        150},
+	{Task_SideKeyLogic,        SchedFastTaskPeriod,  0,                        100}, //̶1kHz8βȥʱ̶Ϊ8mS
+	{Task_ThermalMgmt,         SchedFastTaskPeriod,  0,                        100},
+	{Task_ModeSwitchFSM,       0,                    0,                        150}, //޼ⰴյôÿȦִ
+	{Task_OutputChannelCalc,   0,                    0,                        250},
+	{Task_PWMOutputCtrl,       0,                    0,                        50},
+	{Task_I2CASync,            0,                    0,                        50},
+	//8HzԭTask0飬ÿ2mS
+	{Task_LEDControl,          SchedSlowTaskPeriod,  0,                        200},
+	{Task_BattAlertTIM,        SchedSlowTaskPeriod,  2,                        100},
+	{Task_OutputFaultPrefetch, SchedSlowTaskPeriod,  3,                        100}, //ȹϼǰ1mSύ״̬ȡ
+	{Task_OutputFaultDetect,   SchedSlowTaskPeriod,  4,                        300},
+	{Task_ThermalPILoop,       SchedSlowTaskPeriod,  6,                        1000},
+	{Task_SleepMgmt,           SchedSlowTaskPeriod,  8,                        0}, //˯ڼʱֹͣԤ
+	{Task_BreathFSMTIM,        SchedSlowTaskPeriod,  10,                       50},
+	//8HzԭTask1飬ÿ2mS
+	{Task_SideKeyTIM,          SchedSlowTaskPeriod,  SchedTask1GroupPhase,     100},
+	{Task_BattDisplayTIM,      SchedSlowTaskPeriod,  SchedTask1GroupPhase+2,   100},
+	{Task_DisplayErrorTIM,     SchedSlowTaskPeriod,  SchedTask1GroupPhase+4,   100},
+	{Task_ModeFSMTIM,          SchedSlowTaskPeriod,  SchedTask1GroupPhase+6,   200},
+	{Task_HoldSwitchGear,      SchedSlowTaskPeriod,  SchedTask1GroupPhase+8,   200},
+	{Task_SOSTIM,              SchedSlowTaskPeriod,  SchedTask1GroupPhase+10,  50},
+	{Task_BeaconFSMTIM,        SchedSlowTaskPeriod,  SchedTask1GroupPhase+12,  50},
+	{Task_OutputChannelFSMTIM, SchedSlowTaskPeriod,  SchedTask1GroupPhase+14,  100}
+	};
+
+/****************************************************************************/
+/*	Function implementation - local('static')
+****************************************************************************/
+
+//IDִжӦ(ʹswitchַC51ָƻoverlay)
+static void Scheduler_RunTask(SchedTaskIdxDef TaskID)
+	{
+	switch(TaskID)
+		{
+		//ÿȦִеʵʱ
+		case Task_SystemTelem:SystemTelemHandler();break;
+		case Task_BatteryTelem:BatteryTelemHandler();break; //ȡADC͵Ϣ
+		case Task_SideKeyLogic:SideKey_LogicHandler();break; //ఴ
+		case Task_ThermalMgmt:ThermalMgmtProcess();break; //¶ȹ
+		case Task_ModeSwitchFSM:ModeSwitchFSM();break; //λ״̬
+		case Task_OutputChannelCalc:OutputChannel_Calc();break; //ͨ
+		case Task_PWMOutputCtrl:PWM_OutputCtrlHandler();break; //PWM
+		case Task_I2CASync:I2C_ASyncHandler();break; //ŶеI2C䲢ʱ
+		//8Hz
+		case Task_LEDControl:LEDControlHandler();break; //ఴָʾLEDƺ
+		case Task_BattAlertTIM:BattAlertTIMHandler();break; //ؾʱ
+		case Task_OutputFaultPrefetch:OutputFaultPrefetch();break; //ύDCDC״̬ȡ
+		case Task_OutputFaultDetect:OutputFaultDetect();break; //ϼ
+		case Task_ThermalPILoop:ThermalPILoopCalc();break; //
+		case Task_SleepMgmt:SleepMgmt();break; //˯ߴ
+		case Task_BreathFSMTIM:BreathFSM_TIMHandler();break; //ģʽ״̬ʱ
+		case Task_SideKeyTIM:SideKey_TIM_Callback();break; //ఴļⶨʱ
+		case Task_BattDisplayTIM:BattDisplayTIM();break; //صʾTIM
+		case Task_DisplayErrorTIM:DisplayErrorTIMHandler();break; //ϴʾ
+		case Task_ModeFSMTIM:ModeFSMTIMHandler();break; //ģʽ״̬
+		case Task_HoldSwitchGear:HoldSwitchGearCmdHandler();break; //
+		case Task_SOSTIM:SOSTIMHandler();break; //SOSʱ
+		case Task_BeaconFSMTIM:BeaconFSM_TIMHandler();break; //űʱ
+		case Task_OutputChannelFSMTIM:OutputChannelFSM_TIMHandler();break; //ͨʱ
+		default:break;
+		}
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+
+//ʼ
+void Scheduler_Init(void)
+	{
+	unsigned char i;
+	unsigned int Now;
+	//λƫƼÿ״ͷʱ
+	Now=GetSysTickMS();
+	for(i=0;i<SchedTaskCount;i++)
+		{
+		SchedTaskRT[i].NextRelease=Now+SchedTaskTable[i].Phase;
+		SchedTaskRT[i].OverrunCount=0;
+		SchedTaskRT[i].DeadlineMissCount=0;
+		}
+	}
+
+//ѭڷ
+void Scheduler_Run(void)
+	{
+	unsigned char i;
+	unsigned int Now,Lateness;
+	SchedTaskStrDef code *Task;
+	SchedTaskRTDef xdata *RT;
+	//ͳѭȦ
+	ProfStop(Prof_LoopPeriod);
+	ProfStart(Prof_LoopPeriod);
+	//ѯ
+	for(i=0;i<SchedTaskCount;i++)
+		{
+		Task=&SchedTaskTable[i];
+		RT=&SchedTaskRT[i];
+		//񣬼Ƿ񵽴ͷʱ
+		if(Task->Period)
+			{
+			Now=GetSysTickMS();
+			Lateness=Now-RT->NextRelease;
+			if(IsNegative16(Lateness))continue; //ʱ仹û
+			//´ͷʱ
+			if(Lateness<Task->Period)RT->NextRelease+=Task->Period;
+			else
+				{
+				//Ѿһڣ׷ϣֱӰյǰʱ¶
+				if(RT->DeadlineMissCount<0xFF)RT->DeadlineMissCount++;
+				RT->NextRelease=Now+Task->Period;
+				}
+			}
+		//ִ
+		ProfStart(Task->TaskID);
+		Scheduler_RunTask(Task->TaskID);
+		#ifdef EnableTaskProfiler
+		//ʹ÷õִʱ(uS)Ƿ񳬳Ԥ
+		if(TaskProfiler_Stop(Task->TaskID)>Task->Budget&&Task->Budget&&RT->OverrunCount<0xFF)RT->OverrunCount++;
+		#endif
+		}
+	}
@@ -48,10 +48,34 @@
 #define I2C_MASTER_RECEIVE_NACK				(I2C_I2CMCR_RUN_Msk)							/*Ͷ1Byteʱ+NACK*/
 #define I2C_MASTER_RECEIVE_ACK				(I2C_I2CMCR_RUN_Msk | I2C_I2CMCR_ACK_Msk)		/*Ͷ1Byteʱ+ACK*/
 
+/*----I2Cжϴ---------------------------------------------------*/
+#define I2C_ASYNC_QUEUE_DEPTH				4		/*(Ϊ2)*/
+#define I2C_ASYNC_TIMEOUT					3		/*δĳʱʱ(mS)ʱλ߲ʧ*/
+
 
 /*****************************************************************************/
 /* Global type definitions ('typedef') */
 /*****************************************************************************/
+/*----I2C״̬-----------------------------------------------------*/
+typedef enum
+	{
+	I2C_Req_Idle,			/*Уύ*/
+	I2C_Req_Queued,			/*ύڶڵȴ*/
+	I2C_Req_Busy,			/*ϴ*/
+	I2C_Req_Done,			/*ɹ*/
+	I2C_Req_Error			/*ʧ(ӻӦߴ߳ʱ)*/
+	}I2CReqStateDef;
+
+/*----I2C(ɵ߷xdataڣǰ޸)-------------*/
+typedef struct
+	{
+	unsigned char SlaveAddr;		/*ӻַ(7bitҪдλ)*/
+	char Reg;						/*ʼĴַ*/
+	char *Data;						/*ݻ*/
+	unsigned char Len;				/*䳤(1-255)*/
+	unsigned char IsRead;			/*1=Ӵӻȡ0=ӻд*/
+	volatile I2CReqStateDef State;	/*״̬жϸ£ѯɵ֪Ƿ*/
+	}I2CReqStrDef;
 
 
 /*****************************************************************************/
@@ -63,12 +87,20 @@
 /* Global function prototypes ('extern', definition in C source) */
 /*****************************************************************************/
 /*****************************************************************************
- ** \brief	I2C_WaitACK
- **			ģʽ£дݺȴӻͨ
+ ** \brief	I2C_PostRequest
+ **			жϴύһأж
+ ** \param [in] Req: ύStateΪI2C_Req_QueuedɺΪ
+ **                  I2C_Req_DoneI2C_Req_Error
+ ** \return  bitύɹ0Ƿ1
+*****************************************************************************/
+bit I2C_PostRequest(I2CReqStrDef xdata *Req);
+/*****************************************************************************
+ ** \brief	I2C_ASyncHandler
+ **			жϴѭеһ䲢гʱ
  ** \param [in] none
- ** \return  bitͨųɹ0򷵻1
+ ** \return  none
 *****************************************************************************/
-bit I2C_WaitACK(void);
+void I2C_ASyncHandler(void);
 /*****************************************************************************
  ** \brief	I2C_DeInit
  **			λI2Cģ
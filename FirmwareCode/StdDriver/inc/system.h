@@ -84,8 +84,8 @@
 //操作TA时序时不允许被打断，因而需要关闭中断。在CPU_WAITCLOCK选择1T的模式时，在EA=0后必须加nop,选择多T时不加。
 #define		SYS_SET_SYSTEM_CLK(SystemClkDiv)	do{\
 														if(EA == 1)\
-															{\    
-																EA = 0;\		
+															{\
+																EA = 0;\
 																_nop_();\
 																TA = 0xAA;\
 																TA = 0x55;\
@@ -97,7 +97,7 @@
 																TA = 0xAA;\
 																TA = 0x55;\
 																CLKDIV = SystemClkDiv;\
-															}\				
+															}\
 														}while(0)
 
 /*****************************************************************************/
@@ -33,10 +33,19 @@
 /*	include files
 *****************************************************************************/
 #include "i2c.h"
+#include "delay.h"
 
 /****************************************************************************/
 /*	Local pre-processor symbols/macros('#define')
 ****************************************************************************/
+#define I2C_ASyncQueueMask (I2C_ASYNC_QUEUE_DEPTH-1)
+
+#if (I2C_ASYNC_QUEUE_DEPTH&I2C_ASyncQueueMask)
+	#error "I2C_ASYNC_QUEUE_DEPTH must be a power of 2!"
+#endif
+
+//ǰ(жϺѭĳʱҪʹãΪC51ĺʹúʵ)
+#define I2C_FinishCurReq(Result) do{I2CCurReq->State=Result;I2CCurReq=0;}while(0)
 
 /****************************************************************************/
 /*	Global variable definitions(declared in header file with 'extern')
@@ -45,61 +54,200 @@
 /****************************************************************************/
 /*	Local type definitions('typedef')
 ****************************************************************************/
+typedef enum
+	{
+	I2C_Phase_Reg,			/*ڷʼλӻַͼĴַ*/
+	I2C_Phase_Write,		/*ӻд*/
+	I2C_Phase_Read			/*ڴӴӻȡ*/
+	}I2CPhaseDef;
 
 /****************************************************************************/
 /*	Local variable  definitions('static')
 ****************************************************************************/
+static I2CReqStrDef xdata *xdata I2CQueue[I2C_ASYNC_QUEUE_DEPTH];	//
+static unsigned char I2CQueueHead=0;	//һҪĴ(ֻѭ޸)
+static unsigned char I2CQueueTail=0;	//һеĶλ(ֻѭ޸)
+static I2CReqStrDef xdata * volatile I2CCurReq=0;	//ڴΪ0ʾ߿
+static volatile I2CPhaseDef I2CPhase;	//ǰĽ׶
+static volatile unsigned char I2CDataIdx;	//ǰѾֽ
+static unsigned int I2CReqStamp;	//ǰʱ
+static xdata I2CReqStrDef I2CSyncReq;	//ʽAPIʹõ
+
+/****************************************************************************/
+/*	Interrupt Handler functions(Process I2C Interrupts)
+****************************************************************************/
+void I2C_IRQHandler(void) interrupt I2C_VECTOR  //I2Cشжϴ
+{
+	I2CReqStrDef xdata *Req;
+	//I2C Flag
+	I2CMSR=0x00;
+	Req=I2CCurReq;
+	if(!Req)return; //ûڽеĴ(Ѿʱȡ)
+	//ӻӦֹ߳ͣλ
+	if(I2CMSR & I2C_I2CMSR_ERROR_Msk)
+		{
+		I2CMCR=I2C_MASTER_STOP;
+		I2C_FinishCurReq(I2C_Req_Error);
+		return;
+		}
+	//մ׶μ
+	switch(I2CPhase)
+		{
+		//Ĵַѷ
+		case I2C_Phase_Reg:
+			if(Req->IsRead)
+				{
+				//ȡȴһ֮ظʼλͶַʼ
+				_nop_();
+				_nop_();
+				I2CMSA=(Req->SlaveAddr<<1)|0x01;
+				I2CPhase=I2C_Phase_Read;
+				I2CMCR=Req->Len>1?I2C_MASTER_START_RECEIVE_ACK:I2C_MASTER_START_RECEIVE_NACK;
+				}
+			else
+				{
+				//д͵һ
+				I2CPhase=I2C_Phase_Write;
+				I2CMBUF=Req->Data[0];
+				I2CDataIdx=1;
+				I2CMCR=I2C_MASTER_SEND;
+				}
+			break;
+		//һֽдϣһݻ߽ͨ
+		case I2C_Phase_Write:
+			if(I2CDataIdx<Req->Len)
+				{
+				I2CMBUF=Req->Data[I2CDataIdx++];
+				I2CMCR=I2C_MASTER_SEND;
+				}
+			else
+				{
+				I2CMCR=I2C_MASTER_STOP;
+				I2C_FinishCurReq(I2C_Req_Done);
+				}
+			break;
+		//һֽڶȡϣݺȡһݻ߽ͨ
+		case I2C_Phase_Read:
+			Req->Data[I2CDataIdx++]=I2CMBUF;
+			if(I2CDataIdx<Req->Len)I2CMCR=(Req->Len-I2CDataIdx)>1?I2C_MASTER_RECEIVE_ACK:I2C_MASTER_RECEIVE_NACK;
+			else
+				{
+				I2CMCR=I2C_MASTER_STOP;
+				I2C_FinishCurReq(I2C_Req_Done);
+				}
+			break;
+		}
+}
 
 /****************************************************************************/
 /*	Function implementation - local ('static')
 ****************************************************************************/
 /*****************************************************************************
- ** \brief	I2C_WaitACK
- **			ģʽ£дݺȴӻͨ
+ ** \brief	I2C_ResetBus
+ **			ǿƸλI2Cģ鲢Ϊģʽ
  ** \param [in] none
- ** \return  bitͨųɹ0򷵻1
+ ** \return  none
 *****************************************************************************/
-static bit I2C_WaitACK(void)
+static void I2C_ResetBus(void)
 	{
-	int i=500,j=500;
-	while(!(I2CMSR & I2C_I2CMSR_I2CMIF_Msk))
-		{
-		if(!i) //ͨųʱ
-			{
-		  I2CMCR=0x80; //ǿƸλ
-			_nop_();
-			_nop_();
-      _nop_(); //λĴ֮Ҫȴ				
-			I2C_EnableMasterMode(); //طģʽ
-			I2C_ConfigCLK(0x05); //Fsclk=Fsys/(2*10*(5+1))=400KHz		
-			return 1;	
-			}
-		//ʱ
-		j--;
-		if(j)continue;
-		i--;
-		j=500;
-		}
-	I2CMSR=0x00; //I2C Flag		
-	//
-	if(I2CMSR & I2C_I2CMSR_ERROR_Msk)
-		{
-		I2CMCR=0x80; //ǿƸλ
-		_nop_();
-		_nop_();
-    _nop_(); //λĴ֮Ҫȴ				
-		I2C_EnableMasterMode(); //طģʽ
-		I2C_ConfigCLK(0x05); //Fsclk=Fsys/(2*10*(5+1))=400KHz		
-	  return 1;
-		}
-	//˳ͨ
-	return 0;
+	I2CMCR=0x80; //ǿƸλ
+	_nop_();
+	_nop_();
+	_nop_(); //λĴ֮Ҫȴ
+	I2CMCR=0x00;
+	I2CSCR=0x00; //طģʽ
+	I2C_ConfigCLK(0x05); //Fsclk=Fsys/(2*10*(5+1))=400KHz
 	}
-	
+
+/*****************************************************************************
+ ** \brief	I2C_SyncTransfer
+ **			ͨжϴһδ䣬ȴ(ʽAPIʹ)
+ ** \param [in] SlaveAddr: 0x0~0x7f(ӻַҪдλ)
+ **             Data : ݻ
+ **             Reg : ʼĴַ
+ **             Len : ݳ
+ **             IsRead : 1=ȡ0=д
+ ** \return  bitͨųɹ0򷵻1жɣжϹر
+ **          (FlashڼEA=0)ʱֱӾܾ1÷ж
+*****************************************************************************/
+static bit I2C_SyncTransfer(unsigned char SlaveAddr,char *Data,char Reg,unsigned char Len,unsigned char IsRead)
+	{
+	//жϹرʱ޷ɣִܾ
+	if(!EA)return 1;
+	//дύ
+	I2CSyncReq.SlaveAddr=SlaveAddr;
+	I2CSyncReq.Reg=Reg;
+	I2CSyncReq.Data=Data;
+	I2CSyncReq.Len=Len;
+	I2CSyncReq.IsRead=IsRead;
+	if(I2C_PostRequest(&I2CSyncReq))return 1;
+	//ȴжɴ
+	while(I2CSyncReq.State<I2C_Req_Done)I2C_ASyncHandler();
+	//ؽ
+	return I2CSyncReq.State==I2C_Req_Done?0:1;
+	}
+
 /****************************************************************************/
 /*	Function implementation - global ('extern')
 ****************************************************************************/
-	
+/*****************************************************************************
+ ** \brief	I2C_PostRequest
+ **			жϴύһأж
+ ** \param [in] Req: ύStateΪI2C_Req_QueuedɺΪ
+ **                  I2C_Req_DoneI2C_Req_Error
+ ** \return  bitύɹ0Ƿ1
+*****************************************************************************/
+bit I2C_PostRequest(I2CReqStrDef xdata *Req)
+	{
+	//ǷϷԼǷ
+	if(!Req->Len)return 1;
+	if(Req->State==I2C_Req_Queued||Req->State==I2C_Req_Busy)return 1;
+	if(((I2CQueueTail-I2CQueueHead)&0xFF)>=I2C_ASYNC_QUEUE_DEPTH)return 1;
+	//
+	Req->State=I2C_Req_Queued;
+	I2CQueue[I2CQueueTail&I2C_ASyncQueueMask]=Req;
+	I2CQueueTail++;
+	//߿еĻʼ
+	I2C_ASyncHandler();
+	return 0;
+	}
+
+/*****************************************************************************
+ ** \brief	I2C_ASyncHandler
+ **			жϴѭеһ䲢гʱ
+ ** \param [in] none
+ ** \return  none
+*****************************************************************************/
+void I2C_ASyncHandler(void)
+	{
+	I2CReqStrDef xdata *Req;
+	//дڽУǷʱ
+	if(I2CCurReq)
+		{
+		if((GetSysTickMS()-I2CReqStamp)<I2C_ASYNC_TIMEOUT)return;
+		//䳬ʱ(߿ߴӻ쳣)λߺ󱨸ʧ
+		EIE2&=~IRQ_EIE2_I2CIE_Msk;
+		if(I2CCurReq)I2C_FinishCurReq(I2C_Req_Error);
+		I2C_ResetBus();
+		EIE2|=IRQ_EIE2_I2CIE_Msk;
+		}
+	//Ϊջһδֹͣλûзϣһ
+	if(I2CQueueHead==I2CQueueTail)return;
+	if(!(I2CMSR & I2C_I2CMSR_IDLE_Msk))return;
+	//ȡһ
+	Req=I2CQueue[I2CQueueHead&I2C_ASyncQueueMask];
+	I2CQueueHead++;
+	Req->State=I2C_Req_Busy;
+	I2CPhase=I2C_Phase_Reg;
+	I2CDataIdx=0;
+	I2CReqStamp=GetSysTickMS();
+	I2CCurReq=Req;
+	//õַʼλӻַ͵һݣĴַж
+	I2CMSA=(Req->SlaveAddr<<1)&0xFE;
+	I2CMBUF=Req->Reg;
+	I2CMCR=I2C_MASTER_START_SEND;
+	}
+
 /*****************************************************************************
  ** \brief	I2C_SendByte
  **			ģʽ£ӻдָȵ
@@ -109,28 +257,10 @@ static bit I2C_WaitACK(void)
  **             Len : ĳ
  ** \return  bitͨųɹ0򷵻1
 *****************************************************************************/
-//bit I2C_SendByte(unsigned char SlaveAddr,char *Data,char Reg,unsigned char Len)
-//	{
-//	//õַ
-//	I2CMSA=(SlaveAddr<<1)&0xFE;
-//	I2CMBUF=Reg;
-//	I2CMCR=I2C_MASTER_START_SEND; //ʼλӻַ͵һ
-//	if(I2C_WaitACK())return 1;
-//	//
-//	if(Len)do
-//		{
-//		I2CMBUF=*Data;				
-//		I2CMCR=I2C_MASTER_SEND;		//
-//		if(I2C_WaitACK())return 1;
-//		//ݷϣָһ
-//		if(Len>1)Data++;
-//		}	
-//	while(--Len);
-//	//ͨŽ
-//	I2CMCR=I2C_MASTER_STOP;
-//	while(!(I2CMSR & I2C_I2CMSR_IDLE_Msk));	//StopȴIDLEλ
-//	return 0;
-//	}
+bit I2C_SendByte(unsigned char SlaveAddr,char *Data,char Reg,unsigned char Len)
+	{
+	return I2C_SyncTransfer(SlaveAddr,Data,Reg,Len,0);
+	}
 
 /*****************************************************************************
  ** \brief	I2C_SendOneByte
@@ -142,46 +272,20 @@ static bit I2C_WaitACK(void)
 *****************************************************************************/	
 bit I2C_SendOneByte(unsigned char SlaveAddr,char Data,char Reg)	
 	{
-	//õַʼλӻַ͵һݣĴַ
-	I2CMSA=(SlaveAddr<<1)&0xFE;
-	I2CMBUF=Reg;
-	I2CMCR=I2C_MASTER_START_SEND;
-	if(I2C_WaitACK())return 1;	
-	//ʵʵ
-	I2CMBUF=Data;				
-	I2CMCR=I2C_MASTER_SEND;		//
-	if(I2C_WaitACK())return 1;
-	//ͨŽ
-	I2CMCR=I2C_MASTER_STOP;
-	while(!(I2CMSR & I2C_I2CMSR_IDLE_Msk));	//StopȴIDLEλ
-	return 0;	
+	return I2C_SyncTransfer(SlaveAddr,&Data,Reg,1,0);
 	}
 	
 /*****************************************************************************
  ** \brief	I2C_ReadOneByte
- **			ģʽ£Ӵӻжȡָȵ
+ **			ģʽ£Ӵӻжȡ1ֽڳȵ
  ** \param [in] SlaveAddr: 0x0~0x7f(ӻַҪдλ)
  **             Reg : ĿҪдĴӻַ
- **             Data : Ҫ
- **             Len : ĳ
+ **             Data : Ҫ
  ** \return  bitͨųɹ0򷵻1
 *****************************************************************************/	
 bit I2C_ReadOneByte(unsigned char SlaveAddr,char *Data,char Reg)
 	{
-	//õַͼĴ
-	I2CMSA=(SlaveAddr<<1)&0xFE;
-	I2CMBUF=Reg;
-	I2CMCR=I2C_MASTER_START_SEND; //ʼλӻַ͵һ
-	if(I2C_WaitACK())return 1;
-	//Ͷַʼ
-	I2CMSA=(SlaveAddr<<1)|0x01; //öȡַ
-	I2CMCR=I2C_MASTER_START_RECEIVE_NACK; //һֽڣNACK
-	if(I2C_WaitACK())return 1; 
-	*Data=I2CMBUF; 														 //ȴȡ󱣴һֽ
-//ͨŽ
-	I2CMCR=I2C_MASTER_STOP;
-	while(!(I2CMSR & I2C_I2CMSR_IDLE_Msk));	//StopȴIDLEλ
-	return 0;		
+	return I2C_SyncTransfer(SlaveAddr,Data,Reg,1,1);
 	}
 	
 /*****************************************************************************
@@ -193,41 +297,10 @@ bit I2C_ReadOneByte(unsigned char SlaveAddr,char *Data,char Reg)
  **             Len : ĳ
  ** \return  bitͨųɹ0򷵻1
 *****************************************************************************/
-//bit I2C_ReadByte(unsigned char SlaveAddr,char *Data,char Reg,unsigned char Len)
-//	{
-//	//鴫ĶȡǷ
-//	if(!Len)return 1;
-//	//õַͼĴ
-//	I2CMSA=(SlaveAddr<<1)&0xFE;
-//	I2CMBUF=Reg;
-//	I2CMCR=I2C_MASTER_START_SEND; //ʼλӻַ͵һ
-//	if(I2C_WaitACK())return 1;
-//	//ȡҪһ
-//  _nop_();
-//	_nop_();	
-//	//Ͷַʼ
-//	I2CMSA=(SlaveAddr<<1)|0x01; //öȡַ
-//	Len--;                      
-//	if(Len)I2CMCR=I2C_MASTER_START_RECEIVE_ACK; //Len>1,֮Ȼ1Ļ˵ҪֽڣACK
-//	else I2CMCR=I2C_MASTER_START_RECEIVE_NACK; //ֻҪ1ֽڣ֮NACK
-//	if(I2C_WaitACK())return 1; 
-//	*Data=I2CMBUF; 														 //ȴȡ󱣴һֽ
-//	//Ҫֽڶȡѭʣµ
-//	while(Len)
-//		{	
-//		Data++;           					//ָһ
-//		I2CMCR=Len>1?I2C_MASTER_RECEIVE_ACK:I2C_MASTER_RECEIVE_NACK; //I2CĲ
-//		if(I2C_WaitACK())return 1; //ȴȡ
-//		*Data=I2CMBUF; 						 //յݷĴ
-//		//һݶȡϣһ	
-//		Len--;
-//		}
-
-//	//ͨŽ
-//	I2CMCR=I2C_MASTER_STOP;
-//	while(!(I2CMSR & I2C_I2CMSR_IDLE_Msk));	//StopȴIDLEλ
-//	return 0;
-//	}	
+bit I2C_ReadByte(unsigned char SlaveAddr,char *Data,char Reg,unsigned char Len)
+	{
+	return I2C_SyncTransfer(SlaveAddr,Data,Reg,Len,1);
+	}	
 	
 /*****************************************************************************
  ** \brief	I2C_ConfigCLK
@@ -252,6 +325,9 @@ void I2C_EnableMasterMode(void)
 {
 	I2CMCR = 0x00;
 	I2CSCR  = 0x00;
+	//жϴ
+	I2CMSR = 0x00;
+	EIE2 |= IRQ_EIE2_I2CIE_Msk;
 }
 
 /*****************************************************************************
@@ -263,6 +339,15 @@ void I2C_EnableMasterMode(void)
 *****************************************************************************/
 void I2C_DeInit(void)
 	{
+	//رжϴ棬ڴŶеȫʧ
+	EIE2&=~IRQ_EIE2_I2CIE_Msk;
+	if(I2CCurReq)I2C_FinishCurReq(I2C_Req_Error);
+	while(I2CQueueHead!=I2CQueueTail)
+		{
+		I2CQueue[I2CQueueHead&I2C_ASyncQueueMask]->State=I2C_Req_Error;
+		I2CQueueHead++;
+		}
+	//λģ
 	I2CMCR=0x80;
 	_nop_();
 	_nop_();
@@ -6,19 +6,21 @@
 //ṹ
 typedef struct
 	{
-  int Systemp; //ϵͳ¶
-	float OutputVoltage; //DCDCѹ(V)
-	float BatteryVoltage; //Чڵصѹ(V)
-	float RawBattVolt; //ԭʼĵصѹ(V)
-	float MCUVDD; //ƬVDD
+  int Systemp; //ϵͳ¶()
+	int SystempX10; //ϵͳ¶(1LSB=0.1)
+	int OutputVoltage; //DCDCѹ(mV)
+	int BatteryVoltage; //Чڵصѹ(mV)
+	int RawBattVolt; //ԭʼĵصѹ(mV)
+	int MCUVDD; //ƬVDD(mV)
+	unsigned int MCUVDDRecip; //ƬVDDĵ(Q16ʽ1LSB=1/65536 V^-1)VREFͨʱ
+	unsigned int VBGADCode; //϶׼ͨԭʼADֵ(VDD=VBG*4096/ADֵ)ҪȷVDDļ
 	bool IsNTCOK; //NTCǷOK
 	}ADCResultStrDef;
 
 //ADC׼ѹ׼ͨ
-#define ADCVREF 2.00 //ADCƬڻ׼LDOĵѹ
+#define ADCVREFmV 2000 //ADCƬڻ׼LDOĵѹ(mV)
 #define ADC_INTVREFCh 31 //ADCͨƬڴ϶׼ͨ	
-#define ADCBGVREF 1.20 //ADCͨ϶׼ĵѹ	
-#define ADCWaitChannelSelTime 160 //ADCȴͨѡͨʱ	
+#define ADCBGVREFmV 1200 //ADCͨ϶׼ĵѹ(mV)
 	
 //ADCĴ궨	
 #define ADC_StartConv() ADCON0|=0x02 //ADCת
@@ -26,8 +28,12 @@ typedef struct
 #define ADC_ReadConvResult()	(ADRESL|(ADRESH<<8)) //ȡADCתļĴ
 #define ADC_EnableCmd() ADCON1|=0x80  //ʹADC IP
 #define ADC_DisableCmd() ADCON1&=0x7F  //رADC IP	
+#define ADC_SetChannelReg(Ch) do{if(Ch&0x10)ADCON0|=0x80;else ADCON0&=0x7F;ADCON1=(ADCON1&0xF0)|(Ch&0x0F);}while(0) //ADCHS[4:0]ѡͨͨ
 #define ADC_SetVREFReg(IsVDD) ADCLDO=(!IsVDD?0xA0:0x00) //û׼
 #define ADC_IsUsingIVREF() ADCLDO&0x80 //ADCǷʹƬڻ׼	
+#define ADC_EnableInt() EIE2|=IRQ_EIE2_ADCIE_Msk //ʹADCתж
+#define ADC_DisableInt() EIE2&=~IRQ_EIE2_ADCIE_Msk //رADCתж
+#define ADC_ClearIntFlag() EIF2=0xFF&(~IRQ_EIF2_ADCIF_Msk) //ADCжϱ־(д0λд1Ӱ)
 #define ADC_CheckIfChInvalid(Ch) (Ch<0||(Ch>22&&Ch<ADC_INTVREFCh)) //ͨǷϷ	
 	
 //ADC궨
@@ -41,6 +47,10 @@ typedef struct
 #define VBattLowerResK 100 //ؼѹ
 #define NTCUpperResValueK 470 //NTCֵ
 
+//ADCѹϵ(غѹ̶ʹƬ2.0V׼תmV=ADֵ*ϵ/4096)
+#define VBattScaleK (((ADCVREFmV*(VBattLowerResK+VBattUpperResK))+(VBattLowerResK/2))/VBattLowerResK)
+#define VoutScaleK (((ADCVREFmV*(VoutLowerResK+VoutUpperResK))+(VoutLowerResK/2))/VoutLowerResK)
+
 //ⲿADC
 extern ADCResultStrDef Data;
 extern bit IsNotAllowAsync; //Ƿ첽ת
@@ -49,5 +59,7 @@ extern bit IsNotAllowAsync; //
 void ADC_Init(void);
 void ADC_DeInit(void);
 void SystemTelemHandler(void);
+unsigned char ADC_GetChSeq(char Ch);
+void ADC_SetVOUTBoost(bit IsEnable);
 
 #endif
\ No newline at end of file
@@ -21,28 +21,40 @@ void PWM_DeInit(void);
 /* Extern Functions definition - PWM Controller Logic Handler */
 /************************************************************************************/
 void PWM_OutputCtrlHandler(void);
+bit PWM_IsCommitDone(void); //PWMֵǷѾЧ
 
 /************************************************************************************/
 /* Extern Flags and Variable definition */
 /************************************************************************************/
-extern xdata float PWMDuty;									//·׼PWMDAC
+extern xdata unsigned int PWMDuty;					//·׼PWMDAC(PWM0Ƚϼֵ0-PWMStepConstant)
 extern xdata unsigned int PreChargeDACDuty; //ԤPWMDAC
-extern bit IsNeedToUploadPWM; 							//ָbit,λbitԸPWMĴӦ	
+extern bit IsNeedToUploadPWM; 							//ָbit,λbitԸPWMĴӦ(µֵȣҪȴһӦ)	
+#ifdef EnablePWMDACDither
+extern xdata unsigned char PWMDutyFrac;     //·׼PWMDACռձȵС(LSB=1/2^PWMDACDitherBitsPWM)
+#endif
 
 /************************************************************************************/
 /* Extern paramter definition */
 /************************************************************************************/
 #define SysFreq 48000000 //ϵͳʱƵ(λHz)
+#define PWMFreq 4000 //IDACPWMƵ(λHz)	
 #define CVPWMDACFreq 8000 //CVѹעPWMDACƵ(λHz)
+//#define EnablePWMDACDither //ǷúPWMDACһsigma-delta(PWMжлLSBСλķֱ)
+#define PWMDACDitherBits 4 //ṩĶСλ(Чֱ=PWMStepConstant*2^PWMDACDitherBits)
 
 
 /************************************************************************************/
 /* Auto Calculated Parameters */
 /************************************************************************************/
+#define PWMStepConstant ((SysFreq/PWMFreq)-1) 			//PWMԶ
 #define CVPWMDACFullScale ((SysFreq/CVPWMDACFreq)-1)
 #define CVPWMDACPMSB ((CVPWMDACFullScale>>8)&0xFF)
 #define CVPWMDACPLSB (CVPWMDACFullScale&0xFF)
 
+#if (PWMDACDitherBits < 1 | PWMDACDitherBits > 7)
+	#error "PWMDACDitherBits must be within 1 to 7 to fit the 8-bit sigma-delta accumulator!"
+#endif
+
 #endif /* _PWM_ */
 
 /*********************************  End Of File  ************************************/
@@ -0,0 +1,27 @@
+#ifndef _SC8721_
+#define _SC8721_
+
+#include "SC8721_REG.h"
+
+//궨
+#define SC8721StatusCacheTime 1 //״̬Ĵˢʱ(mS)泬ʱں̨ύһµĶȡ
+#define SC8721StatusMaxAge 5 //״̬ĴЧ(mSύȡʼ)Ϊûн
+
+//״̬ȡ
+typedef enum
+	{
+	SC8721_Status_OK, //״̬Ч
+	SC8721_Status_Pending, //״̬ں̨ȡʱûн
+	SC8721_Status_CommErr //ͨʧ
+	}SC8721StatusResultDef;
+
+//(0ʾɹ1ʾͨʧܻ߲)
+void SC8721_InvalidateCache(void);
+bit SC8721_GetShadow(char Reg,char *Data,unsigned char Len);
+bit SC8721_WriteReg(char Reg,char *Data,unsigned char Len);
+
+//ȡ״̬Ĵ
+SC8721StatusResultDef SC8721_ReadStatus(char *Status);
+void SC8721_PrefetchStatus(void);
+
+#endif
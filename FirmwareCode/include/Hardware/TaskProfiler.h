@@ -0,0 +1,62 @@
+#ifndef _TaskProfiler_
+#define _TaskProfiler_
+
+#include "TaskScheduler.h"
+
+//궨
+//#define EnableTaskProfiler //Ƿѭִʱ(úռTimer1)
+
+//ͳƱIDÿӦһһͳѭȦ
+#define Prof_LoopPeriod SchedTaskCount
+#define ProfTaskCount (SchedTaskCount+1)
+
+//ͳƽ(1LSB=1uS65535uS󱥺)
+typedef struct
+	{
+	unsigned int Min; //ִʱ
+	unsigned int Max; //ִʱ(WCET)
+	unsigned int Mean; //һͳƴڵƽִʱ
+	unsigned long Sum; //ƽֵۼ
+	unsigned char SampleCount; //ǰͳƴڵĲ
+	}ProfTaskStrDef;
+
+//λӳͳƽ(1LSB=1mSͨ뿪ʼʱ)
+typedef struct
+	{
+	unsigned int LightOnTime; //һLDʼ(ʼ̧ѹ)ʱ
+	unsigned int TargetTime; //һﵽλĿֵʱ
+	unsigned int MaxTargetTime; //ﵽλĿֵʱ
+	unsigned char Count; //ͳƵ(ͼ)
+	}ProfStartupStrDef;
+
+#ifdef EnableTaskProfiler
+
+#include "ModeControl.h"
+
+//ÿλӳͳƽյλModeIdxPCϴӵʼʱͬ
+//Tools/HostSim/Scenarios/Startup.txtԺʵֵԱ
+extern xdata ProfStartupStrDef ProfStartup[ModeTotalDepth];
+
+//ͳƽڵֱӹ۲ProfTableɵÿͳƽ
+extern xdata ProfTaskStrDef ProfTable[ProfTaskCount];
+
+//
+void TaskProfiler_Init(void);
+void TaskProfiler_Reset(void);
+void TaskProfiler_Start(unsigned char Task);
+unsigned int TaskProfiler_Stop(unsigned char Task); //رεִʱ(uS)
+
+//׮
+#define ProfStart(Task) TaskProfiler_Start(Task)
+#define ProfStop(Task) TaskProfiler_Stop(Task)
+
+#else
+
+//رգ׮չΪ
+#define TaskProfiler_Init()
+#define ProfStart(Task)
+#define ProfStop(Task)
+
+#endif
+
+#endif
@@ -10,6 +10,9 @@
 extern volatile bit SysHFBitFlag;
 #define DisableSysHBTIM() T2CON=0x00;IE&=~0x20; //ϵͳʱֱӹرնʱж
 
+//ϵͳʱ(1mS)
+unsigned int GetSysTickMS(void);
+
 //ʱǷ
 #ifdef EnableHBCheck
 void CheckIfHBTIMIsReady(void);
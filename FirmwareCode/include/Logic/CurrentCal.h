@@ -0,0 +1,60 @@
+#ifndef _CurrentCal_
+#define _CurrentCal_
+
+#include "LDProfile.h"
+
+//궨
+//#define EnableFactoryCurrentCal //ùУ׼(ػ߻+)ֻڹУ׼ʹõĹ̼̼ر
+#define CalPointCount 7 //У׼У׼
+#define CalGainUnity 1000 //У׼ϵĵλΪ0.1%1000ʾ
+#define CalGainMin 950
+#define CalGainMax 1050 //У׼ϵΧ(95%-105%)ΧУ׼Ϊ
+#define CalMaxCurrentGain 1030 //У׼͸PWMDACĵLD޵(0.1%)У׼ζᳬ
+#define CalFineStep 1 //˫У׼ϵĲ(0.1%)
+#define CalCoarseStep 10 //ĻУ׼ϵĲ(1%)
+
+//У׼õ(mA)һУ׼ΪLDļ޵λ߱ʹͬУ׼
+#define CalSetPointList {50,125,250,500,1000,2000,LDICCMAX}
+
+//У׼ĵ(mA)
+#define CalCurrentCeiling (int)(((long)LDICCMAX*CalMaxCurrentGain)/CalGainUnity)
+
+#if (CalMaxCurrentGain < CalGainUnity)
+	//޲ܵLDļ޵λ޷ﵽõ
+	#error "Calibrated current ceiling must not be lower than the LD's maximum current!"
+#endif
+
+#if (LDICCMAX <= 2000)
+	//һУ׼ǰһУ׼
+	#error "Current calibration set points require the LD's maximum current to be higher than 2000mA!"
+#endif
+
+//У׼ʵ͸PWMDACĵ=õ*У׼ϵ(У׼֮Բֵ)
+typedef struct
+	{
+	int Gain[CalPointCount]; //ÿУ׼У׼ϵ(0.1%)
+	}CalTableDef;
+
+//У׼̵״̬
+typedef enum
+	{
+	CurrentCal_InAct, //У׼δ
+	CurrentCal_Trim //ڵǰУ׼
+	}CurrentCalFSMDef;
+
+//ⲿ
+extern xdata CurrentCalFSMDef CalFSMState;
+
+//
+void CurrentCal_Init(void); //ȡУ׼
+int CurrentCal_Apply(int Current); //õӦУ׼
+bit CurrentCal_IsTableUpdated(void); //У׼Ƿ޸Ĺ(ȡԶ)
+
+//У׼
+#ifdef EnableFactoryCurrentCal
+void CurrentCal_Trigger(void); //У׼
+#endif
+void CurrentCal_FSM(char ClickCount); //У׼̵İ
+int CurrentCal_QueryCurrent(void); //ȡУ׼Ҫĵ
+
+#endif
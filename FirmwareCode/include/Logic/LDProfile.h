@@ -0,0 +1,72 @@
+#ifndef _LDProfile_
+#define _LDProfile_
+
+/************************************************
+LDļѡÿּܵļ޵λ
+¿ص¶ȡƫֵ͵ֵͨѹڸԵļ
+ڣʱݹĿ(Target)涨ĺѡһ
+ʹͬһԴɲͬLDĹ̼LDʱһ
+еļյʵʵİȫ޸ģȻڹ
+ӶӦĿ꼴ɡ
+
+𶯵ĵʰվɰ̼ÿ1000/
+áɰÿһҪȴPWMװأҪѭ
+ѭﻹADCͨлȴ͸Duty_Calc
+ʵʵĲûвֻȷһPWM
+(250uS)ﱣصذÿһ㣬ɰһ
+ѭ0.5mS(48MHz¸ADC0.1mS)
+µʲȾɰ졣ʵϲɰĲ
+ҪʵֵЩʡ
+************************************************/
+
+//ǷֻѡһLD
+#if ((defined(LD_NDB7A75)+defined(LD_NDG7H75)+defined(LD_NUGM06T))>1)
+	#error "More than one LD profile was selected,check the Define field of the build target!"
+#endif
+
+//Ŀĺ궨ѡLDļ
+#if defined(LD_NDB7A75)
+	#include "LDProfile_NDB7A75.h"
+#elif defined(LD_NDG7H75)
+	#include "LDProfile_NDG7H75.h"
+#elif defined(LD_NUGM06T)
+	#include "LDProfile_NUGM06T.h"
+#else
+	#error "No LD profile was selected,please define LD_NDB7A75,LD_NDG7H75 or LD_NUGM06T in the build target!"
+#endif
+
+//ļĵǷ񳬳LDļ޵
+#if (LDRampCurrent > LDICCMAX)||(LDHighCurrent > LDICCMAX)||(LDSOSCurrent > LDICCMAX)
+	#error "Mode current in the LD profile exceeds the LD's maximum current!"
+#endif
+
+#if (LDBreathCurrent > LDICCMAX)||(LDBeaconCurrent > LDICCMAX)||(LDSOSNoProtCurrent > LDICCMAX)
+	#error "Mode current in the LD profile exceeds the LD's maximum current!"
+#endif
+
+#if (LDExtremeLowCurrent > LDLowCurrent)||(LDLowCurrent > LDMidCurrent)||(LDMidCurrent > LDMHighCurrent)||(LDMHighCurrent > LDHighCurrent)
+	#error "Stepped mode currents in the LD profile must be in ascending order!"
+#endif
+
+#if (LDRampMinCurrent >= LDRampCurrent)||(LDBurnIdleCurrent >= LDICCMAX)||(LDBreathMinCurrent >= LDBreathCurrent)
+	#error "Minimum current in the LD profile must be lower than the maximum current!"
+#endif
+
+//¿ز
+#if (LDStartUpCurrent >= LDSlowRampStartCurrent)||(LDSlowRampStartCurrent > LDICCMAX)
+	#error "Invalid startup current in the LD profile!"
+#endif
+
+#if (LDDefaultSlewRate < 1)||(LDRampSlewRate < 1)||(LDSOSSlewRate < 1)||(LDBeaconSlewRate < 1)||(LDBurnSlewRate < 1)
+	#error "Ramp slew rates in the LD profile must be at least 1mA/S!"
+#endif
+
+#if (LDMinumumILED > LDILEDConstantFoldback)||(LDILEDConstantFoldback > LDILEDConstant)||(LDTurboFoldbackCurrent >= LDICCMAX)
+	#error "Invalid thermal current setting in the LD profile!"
+#endif
+
+#if (LDReleaseTemperature >= LDConstantTemperature)||(LDConstantTemperature >= LDForceDisableTurboTemp)||(LDForceDisableTurboTemp >= LDForceOffTemp)
+	#error "Temperatures in the LD profile must be in ascending order: Release < Constant < DisableTurbo < ForceOff!"
+#endif
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef _LDProfile_NDG7H75_
+#define _LDProfile_NDG7H75_
+
+/************************************************
+NDG7H75(520nm̹)LDļ޵2.3A
+LDļ޵ϵͣű൲λĵӦ͵2A
+ע⣺ļĿǰֻм޵ű൲λͼ
+ոLDĹ޸Ĺ(ֵͨ/ѹ
+ƫֵ൲λ¿ص¶)ʱ
+NUGM06TֵΪռλҪʹøLDʵ滻
+************************************************/
+
+//LD
+#define LDICCMAX 2300 //ܵļ(mA)
+#define LDThresholdVolt 3900 //ܿʼֵͨѹ(mV)DCDCԵѹڸֵ
+#define LDConstantVolt 4350 //(LDILEDConstant)LDĹѹ(mV)ֵѹԼ0.6Ķ̬
+#define LDCurrentOffset 990 //ߵͨµĵƫֵ(λ0.1%)
+
+//λ(mA)ģʽʹü޵
+#define LDRampCurrent 2000 //޼
+#define LDRampMinCurrent 125 //޼С
+#define LDExtremeLowCurrent 125 //
+#define LDLowCurrent 250 //
+#define LDMidCurrent 500 //
+#define LDMHighCurrent 1000 //и
+#define LDHighCurrent 2000 //
+#define LDSOSCurrent 1400 //SOS
+#define LDFocusCurrent 50 //Խλ
+#define LDBurnIdleCurrent 150 //ģʽɿʱĵ
+#define LDBreathCurrent 2000 //ű
+#define LDBreathMinCurrent 20 //ű͵
+#define LDBeaconCurrent 2000 //Ъű
+#define LDSOSNoProtCurrent 700 //ޱSOS
+
+//(mA)
+#define LDStartUpCurrent 35 //DCDCʼֵ
+#define LDSlowRampStartCurrent 300 //ʱʼ
+
+//𶯵(mA/S)ȡֵLDProfile.h
+#define LDDefaultSlewRate 1000 //Ĭϻӵ(ɰÿ+1mA)
+#define LDRampSlewRate 2000 //޼ʹ2ٶ(ɰÿ+2mA)
+#define LDSOSSlewRate 400000 //SOSģʽ¿ӵβӰж(ɰÿ+400mA)
+#define LDBeaconSlewRate 1000000 //űģʽ(ɰÿ+1000mA)
+#define LDBurnSlewRate 50000 //ģʽʱѸӵЧ(ɰÿ+50mA)
+
+//¿ز(mA)
+#define LDMinumumILED 390 //ϵͳܴﵽ͵
+#define LDILEDConstant 750 //ϵͳ¿صĳ
+#define LDILEDConstantFoldback 500 //ڽӽ¶ȼʱĽϵͳڵĳ
+#define LDTurboFoldbackCurrent 2150 //ģʽֵʱ¶ȳĿѸٽ͵
+
+//¶Ȳ()LDĽ͹Ч¶½ĳ̶ȾЩ¶
+#define LDForceOffTemp 65 //ȹػ¶
+#define LDForceDisableTurboTemp 50 //¶޷뼫
+#define LDConstantTemperature 45 //Ǽλ¿άֵ¶
+#define LDReleaseTemperature 40 //¿ͷŵ¶
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "stdbool.h"
 #include "FastOp.h"
+#include "LDProfile.h"
 
 typedef enum
 	{
@@ -59,11 +60,13 @@ typedef struct
 	//λл
   ModeIdxDef ModeTargetWhenH;
 	ModeIdxDef ModeTargetWhen1H;	 //ģʽλлã͵+лĿ굲λ
+	//
+	unsigned long RampSlewRate;    //ʱ(mA/S)վʱ㣬ѭٶ޹ءֵLDļ
 	}ModeStrDef; 
 
 //ⲿ
 extern xdata unsigned char DisplayLockedTIM; //ʾʱ
-extern ModeStrDef *CurrentMode; //ǰģʽṹ
+extern ModeStrDef code *CurrentMode; //ǰģʽṹ
 extern xdata ModeIdxDef LastMode; //һλ	
 extern xdata SysConfigDef SysCfg; //޼	
 extern bit IsSystemLocked;		//ϵͳǷ
@@ -77,15 +80,15 @@ extern bit IsSystemEnteredAutoLocked; //ϵͳ
 ޸Ļ	
 ************************************************/	
 
-//Զ
-#define TurboLDICCMAX 3000 //ܵļ(mA)
+//Զ(ɱĿѡLDļ)
+#define TurboLDICCMAX LDICCMAX //ܵļ(mA)
 	
 //궨
 #define QueryCurrentGearILED() CurrentMode->Current //ȡǰλĵ
 #define ModeTotalDepth 15 //ϵͳһмλ			
 	
 //
-ModeStrDef *FindTargetMode(ModeIdxDef Mode,bool *IsResultOK);//ָIndexindexҵĿģʽṹ岢ָ
+ModeStrDef code *FindTargetMode(ModeIdxDef Mode,bool *IsResultOK);//ָIndexindexҵĿģʽṹ岢ָ
 void ModeFSMTIMHandler(void);//λ״̬ʱ
 void ModeSwitchFSM();//λ״̬
 void SwitchToGear(ModeIdxDef TargetMode);//ָλ
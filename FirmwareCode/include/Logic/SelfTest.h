@@ -26,6 +26,7 @@ void ReportError(FaultCodeDef Code); //
 void ClearError(void); //
 void DisplayErrorTIMHandler(void); //ʾʱõļʱ
 void DisplayErrorIDHandler(void); //ݴIDʾĴ
+void OutputFaultPrefetch(void); //ϼǰύDCDC״̬ȡ
 void OutputFaultDetect(void); //ϼ⺯	
 void MCUVDDFaultDetect(void); //MCUVDDϼ
 bit IsErrorFatal(void);	//ѯǷ
@@ -1,8 +1,32 @@
 #ifndef _TC_
 #define _TC_
 
+#include "stdbool.h"
+
+//궨
+//#define EnableModelThermalCtrl //ʹûģ͵¿شԭеPI(ע͵ʹPI߶Ա)
+//#define EnableTurboEnergyBudget //ʹԤģʽ(ע͵ʹù̶¶ֵƼ)
+
+#ifdef EnableModelThermalCtrl
+//߱ʶõһģͣڵֱӹ۲ThermalModelɵõǵɢ
+typedef struct
+	{
+	long InvGain; //λ(0.1W)һ(0.1)ĵ(Q8)(J/K)=InvGain*()/256
+	long Conductance; //ǶԻȵ(Q8λW/K)
+	int SustainCurrent; //ģԤں¶¿Գάֵĵ(mA)
+	unsigned char SampleCount; //ɵЧ(ͼ)
+	bool IsValid; //ģͲǷ
+	}ThermalModelStrDef;
+
+extern xdata ThermalModelStrDef ThermalModel;
+#endif
+
+#ifdef EnableTurboEnergyBudget
+extern xdata long TurboBudget; //ʣԤ(mJ)ڵ۲켴ɵõάֶ
+#endif
+
 //
-int ThermalILIMCalc(void); //¿ģ
+int ThermalILIMCalc(void); //ȡ¿ģĵ(ֵ¿״̬λ仯ʱ㲢)
 void ThermalMgmtProcess(void); //¿ع
 void RecalcPILoop(int LastCurrent); //ʱ¼PI·
 void ThermalPILoopCalc(void); //¿PI·ļ
@@ -11,5 +35,6 @@ void ThermalPILoopCalc(void); //
 extern bit IsPauseStepDownCalc; //Ƿͣ¿صļ̣bit=1ǿƸλ¿ϵͳǻͣ㣩
 extern bit IsDisableTurbo; //رռ
 extern bit IsForceLeaveTurbo; //ǿ˳
+extern xdata unsigned char ThermalILIMSeq; //¿ֵı仯ֵÿ仯һμ1˵ֵûб仯
 
 #endif
@@ -1,37 +1,62 @@
 #ifndef _ADAsync_
 #define _ADAsync_
 
-//ADC첽öֵ
-typedef enum
-	{
-	ADC_SubmitQueue, //ύת	
-  ADC_SubmitChFromQueue, //ADCת߳ύڵ
-	ADC_WaitMissionDone, //ȴ
-	ADC_ConvertComplete //ת	
-	}ADCAsyncStateDef; //ADC첽ת״̬
+//ADCж
+#define ADCChannelCount 4 //ADCתͨ	
+#define ADCMaxAverageCount 16 //ADCÿͨƽ(16bitۼ)	
+#define ADCRingDepth 4 //ÿͨλ(Ϊ2η)
+#define ADCChSwitchDiscard 1 //л֮ͨת(ȴݽ)
+#define ADCRefSwitchDiscard 3 //л׼֮ת(ȴ׼LDO)
+#define ADCBoostMaxDefer 16 //VOUTģʽºVOUT׼ͬͨƳٵﵽһΣ¶ȺVDDʱ䲻
 
+//ADCжÿͨת
 typedef struct
 	{
-	long avgbuf;
-	int Count;
-	char Ch;
-	bool IsMissionProcessing; //Ƿڴ
-	}ADCConvertTemp;
+	unsigned int AccBuf; //ƽۼ(4095*ADCMaxAverageCount16bit)
+	unsigned char Count; //ǰۼӵĴ
+	unsigned char Seq; //ţÿһƽ+1ѭͨȽжǷ
+	unsigned char SkipCnt; //´תҪ
+	unsigned char DeferCnt; //VOUTģʽѾƳٵĴ
+	unsigned int Ring[ADCRingDepth]; //תĻλµĽλRing[Seq&(ADCRingDepth-1)]
+	}ADCChannelStrDef;
 
-//ADC첽
-#define ADCConvertQueueDepth 4 //ADCת	
-#define ADCAverageCount 10 //ADCÿתƽ	
+//ADCͨĵͨ
+typedef struct
+	{
+	char Ch; //ADCͨ
+	unsigned char IsUsingVDDRef; //ǷʹMCUVDDΪ׼(0=ʹƬ2.0Vܻ׼)
+	unsigned char AvgDepth; //ÿתƽ
+	unsigned char Interval; //תÿֵȲתһ(1=ÿֶת)
+	}ADCChCfgDef;	
 
-//ADCתĶ
+//ADCתͨãʹͬ׼ͨҪڷãʹһֵֻлλ׼
 #include "Pindefs.h"
 #include "ADCCfg.h"	
 	
-code char ADCChQueue[ADCConvertQueueDepth]=
+code ADCChCfgDef ADCChCfg[ADCChannelCount]=
 	{
-	ADC_INTVREFCh, //תVREF
-	NTCInputAIN,//Ȼת¶	
-	VBATInputAIN, //صѹ
-	VOUTFBAIN //תѹ
+	//ADCͨ        VDD׼   ƽ   ת
+	{ADC_INTVREFCh,  1,        8,         4}, //VREFMCUVDDֻỺ仯
+	{NTCInputAIN,    1,        4,         16},//¶ȣNTCΪλ仯
+	{VBATInputAIN,   0,        8,         2}, //صѹ
+	{VOUTFBAIN,      0,        4,         1}  //ѹ͸ʶʱҪ뼶Ӧÿֶת
 	};
 	
+//ü
+#if (ADCRingDepth&(ADCRingDepth-1))!=0
+#error "ADCRingDepth must be a power of two!"
+#endif
+
+#if (4095UL*ADCMaxAverageCount)>65535UL
+#error "ADCMaxAverageCount is too large for the 16bit accumulator!"
+#endif
+
+#if ADCChSwitchDiscard>ADCRefSwitchDiscard
+#error "Reference switch must discard at least as many samples as a channel switch!"
+#endif
+
+#if ADCBoostMaxDefer>255
+#error "ADCBoostMaxDefer must fit in an unsigned char!"
+#endif
+	
 #endif
\ No newline at end of file
@@ -2,7 +2,7 @@
 #define _OCH_
 
 //输出欠压参数配置
-#define BoostChipUVLO 2.6f     //驱动内部boost芯片所能维持运行的最小UVLO电压(V)，低于此电压后系统强制关闭
+#define BoostChipUVLO 2600     //驱动内部boost芯片所能维持运行的最小UVLO电压(mV)，低于此电压后系统强制关闭
 
 //外部参考
 extern xdata int Current; //电流值
@@ -17,6 +17,7 @@ typedef enum
 	DCDC_ThermalShutDown, //触发内部过温关闭
 	DCDC_Warn_CBCOCP,     //触发芯片内部限流
 	DCDC_StatuUnknown,   //DCDC状态未知
+	DCDC_StatuPending,   //DCDC状态正在后台读取，暂时没有结果
 	}
 DCDCStateDef;
 
@@ -28,6 +29,7 @@ void OutputChannelFSM_TIMHandler(void);
 
 //获取系统状态的函数
 DCDCStateDef OutputChannel_GetDCDCState(void);
+void OutputChannel_PrefetchDCDCState(void);
 bit GetIfOutputEnabled(void);
 
 #endif
@@ -1,9 +1,15 @@
 #ifndef _SysCfg_
 #define _SysCfg_
 
+#include "CurrentCal.h"
+
 //	
 void ReadSysConfig(void);
 void SaveSysConfig(bit IsForceSave);	
 void LoadMinimumRampCurrentToRAM(void);	
+
+//У׼Ĵ洢
+bit ReadCalTable(CalTableDef *Table);
+void SaveCalTable(CalTableDef *Table);
 	
 #endif
@@ -0,0 +1,60 @@
+#ifndef _TaskSched_
+#define _TaskSched_
+
+//ϵͳID(մ˳ѯ)
+typedef enum
+	{
+	//ʵʱ(ÿȦִл1kHz)
+	Task_SystemTelem, //ADCң⴦
+	Task_BatteryTelem, //ң⴦
+	Task_SideKeyLogic, //ఴ߼
+	Task_ThermalMgmt, //¶ȹ
+	Task_ModeSwitchFSM, //λ״̬
+	Task_OutputChannelCalc, //ͨ
+	Task_PWMOutputCtrl, //PWM
+	Task_I2CASync, //I2CжϴĶкͳʱ
+	//8HzԭTask0飬Ƚϴ
+	Task_LEDControl, //ఴָʾLED
+	Task_BattAlertTIM, //ؾʱ
+	Task_OutputFaultPrefetch, //ϼǰύDCDC״̬ȡ
+	Task_OutputFaultDetect, //ϼ
+	Task_ThermalPILoop, //¿PI·
+	Task_SleepMgmt, //˯ߴ
+	Task_BreathFSMTIM, //ģʽ״̬ʱ
+	//8HzԭTask1飬ȽСļʱ
+	Task_SideKeyTIM, //ఴļⶨʱ
+	Task_BattDisplayTIM, //صʾ
+	Task_DisplayErrorTIM, //ϴʾ
+	Task_ModeFSMTIM, //ģʽ״̬ʱ
+	Task_HoldSwitchGear, //
+	Task_SOSTIM, //SOSʱ
+	Task_BeaconFSMTIM, //űʱ
+	Task_OutputChannelFSMTIM, //ͨʱ
+	SchedTaskCount //
+	}SchedTaskIdxDef;
+
+//ṹ
+typedef struct
+	{
+	SchedTaskIdxDef TaskID; //ID
+	unsigned int Period; //(mS)0ʾÿȦִ
+	unsigned int Phase; //λƫ(mS)ڰͬĽ
+	unsigned int Budget; //ִʱԤ(uS)0ʾ(ֻEnableTaskProfilerʱŻ)
+	}SchedTaskStrDef;
+
+//״̬ṹ
+typedef struct
+	{
+	unsigned int NextRelease; //´ͷŵʱ(mS)
+	unsigned char OverrunCount; //ִʱ䳬ԤĴ(ͼҪEnableTaskProfiler)
+	unsigned char DeadlineMissCount; //ڵĴ(ͼ)
+	}SchedTaskRTDef;
+
+//״̬ڵڹ۲쳬ʱ
+extern xdata SchedTaskRTDef SchedTaskRT[SchedTaskCount];
+
+//
+void Scheduler_Init(void);
+void Scheduler_Run(void);
+
+#endif
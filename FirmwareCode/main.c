@@ -19,24 +19,11 @@
 #include "PWMCfg.h"
 #include "LVDCtrl.h"
 #include "SysReset.h"
-#include "LowVoltProt.h"
-#include "TempControl.h"
+#include "ModeControl.h"
 #include "BattDisplay.h"
 #include "OutputChannel.h"
-#include "SelfTest.h"
-#include "SOS.h"
-#include "BreathMode.h"
-#include "Beacon.h"
-
-/****************************************************************************/
-/*	Local variable  definitions('static')
-****************************************************************************/
-bit TaskSel=0;  //ѡϵͳ
-
-/****************************************************************************/
-/*	External Function prototypes definition
-****************************************************************************/
-void SleepMgmt(void);
+#include "TaskScheduler.h"
+#include "TaskProfiler.h"
 
 //
 void main(void)
@@ -54,49 +41,8 @@ void main(void)
 	ModeFSMInit(); //ʼģʽ״̬
   DisplayVBattAtStart(1); //ʾ״
 	EnableADCAsync(); //ADC첽ģʽߴٶ
-	//ѭ	
-  while(1)
-		{
-	  //ʵʱ
-		SystemTelemHandler();
-		BatteryTelemHandler(); //ȡADC͵Ϣ	
-		SideKey_LogicHandler(); //ఴ
-		ThermalMgmtProcess(); //¶ȹ
-		ModeSwitchFSM(); //λ״̬
-		OutputChannel_Calc();  //ͨ
-		PWM_OutputCtrlHandler(); //PWM	
-		//8Hzʱ
-		if(!SysHFBitFlag)continue; //ʱû
-			
-		//Task0Ƚϴ
-    if(!TaskSel)
-			{
-			LEDControlHandler();//ఴָʾLEDƺ	
-			BattAlertTIMHandler(); //ؾʱ
-			OutputFaultDetect(); //ϼ
-			ThermalPILoopCalc(); 				//	
-			SleepMgmt(); //˯ߴ
-			BreathFSM_TIMHandler(); //ģʽ״̬ʱ
-			
-			//ѡзתһ
-			TaskSel=1;
-		  }			
-		//Task1ȽСļʱ
-		else
-			{	
-			SideKey_TIM_Callback();//ఴļⶨʱ		
-			BattDisplayTIM(); //صʾTIM
-			DisplayErrorTIMHandler(); //ϴʾ
-			ModeFSMTIMHandler(); //ģʽ״̬
-			HoldSwitchGearCmdHandler(); //
-			SOSTIMHandler(); //SOSʱ
-			BeaconFSM_TIMHandler(); //űʱ
-			OutputChannelFSM_TIMHandler(); //ͨʱ	
-				
-			//ѡзתһ
-			TaskSel=0;
-			}
-		//ϣflag
-		SysHFBitFlag=0;	
-		}
+	TaskProfiler_Init(); //ִʱ
+	Scheduler_Init(); //ʼ
+	//ѭɵͷŸ
+  while(1)Scheduler_Run();
 	}
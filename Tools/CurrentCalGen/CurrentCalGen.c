@@ -0,0 +1,208 @@
+/****************************************************************************/
+/** \file CurrentCalGen.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļPCϵĵУ׼㹤ߣÿУ׼ʵ
+У׼ϵ߻ఴУ׼ÿУ׼Ҫİ
+ͬʱɿֱ¼FlashУ׼Intel HEX
+
+뷽gcc -O2 -o CurrentCalGen CurrentCalGen.c -lm
+ʹ÷CurrentCalGen -imax <mA> [ѡ] <ʵ1> ... <ʵ7> > CalTable.hex
+	-imax <mA>           LDļڵļ޵LDICCMAXҲһУ׼õ
+	-gain <g1,...,g7>    ʱʹõУ׼ϵ(0.1%)ĬȫΪ1000(δУ׼)
+	-base <ַ>         У׼FlashڵʼַĬ0x200͹̼һ
+ʵΪУ׼ÿУ׼ʱĶ(mA)У׼˳д
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+//²͹̼CurrentCal.hԼSysConfig.cһ
+#define CalPointCount 7 //У׼У׼
+#define CalGainUnity 1000 //У׼ϵĵλΪ0.1%1000ʾ
+#define CalGainMin 950
+#define CalGainMax 1050 //У׼ϵΧ(95%-105%)
+#define CalFineStep 1 //˫У׼ϵĲ(0.1%)
+#define CalCoarseStep 10 //ĻУ׼ϵĲ(1%)
+#define CalMaxCurrentGain 1030 //У׼ĵLD޵(0.1%)̼ѳĲֽص
+#define CalTableMagic 0x35 //У׼ıʶ
+#define CalTableBase 0x200 //У׼FlashڵĬʼַ
+#define CalImageSize (1+(CalPointCount*2)+1) //У׼ֽ(ʶ+У׼ϵ+CRC8)
+
+/****************************************************************************/
+/*	Local type definitions('typedef')
+****************************************************************************/
+typedef struct
+	{
+	int IMax; //LDļ޵(mA)
+	int Base; //У׼ʼַ
+	int OldGain[CalPointCount]; //ʱʹõУ׼ϵ
+	double Measured[CalPointCount]; //ÿУ׼ʵ(mA)
+	}GenCfgDef;
+
+/****************************************************************************/
+/*	Local variable  definitions('static')
+****************************************************************************/
+static int SetPoint[CalPointCount]={50,125,250,500,1000,2000,0}; //У׼õһΪLDļ޵
+
+/****************************************************************************/
+/*	Function implementation - local('static')
+****************************************************************************/
+
+//CRC-8㣬͹̼SysConfig.cڵ㷨һ
+static unsigned char PEC8Check(const unsigned char *DIN,int Len)
+	{
+	unsigned char crcbuf=0xFF;
+	int i;
+	while(Len--)
+		{
+		crcbuf^=*DIN++;
+		for(i=0;i<8;i++)
+			{
+			if(crcbuf&0x80)crcbuf=(crcbuf<<1)^0x07;
+			else crcbuf<<=1;
+			}
+		}
+	return crcbuf;
+	}
+
+//һIntel HEX¼
+static void EmitHexRecord(int Addr,int Type,const unsigned char *Data,int Len)
+	{
+	int i;
+	unsigned char Sum;
+	printf(":%02X%04X%02X",Len,Addr&0xFFFF,Type);
+	Sum=(unsigned char)(Len+((Addr>>8)&0xFF)+(Addr&0xFF)+Type);
+	for(i=0;i<Len;i++)
+		{
+		printf("%02X",Data[i]);
+		Sum+=Data[i];
+		}
+	printf("%02X\n",(unsigned char)(0x100-Sum));
+	}
+
+//У׼ϵҪİ
+static void PrintKeySequence(int Delta)
+	{
+	int Coarse,Fine;
+	if(!Delta)
+		{
+		fprintf(stderr,"no change");
+		return;
+		}
+	Coarse=abs(Delta)/CalCoarseStep;
+	Fine=(abs(Delta)%CalCoarseStep)/CalFineStep;
+	if(Coarse)fprintf(stderr,"%dx %s%s",Coarse,Delta>0?"3-click":"4-click",Fine?" then ":"");
+	if(Fine)fprintf(stderr,"%dx %s",Fine,Delta>0?"1-click":"2-click");
+	}
+
+//ŷָУ׼ϵ
+static int ParseGainList(GenCfgDef *Cfg,char *Str)
+	{
+	int i;
+	char *Tok=strtok(Str,",");
+	for(i=0;i<CalPointCount;i++)
+		{
+		if(!Tok)return 0;
+		Cfg->OldGain[i]=atoi(Tok);
+		if(Cfg->OldGain[i]<CalGainMin||Cfg->OldGain[i]>CalGainMax)return 0;
+		Tok=strtok(NULL,",");
+		}
+	return Tok?0:1;
+	}
+
+//в
+static int ParseArgs(GenCfgDef *Cfg,int argc,char *argv[])
+	{
+	int i,Count=0;
+	for(i=1;i<argc;i++)
+		{
+		if(argv[i][0]=='-')
+			{
+			if(i+1>=argc)return 0; //ѡҪֵ
+			if(!strcmp(argv[i],"-imax"))Cfg->IMax=atoi(argv[++i]);
+			else if(!strcmp(argv[i],"-base"))Cfg->Base=(int)strtol(argv[++i],NULL,0);
+			else if(!strcmp(argv[i],"-gain"))
+				{
+				if(!ParseGainList(Cfg,argv[++i]))return 0;
+				}
+			else return 0;
+			}
+		//ʵ
+		else
+			{
+			if(Count>=CalPointCount)return 0;
+			Cfg->Measured[Count++]=atof(argv[i]);
+			}
+		}
+	//ǷϷ
+	if(Count!=CalPointCount||Cfg->IMax<=SetPoint[CalPointCount-2])return 0;
+	if(Cfg->Base<0||(Cfg->Base+CalImageSize)>0x400)return 0;
+	for(i=0;i<CalPointCount;i++)if(Cfg->Measured[i]<=0)return 0;
+	return 1;
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+int main(int argc,char *argv[])
+	{
+	GenCfgDef Cfg;
+	unsigned char Image[CalImageSize];
+	int i,Gain[CalPointCount],IsClamped=0;
+	double Err;
+	//Ĭϲ(ʱδУ׼)
+	Cfg.IMax=0;
+	Cfg.Base=CalTableBase;
+	for(i=0;i<CalPointCount;i++)Cfg.OldGain[i]=CalGainUnity;
+	if(!ParseArgs(&Cfg,argc,argv))
+		{
+		fprintf(stderr,"Usage:%s -imax mA [-gain g1,...,g%d] [-base addr] I1 ... I%d > CalTable.hex\n",argv[0],CalPointCount,CalPointCount);
+		return 1;
+		}
+	SetPoint[CalPointCount-1]=Cfg.IMax;
+	//ÿУ׼У׼ϵ:ʵУ׼ϵȣϵ=ϵ*õ/ʵ
+	fprintf(stderr,"Point  Set(mA)  Measured(mA)  Error     Gain  Side key from current gain\n");
+	for(i=0;i<CalPointCount;i++)
+		{
+		Gain[i]=(int)floor(((double)Cfg.OldGain[i]*SetPoint[i]/Cfg.Measured[i])+0.5);
+		if(Gain[i]>CalGainMax)
+			{
+			Gain[i]=CalGainMax;
+			IsClamped=1;
+			}
+		if(Gain[i]<CalGainMin)
+			{
+			Gain[i]=CalGainMin;
+			IsClamped=1;
+			}
+		Err=((Cfg.Measured[i]-SetPoint[i])*100.0)/SetPoint[i];
+		fprintf(stderr,"%-7d%-9d%-14.1f%+-10.2f%-6d",i+1,SetPoint[i],Cfg.Measured[i],Err,Gain[i]);
+		PrintKeySequence(Gain[i]-Cfg.OldGain[i]);
+		fprintf(stderr,"\n");
+		}
+	if(IsClamped)fprintf(stderr,"Warning:some points exceed the %d%%-%d%% correction range,check the hardware!\n",CalGainMin/10,CalGainMax/10);
+	if(Gain[CalPointCount-1]>CalMaxCurrentGain)fprintf(stderr,"Warning:the last point is limited to %.1f%% of the maximum current by the firmware!\n",CalMaxCurrentGain/10.0);
+	//8051Ϊ˸ʽ
+	Image[0]=CalTableMagic;
+	for(i=0;i<CalPointCount;i++)
+		{
+		Image[1+(i*2)]=(unsigned char)((Gain[i]>>8)&0xFF);
+		Image[2+(i*2)]=(unsigned char)(Gain[i]&0xFF);
+		}
+	Image[CalImageSize-1]=PEC8Check(Image,CalImageSize-1);
+	//Intel HEXļ
+	EmitHexRecord(Cfg.Base,0x00,Image,CalImageSize);
+	EmitHexRecord(0,0x01,NULL,0);
+	return IsClamped?2:0;
+	}
@@ -0,0 +1,61 @@
+/****************************************************************************/
+/** \file C51Host.h
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļѹ̼ԴļʹõKeil C51չؼӳΪ׼Cù̼
+PCʹgcc롣ʱʹ-include C51Host.hǿưHostSim/inc
+̼ͷļĿ¼֮ǰʹPC汾cms8s6990.hintrins.hHostSim/CaseShimڵļ
+ת̼ڴСдʵļһµáЩѡѾдMakefileڡ̵ͷļȴ
+ڵĿ¼ԭcms8s6990.hǰPC汾ͷļԭ档
+
+ΪPCϵC51һ£intΪshort(16bit)ʹ1ֽڶýṹ
+ֺC51һ(Flashڵü¼sizeofCRC)ֱӰ̼.cļĲԳڹ̼
+֮ҪC51HostEnd.hָintܱ֮дPC˵Ĵ롣
+
+PCϱ̼ʱȻҪע⣺
+1.longPCΪ64bitC51Ϊ32bit32bitضϵPCϽ᲻ͬ
+2.PCϵ32bitintУC5116bitСunsigned int(PCΪ16bit
+  unsigned short)ĽPCзŵ32bitC51һƣȽ֮ǰҪ
+  ֵ16bit(̼ڵGetSysTickMSʱֵѾ)
+3.PCСˣC51ǴˣֽڲֶֽڱĴ᲻ͬ
+4.жϴPCͨʹLaserSimʱɷȼԶã
+  ԳҪеá
+5.sbitλĴSFRֽڹô洢̼sbitIOǶȫֱ
+  ֻздǡ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+#ifndef _C51Host_
+#define _C51Host_
+
+//׼Ҫint¶֮ǰ
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+//洢ηPCֻһַռ
+#define xdata
+#define idata
+#define code const
+
+//λʹ_Boolֵ֤ʱC51һѷ0ֵתΪ1
+#define bit _Bool
+#define sbit volatile _Bool //̼ڵIOŶ壬PCΪȫֱƶд
+
+//жϺηжPC汾cms8s6990.hΪպ
+#define interrupt
+
+//Keilʹ##ƴַgccPCϸΪַԶƴ(advmacro.h)
+#define _AdvMacro_
+#define STRCAT2(a, b)        a b
+#define STRCAT3(a, b, c)     a b c
+
+//PC汾ļĴ(еint16_tͶҪint¶֮ǰ)
+#include "inc/cms8s6990.h"
+
+//C51intΪ16bitṹû
+#define int short
+#pragma pack(1)
+
+#endif
@@ -0,0 +1,15 @@
+/****************************************************************************/
+/** \file C51HostEnd.h
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļC51Host.hڶintͽṹ¶塣ֱӰ̼.c
+ļĲԳͷԴļڹ̼(߹̼ͷļ)֮ļ֮PC
+밴PCԭintͶ뷽ʽ롣
+
+**	History: Initial Release
+**
+*****************************************************************************/
+#ifdef _C51Host_
+#undef int
+#pragma pack()
+#endif
@@ -0,0 +1,11 @@
+/****************************************************************************/
+/** \file GPIO.h
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ̼ԴļGPIO.hͷļʵļΪgpio.hKeilڲ
+СдWindowsû⡣PCϱʱʹļתʵʵͷļ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+#include "../../../FirmwareCode/StdDriver/inc/gpio.h"
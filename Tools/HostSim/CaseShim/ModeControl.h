@@ -0,0 +1,11 @@
+/****************************************************************************/
+/** \file ModeControl.h
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ̼ԴļModeControl.hͷļʵļΪModecontrol.hKeilڲ
+СдWindowsû⡣PCϱʱʹļתʵʵͷļ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+#include "../../../FirmwareCode/include/Logic/Modecontrol.h"
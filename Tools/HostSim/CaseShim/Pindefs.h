@@ -0,0 +1,11 @@
+/****************************************************************************/
+/** \file Pindefs.h
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ̼ԴļPindefs.hͷļʵļΪPinDefs.hKeilڲ
+СдWindowsû⡣PCϱʱʹļתʵʵͷļ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+#include "../../../FirmwareCode/Hardware/PinDefs.h"
@@ -0,0 +1,11 @@
+/****************************************************************************/
+/** \file cms8S6990.h
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ̼Դļcms8S6990.hͷļʵļΪcms8s6990.hKeilڲ
+СдWindowsû⡣PCϱʱʹļתʵʵͷļ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+#include "../inc/cms8s6990.h"
@@ -0,0 +1,162 @@
+/****************************************************************************/
+/** \file DitherTest.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļPCϵĺPWMDACһsigma-deltaĲԳ򡣳ֱ
+̼ڵPWM.c(жڵĶۼ)OutputChannel.c(Duty_Calc)ADCCfg.c
+CurrentCal.c(ʹòĬУ׼)20mA(ģʽ)50mA(۽ģʽ)125mA
+ԼɸMCUVDDDuty_CalcСռձȣPWM_OutputCtrlHandler
+ύNPWM_IRQHandler¼ÿʵװصPWMD0H/Lռձȣ
+	Ŀ       VcsoʽľȷPWMֵ
+	ƽ   Nռձȵƽֵȥȷֵ(͵İٷֱ)Լʱֻ
+	           ֵΪԱ
+	Ʋ       ƽֵһRC˲(ʱ䳣-tau)֮ȶ׶εķֵ
+	           (mA)ֻ֮ĵƵƲPWMز
+	           ڵƲ(ߺǷ񶶶޹أȡ˲)
+ƽ1/2^PWMDACDitherBits(DitherTolSlack)ʱֵΪ1
+
+뷽Tools/HostSimĿ¼ִmakeλbuild/<LDͺ>/DitherTestmake check
+ԶСڹ̼ĬϹرգMakefileʹ-DEnablePWMDACDitherһݹ̼
+Գʹá
+ʹ÷DitherTest [-n ] [-tau ˲ʱ䳣(uS)]Ĭ4096ں1000uS
+PWMDAC˲ڹ̼ڣĬϵʱ䳣ֻǼֵ밴ʵʵRCд
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "../../FirmwareCode/Hardware/ADCCfg.c"
+#include "../../FirmwareCode/Hardware/PWM.c"
+#include "../../FirmwareCode/MiddleWare/OutputChannel.c"
+#include "../../FirmwareCode/Logic/CurrentCal.c"
+#include "C51HostEnd.h"
+
+#ifndef EnablePWMDACDither
+	#error "DitherTest must be compiled with -DEnablePWMDACDither!"
+#endif
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+#define DitherPeriodDefault 4096 //ĬϷPWM
+#define DitherTauDefault 1000 //ĬϵPWMDAC˲ʱ䳣(uS)ֵ
+#define DitherSettleTau 10 //˲ٸʱ䳣֮ʼͳƲ
+#define DitherTolSlack 0.001 //ƽ1/2^PWMDACDitherBits֮(PWM)
+
+/****************************************************************************/
+/*	Local constant definitions
+****************************************************************************/
+static const int DitherCurrent[]={20,50,125}; //Եĵ(mA)
+static const int DitherVDD[]={3000,3600,4200,5000}; //ԵMCUVDD(mV)
+
+/****************************************************************************/
+/*	Local function implantation('static')
+****************************************************************************/
+//ȷֵPWMֵ=I*(59*3/200)*(ϵ/1000)*PWM/VDD(mV)VDD=VBG*4096/ADֵ
+static double DitherExact(int Current,unsigned int Code)
+	{
+	unsigned long long Num,Den;
+	Num=(unsigned long long)Current*177ULL*CurrentOffset*PWMStepConstant*Code;
+	Den=200000ULL*ADCBGVREFmV*4096ULL;
+	return (double)(Num/Den)+(double)(Num%Den)/(double)Den;
+	}
+
+//õָPWMڣNڵƽռձԼ˲Ʋֵ
+static double DitherRun(int Current,long Period,double Alpha,long SettlePeriod,double *Ripple,unsigned int *Base,unsigned char *Frac)
+	{
+	long i;
+	unsigned int Duty;
+	double Sum=0,Filt,FiltMax=0,FiltMin=0;
+	//ӸɾPWM״̬ʼдӦռձȲύݴĴ
+	PWM_Init();
+	PWMDuty=Duty_Calc(Current);
+	*Base=PWMDuty;
+	*Frac=PWMDutyFrac;
+	IsNeedToUploadPWM=1;
+	PWM_OutputCtrlHandler();
+	//һжύݴĴ鲢װصһڵռձ
+	PWM_IRQHandler();
+	PWMLOADEN=0; //PCûӲڱ߽װر־ģװ
+	Filt=(double)DitherBase+(double)DitherFrac/(double)PWMDitherOne; //˲ƽֵʼ
+	for(i=0;i<Period+SettlePeriod;i++)
+		{
+		//װصռձȣٵжϵõһڵռձ
+		Duty=((unsigned int)PWMD0H<<8)|PWMD0L;
+		PWM_IRQHandler();
+		PWMLOADEN=0;
+		//һRC˲ÿڰƽֵһ
+		Filt+=((double)Duty-Filt)*Alpha;
+		if(i<SettlePeriod)continue;
+		Sum+=(double)Duty;
+		if(i==SettlePeriod||Filt>FiltMax)FiltMax=Filt;
+		if(i==SettlePeriod||Filt<FiltMin)FiltMin=Filt;
+		}
+	*Ripple=FiltMax-FiltMin;
+	return Sum/(double)Period;
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+int main(int argc,char *argv[])
+	{
+	long Period=DitherPeriodDefault,SettlePeriod;
+	double Tau=DitherTauDefault,Alpha,Exact,Mean,Ripple,Gain,Err,IntErr,MaxErr=0;
+	unsigned int Code,Base;
+	unsigned char Frac,i;
+	int j,k,Ret=0;
+	//
+	for(j=1;j<argc;j++)
+		{
+		if(!strcmp(argv[j],"-n")&&j+1<argc)sscanf(argv[++j],"%ld",&Period);
+		else if(!strcmp(argv[j],"-tau")&&j+1<argc)sscanf(argv[++j],"%lf",&Tau);
+		else
+			{
+			fprintf(stderr,"÷DitherTest [-n ] [-tau ˲ʱ䳣(uS)]\n");
+			return 2;
+			}
+		}
+	if(Period<=0||Tau<=0)
+		{
+		fprintf(stderr,"ʱ䳣0\n");
+		return 2;
+		}
+	//һRC˲ÿPWMڵϵԼʼͳ֮ǰҪȴ
+	Alpha=1.0-exp(-1000000.0/((double)PWMFreq*Tau));
+	SettlePeriod=(long)((DitherSettleTau*Tau*(double)PWMFreq)/1000000.0)+1;
+	//PCûFlashֱʹòĬУ׼
+	for(i=0;i<CalPointCount;i++)CalTable.Gain[i]=CalGainUnity;
+	CurrentCal_CalcCoeff();
+	printf("%ld PWM periods at %dHz, %d fraction bits, RC filter tau %.0fuS\n",Period,PWMFreq,PWMDACDitherBits,Tau);
+	printf("%-6s %-6s %-10s %-11s %-19s %-19s %s\n","I(mA)","VDD","Target","Duty","Mean error","No dither error","Ripple(p-p)");
+	//VDD
+	for(j=0;j<(int)(sizeof(DitherCurrent)/sizeof(DitherCurrent[0]));j++)
+		for(k=0;k<(int)(sizeof(DitherVDD)/sizeof(DitherVDD[0]));k++)
+			{
+			Code=(unsigned int)(((unsigned long)ADCBGVREFmV*4096UL)/(unsigned long)DitherVDD[k]);
+			ADC_WriteOutputBuf((int)Code,ADC_INTVREFCh);
+			Exact=DitherExact(DitherCurrent[j],Code);
+			Gain=Exact/(double)DitherCurrent[j]; //ÿmAӦPWM
+			Mean=DitherRun(DitherCurrent[j],Period,Alpha,SettlePeriod,&Ripple,&Base,&Frac);
+			Err=Mean-Exact;
+			IntErr=(double)Base-Exact;
+			if(fabs(Err)>MaxErr)MaxErr=fabs(Err);
+			printf("%-6d %.2fV %-10.4f %4u+%2u/%-4d %+.4f(%+.3f%%)   %+.4f(%+.3f%%)   %.4f(%.4fmA)\n",
+				DitherCurrent[j],(double)DitherVDD[k]/1000.0,Exact,Base,Frac,PWMDitherOne,
+				Err,(Err*100.0)/Exact,IntErr,(IntErr*100.0)/Exact,Ripple,Ripple/Gain);
+			}
+	//ƽ
+	printf("Max mean error %.4f counts\n",MaxErr);
+	if(MaxErr>(1.0/(double)PWMDitherOne)+DitherTolSlack)
+		{
+		printf("FAIL: mean error exceeds %.4f counts\n",(1.0/(double)PWMDitherOne)+DitherTolSlack);
+		Ret=1;
+		}
+	else printf("PASS\n");
+	return Ret;
+	}
@@ -0,0 +1,179 @@
+/****************************************************************************/
+/** \file DutyCalcTest.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļPCϵĺPWMDACռձȶĲԳ򡣳ֱ
+̼ڵADCCfg.c(VREFͨMCUVDDRecipĻ)OutputChannel.c(Duty_Calc)
+CurrentCal.c(ʹòĬУ׼)
+MCUVDDΪ3.0V~5.5VӦȫ϶׼ADֵԼ1mALDICCMAXȫ
+οֵжԱȣ
+	οֵ ʹ64λͬĶ㹫ʽ(ضλͬ)Ľ̼
+	           (С)λһ£ڷ16/32bitмֵ
+	           ּĴ
+	ȷֵ     ʹ64λSC8721AVcsoʽ
+	οֵ Ϊ֮ǰ̼ʹõĵȸ(PWM.cڰٷֱȵֵĻ)
+㹫ʽǶԾȷֵλȡ(Ľضϻüȡֵ
+С1)˺;ȷֵ֮䰴ݲ飺ܴھȷֵ(ƫĵ)
+ҲСھȷֵ-1-DutyTolSlackPWMͬʱΧܱȸοֵ
+EnablePWMDACDitherʱ+Сֵް1/2^PWMDACDitherBits㡣Ͷ
+οֵһ»߳ݲʱֵΪ1
+
+뷽Tools/HostSimĿ¼ִmakeλbuild/<LDͺ>/DutyCalcTestmake check
+ԶСʹmake LDTYPE=xxxѡ͹̼ĿLD_xxxһµLDļ
+ʹ÷DutyCalcTest [-v]-vÿADֵµ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "../../FirmwareCode/Hardware/ADCCfg.c"
+#include "../../FirmwareCode/MiddleWare/OutputChannel.c"
+#include "../../FirmwareCode/Logic/CurrentCal.c"
+#include "C51HostEnd.h"
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+#define VDDCodeMin ((ADCBGVREFmV*4096UL)/5500UL) //MCUVDD=5.5Vʱ϶׼ADֵ
+#define VDDCodeMax ((ADCBGVREFmV*4096UL)/3000UL) //MCUVDD=3.0Vʱ϶׼ADֵ
+#define DutyTolSlack 0.001 //ȡ֮ض(PWM)
+#define DutyTolExact 1E-9 //ж϶Ƿھȷֵʱ˫ȼ(PWM)
+
+/****************************************************************************/
+/*	Local function implantation('static')
+****************************************************************************/
+//ȷֵPWMֵ=I*(59*3/200)*(ϵ/1000)*PWM/VDD(mV)VDD=VBG*4096/ADֵ
+static double DutyExact(int Current,unsigned int Code)
+	{
+	unsigned long long Num,Den;
+	Num=(unsigned long long)Current*177ULL*CurrentOffset*PWMStepConstant*Code;
+	Den=200000ULL*ADCBGVREFmV*4096ULL;
+	return (double)(Num/Den)+(double)(Num%Den)/(double)Den;
+	}
+
+//οֵDuty_CalcĶ㹫ʽʹ64λһÿһĽضϽQ16ʽPWMֵ
+static unsigned long long DutyFixedRef(int Current,unsigned int Code)
+	{
+	unsigned long long K24,G24;
+	//X*2^14/234375ȡQ12泣8λС(DutyGainK*256+DutyGainKFrac)
+	K24=(177ULL*CurrentOffset*PWMStepConstant*16384ULL)/234375ULL;
+	//Q168λС(DutyGain*256+DutyGainFrac)ADֵԳȥ12λȥQ8С
+	G24=((unsigned long long)Code*K24)>>12;
+	//Q16ʽPWMֵ
+	return ((unsigned long long)Current*G24)>>8;
+	}
+
+//οֵ㻯֮ǰ̼ĵȸ
+static int DutyFloatRef(int Current,unsigned int Code)
+	{
+	float VDD,buf;
+	VDD=((float)ADCBGVREFmV/(float)1000)*(float)4096/(float)Code;
+	buf=((float)Current*(float)59)/(float)200;
+	buf*=(float)CurrentOffset/(float)1000;
+	buf*=(float)3;
+	buf/=VDD*(float)1000;
+	buf*=100;
+	//PWM.cڵİٷֱȵֵĻ
+	buf=buf*(float)PWMStepConstant;
+	buf/=(float)100;
+	return (int)buf;
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+int main(int argc,char *argv[])
+	{
+	unsigned int Code;
+	unsigned char i;
+	int I,Duty,FloatDuty,IsVerbose,Ret=0;
+	double Exact,Err,MaxErr=0,MinErr=0,FloatMaxErr=0,FloatMinErr=0,CodeMax,CodeMin;
+	long Mismatch=0,FloatMismatch=0,RefMismatch=0,Total=0;
+	unsigned long long Ref;
+	#ifdef EnablePWMDACDither
+	double FracErr,FracMaxErr=0,FracMinErr=0;
+	#endif
+	IsVerbose=argc>1&&!strcmp(argv[1],"-v");
+	//PCûFlashֱʹòĬУ׼
+	for(i=0;i<CalPointCount;i++)CalTable.Gain[i]=CalGainUnity;
+	CurrentCal_CalcCoeff();
+	//ȫVDD͵
+	for(Code=VDDCodeMin;Code<=VDDCodeMax;Code++)
+		{
+		ADC_WriteOutputBuf((int)Code,ADC_INTVREFCh);
+		CodeMax=0;
+		CodeMin=0;
+		for(I=1;I<=LDICCMAX;I++)
+			{
+			Duty=(int)Duty_Calc(I);
+			Exact=DutyExact(I,Code);
+			//ͶοֵλԱ
+			Ref=DutyFixedRef(I,Code);
+			#ifdef EnablePWMDACDither
+			if((unsigned long long)Duty!=(Ref>>16)||PWMDutyFrac!=((Ref>>(16-PWMDACDitherBits))&((1<<PWMDACDitherBits)-1)))
+			#else
+			if((unsigned long long)Duty!=(Ref>>16))
+			#endif
+				{
+				if(!RefMismatch)printf("First mismatch against fixed point ref: code %u, %d mA\n",Code,I);
+				RefMismatch++;
+				}
+			FloatDuty=DutyFloatRef(I,Code);
+			//ֺ;ȷֵԱ
+			Err=(double)Duty-Exact;
+			if(Err>CodeMax)CodeMax=Err;
+			if(Err<CodeMin)CodeMin=Err;
+			if(Duty!=(int)Exact)Mismatch++;
+			//οֵ;ȷֵԱ
+			Err=(double)FloatDuty-Exact;
+			if(Err>FloatMaxErr)FloatMaxErr=Err;
+			if(Err<FloatMinErr)FloatMinErr=Err;
+			if(FloatDuty!=(int)Exact)FloatMismatch++;
+			#ifdef EnablePWMDACDither
+			//СֵĽ;ȷֵԱ
+			FracErr=(double)Duty+((double)PWMDutyFrac/(double)(1<<PWMDACDitherBits))-Exact;
+			if(FracErr>FracMaxErr)FracMaxErr=FracErr;
+			if(FracErr<FracMinErr)FracMinErr=FracErr;
+			#endif
+			Total++;
+			}
+		if(CodeMax>MaxErr)MaxErr=CodeMax;
+		if(CodeMin<MinErr)MinErr=CodeMin;
+		if(IsVerbose)printf("Code %u (VDD %.3fV): error %+.3f ~ %+.3f counts\n",Code,(ADCBGVREFmV*4.096)/Code,CodeMin,CodeMax);
+		}
+	//ͳƽ
+	printf("Checked %ld points, VDD code %lu-%lu, current 1-%d mA\n",Total,VDDCodeMin,VDDCodeMax,LDICCMAX);
+	printf("Fixed ref  : %ld points differ bit-for-bit from the 64-bit fixed point reference\n",RefMismatch);
+	printf("Fixed point: error %+.5f ~ %+.5f counts, %ld points differ from floor(exact)\n",MinErr,MaxErr,Mismatch);
+	printf("Float ref  : error %+.5f ~ %+.5f counts, %ld points differ from floor(exact)\n",FloatMinErr,FloatMaxErr,FloatMismatch);
+	//ݲ
+	if(RefMismatch)
+		{
+		printf("FAIL: fixed point result is not bit-exact against the reference\n");
+		Ret=1;
+		}
+	if(MaxErr>DutyTolExact||MinErr<-1.0-DutyTolSlack)
+		{
+		printf("FAIL: fixed point error is outside %+.3f ~ +0 counts\n",-1.0-DutyTolSlack);
+		Ret=1;
+		}
+	if(MaxErr>FloatMaxErr||MinErr<FloatMinErr)
+		{
+		printf("FAIL: fixed point error is worse than the float reference\n");
+		Ret=1;
+		}
+	#ifdef EnablePWMDACDither
+	printf("Dither     : error %+.5f ~ %+.5f counts with %d fraction bits\n",FracMinErr,FracMaxErr,PWMDACDitherBits);
+	if(FracMaxErr>DutyTolExact||FracMinErr<-(1.0/(double)(1<<PWMDACDitherBits))-DutyTolSlack)
+		{
+		printf("FAIL: dither error is outside %+.3f ~ +0 counts\n",-(1.0/(double)(1<<PWMDACDitherBits))-DutyTolSlack);
+		Ret=1;
+		}
+	#endif
+	if(!Ret)printf("PASS\n");
+	return Ret;
+	}
@@ -0,0 +1,17 @@
+/****************************************************************************/
+/** \file HostGPIO.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ̵gpio.cֱӶP0~P3˿ڽжд̼ڵsbitҪ˿Ϊ
+PCϱ룬PCϲֱӱgpio.cͨļڶ˿ΪRAM
+±롣
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#define HostSFRPortAsRAM
+#include "inc/cms8s6990.h"
+#include "../../FirmwareCode/StdDriver/src/gpio.c"
@@ -0,0 +1,32 @@
+/****************************************************************************/
+/** \file HostSFR.c
+/** \Description ļTools/HostSim/SFRHostGen../../FirmwareCode/StdDriver/inc/cms8s6990.hԶɣ
+ΪPC汾cms8s6990.hȫĴ洢ռ䲢ʵַʺ
+мĴϵʱΪ0ԳֱӶдĴģӲ״̬ļʱ
+ܴиʲ׮벻Ҫֶ޸ġ
+*****************************************************************************/
+#define HostSFRPortAsRAM
+#include "inc/cms8s6990.h"
+
+volatile HostSFRDef HostSFR[256];
+volatile unsigned char HostXSFR[HostXSFRSize];
+void (*HostSFRHook)(unsigned char IsXSFR,unsigned short Addr);
+
+//SFR
+volatile HostSFRDef *HostSFR_Access(unsigned char Addr)
+	{
+	if(HostSFRHook)HostSFRHook(0,Addr);
+	return &HostSFR[Addr];
+	}
+
+//xdataӳĴ
+volatile unsigned char *HostXSFR_Access(unsigned short Addr)
+	{
+	if(HostSFRHook)HostSFRHook(1,Addr);
+	return &HostXSFR[Addr-HostXSFRBase];
+	}
+
+//̼Ŀļ-fsanitize-coverage=trace-pc׮ʱʹ÷ĲԳջص
+__attribute__((weak)) void __sanitizer_cov_trace_pc(void)
+	{
+	}
@@ -0,0 +1,277 @@
+/****************************************************************************/
+/** \file HostSim.h
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļPCϵıջ(LaserSim)ڲʹõͷļ˷ʱ䡢
+Ĵַͱض(SC8721LDغģ)״̬Լģ֮Ľӿڡ
+
+Ľṹ
+	SimCore.c    ʱ䡢Ĵд⡢ʱT0/T1/T2жϷַSTOP˯ߺ͸λ
+	SimPeriph.c  ADCPWMI2CغSC8721ĴFlashఴͻѶʱ(WUT)
+	SimPlant.c   SC8721ʼLDغģ
+	SimScript.c  űͽ
+	LaserSim.c   вϵ/λѭ
+̼Ŀļ-fsanitize-coverage=trace-pc׮ÿִ֮ǰ÷
+ÿ̶ʱƽʱ䣬д¼жϣ
+̼Ҫκ޸ģжҲʵʱλôѭ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+#ifndef _HostSim_
+#define _HostSim_
+
+#include "C51HostEnd.h"
+
+/****************************************************************************/
+/*	ʱ
+****************************************************************************/
+typedef unsigned long long SimTimeDef; //ʱ(1LSB=1ϵͳʱ)
+#define SimFsys 48000000ULL //ϵͳʱƵ(Hz)
+#define SimUS(x) ((SimTimeDef)((x)*48ULL)) //΢תΪʱ
+#define SimMS(x) ((SimTimeDef)((x)*48000ULL)) //תΪʱ
+#define SimToSec(t) ((double)(t)/(double)SimFsys) //ʱתΪ
+#define SimNever (~0ULL) //¼δ
+
+/****************************************************************************/
+/*	Ĵַ(ֱӷHostSFR[]ʻص)
+****************************************************************************/
+#define SimSFR(Addr) (HostSFR[Addr].Byte)
+#define SimXSFR(Addr) (HostXSFR[(Addr)-HostXSFRBase])
+
+#define SFR_SP 0x81
+#define SFR_PCON 0x87
+#define SFR_TCON 0x88
+#define SFR_TMOD 0x89
+#define SFR_TL0 0x8A
+#define SFR_TL1 0x8B
+#define SFR_TH0 0x8C
+#define SFR_TH1 0x8D
+#define SFR_CKCON 0x8E
+#define SFR_TA 0x96
+#define SFR_WDCON 0x97
+#define SFR_IE 0xA8
+#define SFR_EIE2 0xAA
+#define SFR_P1EXTIE 0xAD
+#define SFR_EIF2 0xB2
+#define SFR_P1EXTIF 0xB5
+#define SFR_IP 0xB8
+#define SFR_EIP1 0xB9
+#define SFR_EIP2 0xBA
+#define SFR_WUTCRL 0xBC
+#define SFR_WUTCRH 0xBD
+#define SFR_T2CON 0xC8
+#define SFR_T2IF 0xC9
+#define SFR_RLDL 0xCA
+#define SFR_RLDH 0xCB
+#define SFR_TL2 0xCC
+#define SFR_TH2 0xCD
+#define SFR_T2IE 0xCF
+#define SFR_ADRESL 0xDC
+#define SFR_ADRESH 0xDD
+#define SFR_ADCON1 0xDE
+#define SFR_ADCON0 0xDF
+#define SFR_I2CMSA 0xF4
+#define SFR_I2CMCR 0xF5 //I2CMSRõַдΪȡΪ״̬
+#define SFR_I2CMBUF 0xF6
+#define SFR_MLOCK 0xFB
+#define SFR_MADRL 0xFC
+#define SFR_MADRH 0xFD
+#define SFR_MDATA 0xFE
+#define SFR_MCTRL 0xFF
+
+#define XSFR_P13EICFG 0xF08B
+#define XSFR_PWMOE 0xF121
+#define XSFR_PWMCNTE 0xF126
+#define XSFR_PWMLOADEN 0xF129
+#define XSFR_PWMP0L 0xF130
+#define XSFR_PWMP4L 0xF138
+#define XSFR_PWMD0L 0xF140
+#define XSFR_PWMD4L 0xF148
+#define XSFR_PWMMASKE 0xF164
+#define XSFR_PWMMASKD 0xF165
+#define XSFR_PWMPIE 0xF168
+#define XSFR_PWMPIF 0xF16C
+#define XSFR_ADCLDO 0xF692
+
+/****************************************************************************/
+/*	̼ڵIO(̼sbitPCȫֱ)
+****************************************************************************/
+extern volatile _Bool DCDCEN,LDMOSEN,KeyPress,RLED,GLED,PWMDACPin,PreChargeDACPin;
+
+/****************************************************************************/
+/*	¼
+****************************************************************************/
+typedef enum
+	{
+	SimEv_T0,			//T0
+	SimEv_T1,			//T1
+	SimEv_T2,			//T2
+	SimEv_PWM0,			//PWMͨ0ڱ߽
+	SimEv_PWM4,			//PWMͨ4ڱ߽
+	SimEv_ADC,			//ADCת
+	SimEv_I2C,			//I2Cֽڴ
+	SimEv_Flash,		//Flash
+	SimEv_MCUCount,		//¼STOPڼ䶳(ϵͳʱֹͣ)
+	SimEv_WUT=SimEv_MCUCount, //Ѷʱ
+	SimEv_Plant,		//ض
+	SimEv_Script,		//űһ
+	SimEv_Count
+	}SimEventDef;
+
+typedef enum
+	{
+	SimExit_End=0,		//űִ
+	SimExit_Reset=10,	//̼λ
+	SimExit_PowerCycle=11, //űҪϵ
+	SimExit_Fail=12		//ڲ
+	}SimExitDef;
+
+/****************************************************************************/
+/*	ض
+****************************************************************************/
+typedef struct
+	{
+	//SC8721
+	unsigned char Reg[16];		//Ĵ
+	unsigned char CSOActive;	//EN_LOAD֮ЧCSO_SET
+	unsigned char Status1,Status2; //ȡ֮״̬λ
+	_Bool IsEN;					//EN
+	_Bool IsRunning;			//ʼڹ
+	double ENTime;				//ENߵʱ()
+	double SSFrac;				//𶯽(0~1)
+	double Ucc;					//(V)
+	//͸
+	double Vout;				//ݵѹ(V)
+	double IConv;				//ʼ(A)
+	double ILD;					//LD(A)
+	double Vdac0,Vdac4;			//˲֮PWMDACѹ(V)
+	//
+	double SOC;					//ɵ״̬(0~1)
+	double OCV;					//·ѹ(V)
+	double Vbat;				//˵ѹ(V)
+	double Ibat;				//ŵ(A)
+	//
+	double Ambient;				//¶()
+	double HostC,HostR;			//(J/K)(K/W)
+	double THost;				//¶()
+	double TNTC;				//NTC¶()
+	double Time;				//Ѿֵʱ()
+	}SimPlantDef;
+
+typedef struct
+	{
+	_Bool IsMCUOn;				//Ƭ(ϵڼΪ0)
+	_Bool DCDCEN,LDMOSEN;		//
+	double Duty0,Duty4;			//PWMDACŵƽռձ(0~1)
+	}SimPlantInDef;
+
+/****************************************************************************/
+/*	
+****************************************************************************/
+#define SimFastSampleUS 100		//ٲ(uS)
+#define SimFastSampleCount 100000 //ٲ(10)
+#define SimSlowSampleMS 100		//ٲ(mS)
+#define SimSlowSampleCount 72000 //ٲ(2Сʱ)
+#define SimFinalSampleCount 500 //յĿٲ(50mS)
+#define SimMetricCount 32 //ָ
+
+typedef struct
+	{
+	char Name[32];
+	_Bool IsActive;
+	SimTimeDef Start;			//ʼʱ
+	double PeakI,PeakV,PeakT;	//ֵ(A)ѹ(V)¶()
+	double SumI;				//ۼֵ(A)
+	long FastCount,SlowCount;	//(ֻ֮)
+	unsigned long LoopCount;	//ѭȦ
+	SimTimeDef LoopLast,LoopMax; //һȦĿʼʱȦʱ
+	double Result[SimMetricCount]; //һμָ(SimScript.c)
+	//Ϊʼʱ
+	float FastI[SimFastSampleCount];
+	float SlowT[SimSlowSampleCount];
+	float FinalI[SimFinalSampleCount]; //Ŀٲ(λ)
+	}SimMeasDef;
+
+/****************************************************************************/
+/*	͹״̬
+****************************************************************************/
+typedef struct
+	{
+	unsigned int CyclePerBlock;	//ÿʱ
+	double VbatInit;			//ʼؿ·ѹ(V)
+	int CellCount;				//ؽ
+	double Ambient;				//¶()
+	double HostC,HostR,SensorTau; //(J/K)(K/W)NTCʱ䳣()
+	double ADCNoise;			//ADCֵ(LSB)
+	const char *FlashFile;		//ʱȡFlashӳ
+	const char *SaveFlashFile;	//ʱFlashӳ
+	const char *TraceFile;		//ļ
+	double TraceStepMS;			//
+	int IsVerbose;
+	}SimParamDef;
+
+#define SimFlashSize 1024 //Flash
+
+typedef struct
+	{
+	SimTimeDef Now;				//ǰʱ
+	SimPlantDef Plant;
+	SimPlantInDef In;
+	unsigned char Flash[SimFlashSize];
+	//ű
+	int ScriptPos;				//һ
+	SimTimeDef ScriptWake;		//һִʱ
+	SimTimeDef PowerOnTime;		//ϵʱϵʱ
+	_Bool IsKeyPressed;
+	int FailCount,CheckCount;	//expectʧܺ
+	int BootCount,ResetCount;
+	SimMeasDef Meas;
+	//
+	SimTimeDef TraceNext;
+	unsigned int ADCSeed;		//ADCα
+	}SimStateDef;
+
+extern SimParamDef SimParam;
+extern SimStateDef *Sim;
+extern FILE *SimTrace;
+
+/****************************************************************************/
+/*	ģӿ
+****************************************************************************/
+//SimCore.c
+void SimCore_Boot(void);
+void SimCore_Exit(SimExitDef Code);
+void SimEvent_Set(SimEventDef Ev,SimTimeDef When);
+SimTimeDef SimEvent_Get(SimEventDef Ev);
+void SimSFR_Set(unsigned char Addr,unsigned char Value);
+void SimCore_WakeUp(void);
+void SimCore_Fatal(const char *Msg);
+
+//SimPeriph.c
+void SimPeriph_Boot(void);
+void SimPeriph_Event(SimEventDef Ev);
+void SimPeriph_Write(unsigned char Addr,unsigned char Old,unsigned char New);
+double SimPWM_Output(int Ch);
+void SimKey_Set(_Bool IsPressed);
+void SimWUT_Write(void);
+
+//SimPlant.c
+void SimPlant_Init(void);
+void SimPlant_SetBattery(double Volt);
+void SimPlant_Sync(void);
+void SimPlant_Event(void);
+double SimPlant_VDD(void);
+double SimPlant_ADCInput(unsigned char Ch);
+unsigned char SimSC8721_Read(unsigned char Reg);
+void SimSC8721_Write(unsigned char Reg,unsigned char Value);
+_Bool SimSC8721_IsACK(void);
+void SimPlant_Advance(SimTimeDef Until);
+
+//SimScript.c
+int SimScript_Load(const char *File);
+void SimScript_Event(void);
+void SimScript_Sample(void);
+void SimScript_Loop(void);
+
+#endif
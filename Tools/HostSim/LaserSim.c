@@ -0,0 +1,204 @@
+/****************************************************************************/
+/** \file LaserSim.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļLaserSimջڣвԼϵ硢λ
+ϵѭ÷
+	LaserSim [ѡ] ļ
+	-cpb <n>          ÿʱ(Ĭ24)
+	-vbat <V>         ʼ鿪·ѹ(Ĭ4.0V x ؽ)
+	-cells <n>        ؽ(Ĭ1)
+	-ta <>          ¶(Ĭ25)
+	-host <C> <R>     (J/K)(K/W)(Ĭ80J/K4K/W)
+	-adcnoise <LSB>   ADCֵ(Ĭ0)
+	-flash <ļ>     ʱȡFlashӳ(ĬΪȫ״̬)
+	-saveflash <ļ> ʱFlashӳ
+	-trace <ļ>     CSV
+	-tracestep <ms>   ε(Ĭ1mS)
+	-v                ÿһĽľ
+expectȫͨʱ0򷵻1
+
+̼ȫֱֻϵʱʼһΣÿϵλµӽй̼
+״̬(ʱ䡢ضFlashͲ)ڸӽ̹ڴڣӽ˳֮ɸ
+˳ԭ̼ڶϵ״̬ƽضǽ档
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include "HostSim.h"
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+/****************************************************************************/
+/*	External function prototypes(̼)
+****************************************************************************/
+extern void FirmwareMain(void); //̼mainʱʹ-Dmain=FirmwareMain
+extern void __real_Scheduler_Run(void);
+
+/****************************************************************************/
+/*	Function implementation - local('static')
+****************************************************************************/
+//÷
+static int Usage(void)
+	{
+	printf("usage: LaserSim [-cpb n] [-vbat V] [-cells n] [-ta C] [-host C R] [-adcnoise LSB]\n");
+	printf("                [-flash file] [-saveflash file] [-trace file] [-tracestep ms] [-v] scenario\n");
+	return 2;
+	}
+
+//ȡFlashӳ
+static void LoadFlash(const char *File)
+	{
+	FILE *fp;
+	memset(Sim->Flash,0xFF,SimFlashSize);
+	if(File==NULL)return;
+	fp=fopen(File,"rb");
+	if(fp==NULL)
+		{
+		printf("LaserSim: cannot open %s, starting with erased flash\n",File);
+		return;
+		}
+	if(fread(Sim->Flash,1,SimFlashSize,fp)!=SimFlashSize)printf("LaserSim: %s is shorter than %d bytes\n",File,SimFlashSize);
+	fclose(fp);
+	}
+
+//Flashӳ
+static void SaveFlash(const char *File)
+	{
+	FILE *fp;
+	if(File==NULL)return;
+	fp=fopen(File,"wb");
+	if(fp==NULL||fwrite(Sim->Flash,1,SimFlashSize,fp)!=SimFlashSize)printf("LaserSim: cannot write %s\n",File);
+	if(fp!=NULL)fclose(fp);
+	}
+
+//ӽϵй̼˳ԭ
+static int RunFirmware(void)
+	{
+	pid_t Pid;
+	int Status;
+	fflush(stdout);
+	if(SimTrace!=NULL)fflush(SimTrace);
+	Pid=fork();
+	if(Pid<0)
+		{
+		perror("LaserSim: fork");
+		return SimExit_Fail;
+		}
+	if(Pid==0)
+		{
+		SimCore_Boot();
+		FirmwareMain();
+		SimCore_Fatal("main() returned");
+		}
+	if(waitpid(Pid,&Status,0)<0)
+		{
+		perror("LaserSim: waitpid");
+		return SimExit_Fail;
+		}
+	if(WIFSIGNALED(Status))
+		{
+		printf("LaserSim: firmware crashed with signal %d at %.6fs\n",WTERMSIG(Status),SimToSec(Sim->Now));
+		return SimExit_Fail;
+		}
+	return WEXITSTATUS(Status);
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+//ѭÿȦͳƣʱʹ--wrap=Scheduler_Run滻̼mainԵĵ
+void __wrap_Scheduler_Run(void)
+	{
+	SimScript_Loop();
+	__real_Scheduler_Run();
+	}
+
+int main(int argc,char *argv[])
+	{
+	const char *Scenario=NULL;
+	int i,Code;
+	double Vbat=0;
+	//Ĭϲ
+	SimParam.CyclePerBlock=24;
+	SimParam.CellCount=1;
+	SimParam.Ambient=25;
+	SimParam.HostC=80;
+	SimParam.HostR=4;
+	SimParam.SensorTau=5;
+	SimParam.TraceStepMS=1;
+	//в
+	for(i=1;i<argc;i++)
+		{
+		if(!strcmp(argv[i],"-cpb")&&i+1<argc)SimParam.CyclePerBlock=(unsigned int)atoi(argv[++i]);
+		else if(!strcmp(argv[i],"-vbat")&&i+1<argc)Vbat=atof(argv[++i]);
+		else if(!strcmp(argv[i],"-cells")&&i+1<argc)SimParam.CellCount=atoi(argv[++i]);
+		else if(!strcmp(argv[i],"-ta")&&i+1<argc)SimParam.Ambient=atof(argv[++i]);
+		else if(!strcmp(argv[i],"-host")&&i+2<argc)
+			{
+			SimParam.HostC=atof(argv[++i]);
+			SimParam.HostR=atof(argv[++i]);
+			}
+		else if(!strcmp(argv[i],"-adcnoise")&&i+1<argc)SimParam.ADCNoise=atof(argv[++i]);
+		else if(!strcmp(argv[i],"-flash")&&i+1<argc)SimParam.FlashFile=argv[++i];
+		else if(!strcmp(argv[i],"-saveflash")&&i+1<argc)SimParam.SaveFlashFile=argv[++i];
+		else if(!strcmp(argv[i],"-trace")&&i+1<argc)SimParam.TraceFile=argv[++i];
+		else if(!strcmp(argv[i],"-tracestep")&&i+1<argc)SimParam.TraceStepMS=atof(argv[++i]);
+		else if(!strcmp(argv[i],"-v"))SimParam.IsVerbose=1;
+		else if(argv[i][0]!='-'&&Scenario==NULL)Scenario=argv[i];
+		else return Usage();
+		}
+	if(Scenario==NULL||!SimParam.CyclePerBlock||SimParam.CellCount<1||SimParam.HostC<=0||SimParam.HostR<=0||SimParam.TraceStepMS<=0)return Usage();
+	SimParam.VbatInit=Vbat>0?Vbat:4.0*SimParam.CellCount;
+	if(!SimScript_Load(Scenario))return 2;
+	//ķ״̬
+	Sim=mmap(NULL,sizeof(SimStateDef),PROT_READ|PROT_WRITE,MAP_SHARED|MAP_ANONYMOUS,-1,0);
+	if(Sim==MAP_FAILED)
+		{
+		perror("LaserSim: mmap");
+		return 2;
+		}
+	LoadFlash(SimParam.FlashFile);
+	SimPlant_Init();
+	if(SimParam.TraceFile!=NULL)
+		{
+		SimTrace=fopen(SimParam.TraceFile,"w");
+		if(SimTrace==NULL)
+			{
+			printf("LaserSim: cannot open %s\n",SimParam.TraceFile);
+			return 2;
+			}
+		fprintf(SimTrace,"t_s,vout_v,ild_ma,vdac_cc_v,vdac_cv_v,vbat_v,thost_c,dcdcen,ldmosen,duty_cc,duty_cv,mode,key\n");
+		}
+	//ϵ硢λͶϵ
+	do
+		{
+		Code=RunFirmware();
+		switch(Code)
+			{
+			case SimExit_Reset:Sim->ResetCount++;break;
+			case SimExit_PowerCycle:
+				//ϵڼֻбض
+				Sim->Now=Sim->PowerOnTime;
+				SimPlant_Sync();
+				break;
+			case SimExit_End:break;
+			default:
+				if(Code!=SimExit_Fail)printf("LaserSim: unexpected exit code %d\n",Code);
+				Code=SimExit_Fail;
+				break;
+			}
+		}
+	while(Code==SimExit_Reset||Code==SimExit_PowerCycle);
+	//
+	SaveFlash(SimParam.SaveFlashFile);
+	if(SimTrace!=NULL)fclose(SimTrace);
+	printf("%s: %.3fs simulated, %d boot(s), %d reset(s), %d/%d check(s) passed\n",Scenario,SimToSec(Sim->Now),
+		Sim->BootCount,Sim->ResetCount,Sim->CheckCount-Sim->FailCount,Sim->CheckCount);
+	return Code==SimExit_End&&!Sim->FailCount?0:1;
+	}
@@ -0,0 +1,238 @@
+/****************************************************************************/
+/** \file SFRHostGen.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļPCϵļĴͷļתߣѳṩ
+cms8s6990.hתΪPCgccİ汾(HostSim/inc/cms8s6990.h)ͬʱΪ
+Ĵ洢ռHostSFR.cת£
+	sfr NAME = 0xXX;      תΪHostSFR[0xXX]ֽڷʣP0~P3˿ڶ·˵
+	sbit NAME = SFR^n;    תΪHostSFR[SFRַ]ĵnλSFRֽڹô洢
+	xdataӳļĴ      תΪHostXSFR[]ڶӦַԪ
+	xxx_VECTORж   תΪպ꣬C51Host.h"interrupt xxx_VECTOR"Ϊ
+	int8_t~uint32_tͶ 滻Ϊ<stdint.h>PCϵlongΪ64bit׼ĶͲźC51ͬ
+мĴʶHostSFR_Access/HostXSFR_AccessHostSFRHookΪʱÿη
+֮ǰ(LaserSim)Ĵд벢ͬʱ״ַ̬ͬ
+ļĴ(I2CMCRI2CMSR)ͬһֽڡ
+̼ڵsbitʹP0^nĳʽΪʼֵP0~P3˿ĬתΪ
+(Ĵַ)ֻڰͷļ֮ǰHostSFRPortAsRAMļ(HostSFR.cHostGPIO.c)
+ŻѶ˿ΪĴʹá(λ)ԭ
+
+뷽gcc -O2 -o SFRHostGen SFRHostGen.c
+ʹ÷SFRHostGen ../../FirmwareCode/StdDriver/inc/cms8s6990.h inc/cms8s6990.h HostSFR.c
+ͷļ֮һμ(Ҳִmake regen)ɵļҪ͹һύ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+#define LineBufSize 512 //е󳤶
+#define XSFRBase 0xF000 //xdataӳĴʼַ
+#define XSFRSize 0x800 //xdataӳĴĵַΧ
+#define MaxPortCount 4 //P0~P3˿ڵ
+#define MaxSFRCount 256 //SFRƱ󳤶
+
+/****************************************************************************/
+/*	Local type definitions('typedef')
+****************************************************************************/
+typedef struct
+	{
+	char Name[32];
+	unsigned int Addr;
+	}SFRNameDef;
+
+/****************************************************************************/
+/*	Local variable  definitions('static')
+****************************************************************************/
+static SFRNameDef SFRTable[MaxSFRCount]; //תSFRƺ͵ַsbitֽ
+static int SFRCount=0;
+
+/****************************************************************************/
+/*	Local function implantation('static')
+****************************************************************************/
+//жǷΪint8_t~uint32_tͶ
+static int IsStdIntTypedef(const char *Line)
+	{
+	char Name[64];
+	const char *p;
+	if(sscanf(Line," typedef %[^;];",Name)!=1)return 0;
+	p=strrchr(Name,' ');
+	p=p==NULL?Name:p+1;
+	return !strcmp(p,"int8_t")||!strcmp(p,"int16_t")||!strcmp(p,"int32_t")||
+	       !strcmp(p,"uint8_t")||!strcmp(p,"uint16_t")||!strcmp(p,"uint32_t");
+	}
+
+//жSFRǷΪP0~P3˿
+static int IsPortSFR(const char *Name)
+	{
+	return Name[0]=='P'&&Name[1]>='0'&&Name[1]<='3'&&!Name[2];
+	}
+
+//ƲSFRĵַҲ-1
+static int FindSFRAddr(const char *Name)
+	{
+	int i;
+	for(i=0;i<SFRCount;i++)if(!strcmp(SFRTable[i].Name,Name))return (int)SFRTable[i].Addr;
+	return -1;
+	}
+
+//ļͷ˵
+static void PrintBanner(FILE *fp,const char *File,const char *Src,const char *Desc)
+	{
+	fprintf(fp,"/****************************************************************************/\n");
+	fprintf(fp,"/** \\file %s\n",File);
+	fprintf(fp,"/** \\Description ļTools/HostSim/SFRHostGen%sԶɣ\n",Src);
+	fprintf(fp,"%s벻Ҫֶ޸ġ\n",Desc);
+	fprintf(fp,"*****************************************************************************/\n");
+	}
+
+//Ĵ洢ͷʺԼHostSFR.cڵʵ
+static void PrintSFRDef(FILE *Hdr,FILE *Src)
+	{
+	int i;
+	fprintf(Hdr,"//PCϵļĴ洢ͷʺHostSFR.cʵ\n");
+	fprintf(Hdr,"typedef union\n\t{\n\tunsigned char Byte;\n\tstruct\n\t\t{\n");
+	for(i=0;i<8;i++)fprintf(Hdr,"\t\t_Bool B%d:1;\n",i);
+	fprintf(Hdr,"\t\t}Bit;\n\t}HostSFRDef;\n");
+	fprintf(Hdr,"#define HostXSFRBase 0x%04X //xdataӳĴʼַ\n",XSFRBase);
+	fprintf(Hdr,"#define HostXSFRSize 0x%04X //xdataӳĴĵַΧ\n",XSFRSize);
+	fprintf(Hdr,"extern volatile HostSFRDef HostSFR[256];\n");
+	fprintf(Hdr,"extern volatile unsigned char HostXSFR[HostXSFRSize];\n");
+	fprintf(Hdr,"extern void (*HostSFRHook)(unsigned char IsXSFR,unsigned short Addr); //ʻصڷ֮ǰ\n");
+	fprintf(Hdr,"volatile HostSFRDef *HostSFR_Access(unsigned char Addr);\n");
+	fprintf(Hdr,"volatile unsigned char *HostXSFR_Access(unsigned short Addr);\n\n");
+	fprintf(Src,"volatile HostSFRDef HostSFR[256];\n");
+	fprintf(Src,"volatile unsigned char HostXSFR[HostXSFRSize];\n");
+	fprintf(Src,"void (*HostSFRHook)(unsigned char IsXSFR,unsigned short Addr);\n\n");
+	fprintf(Src,"//SFR\n");
+	fprintf(Src,"volatile HostSFRDef *HostSFR_Access(unsigned char Addr)\n\t{\n");
+	fprintf(Src,"\tif(HostSFRHook)HostSFRHook(0,Addr);\n\treturn &HostSFR[Addr];\n\t}\n\n");
+	fprintf(Src,"//xdataӳĴ\n");
+	fprintf(Src,"volatile unsigned char *HostXSFR_Access(unsigned short Addr)\n\t{\n");
+	fprintf(Src,"\tif(HostSFRHook)HostSFRHook(1,Addr);\n\treturn &HostXSFR[Addr-HostXSFRBase];\n\t}\n\n");
+	fprintf(Src,"//̼Ŀļ-fsanitize-coverage=trace-pc׮ʱʹ÷ĲԳջص\n");
+	fprintf(Src,"__attribute__((weak)) void __sanitizer_cov_trace_pc(void)\n\t{\n\t}\n");
+	}
+
+//˿ΪĴʱĶ(λͷļ֮⣬HostSFRPortAsRAM֮ٴΰʱЧ)
+static void PrintPortAsRAM(FILE *Hdr,char Port[][8],const unsigned int *PortAddr,int PortCount)
+	{
+	int i;
+	fprintf(Hdr,"\n//˿ΪĴ(ֻHostSFR.cHostGPIO.cʹ)\n");
+	fprintf(Hdr,"#if defined(HostSFRPortAsRAM)&&!defined(HostSFRPortAsRAMDone)\n");
+	fprintf(Hdr,"#define HostSFRPortAsRAMDone\n");
+	for(i=0;i<PortCount;i++)fprintf(Hdr,"#undef %s\n#define %s (HostSFR_Access(0x%02X)->Byte)\n",Port[i],Port[i],PortAddr[i]);
+	fprintf(Hdr,"#endif\n");
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+int main(int argc,char *argv[])
+	{
+	FILE *fp,*Hdr,*Src;
+	char Line[LineBufSize],Name[64],Ref[64];
+	char Port[MaxPortCount][8];
+	unsigned int PortAddr[MaxPortCount];
+	unsigned int Addr,Bit;
+	int IsSFRDefDone=0,IsXSFRDone=0,IsStdIntDone=0,Count=0,PortCount=0,RefAddr;
+	//򿪳ͷļļ
+	if(argc!=4)
+		{
+		fprintf(stderr,"÷SFRHostGen <cms8s6990.h> <ͷļ> <HostSFR.c>\n");
+		return 1;
+		}
+	fp=fopen(argv[1],"r");
+	Hdr=fopen(argv[2],"w");
+	Src=fopen(argv[3],"w");
+	if(fp==NULL||Hdr==NULL||Src==NULL)
+		{
+		fprintf(stderr,"޷ļ\n");
+		return 1;
+		}
+	PrintBanner(Hdr,"cms8s6990.h",argv[1],"PCϱ̼Դļ");
+	PrintBanner(Src,"HostSFR.c",argv[1],"ΪPC汾cms8s6990.hȫĴ洢ռ䲢ʵַʺ\nмĴϵʱΪ0ԳֱӶдĴģӲ״̬ļʱ\nܴиʲ׮");
+	fprintf(Src,"#define HostSFRPortAsRAM\n#include \"inc/cms8s6990.h\"\n\n");
+	//ת
+	while(fgets(Line,sizeof(Line),fp)!=NULL)
+		{
+		//һsfrĴ֮ǰ洢
+		if(!IsSFRDefDone&&sscanf(Line," sfr %63[A-Za-z0-9_] = %x ;",Name,&Addr)==2)
+			{
+			PrintSFRDef(Hdr,Src);
+			IsSFRDefDone=1;
+			}
+		//sfrĴ
+		if(sscanf(Line," sfr %63[A-Za-z0-9_] = %x ;",Name,&Addr)==2)
+			{
+			if(Addr>0xFF||SFRCount>=MaxSFRCount||strlen(Name)>=sizeof(SFRTable[0].Name))
+				{
+				fprintf(stderr,"Ĵ%s޷ת\n",Name);
+				return 1;
+				}
+			strcpy(SFRTable[SFRCount].Name,Name);
+			SFRTable[SFRCount++].Addr=Addr;
+			if(IsPortSFR(Name)&&PortCount<MaxPortCount)
+				{
+				fprintf(Hdr,"#define %s 0x%02X //˿ĬΪù̼sbitԱ\n",Name,Addr);
+				strcpy(Port[PortCount],Name);
+				PortAddr[PortCount++]=Addr;
+				}
+			else fprintf(Hdr,"#define %s (HostSFR_Access(0x%02X)->Byte)\n",Name,Addr);
+			Count++;
+			}
+		//sbitλĴ
+		else if(sscanf(Line," sbit %63[A-Za-z0-9_] = %63[A-Za-z0-9_] ^ %u ;",Name,Ref,&Bit)==3)
+			{
+			RefAddr=FindSFRAddr(Ref);
+			if(RefAddr<0||Bit>7)
+				{
+				fprintf(stderr,"λĴ%sļĴ%s\n",Name,Ref);
+				return 1;
+				}
+			fprintf(Hdr,"#define %s (HostSFR_Access(0x%02X)->Bit.B%u) //%s^%u\n",Name,RefAddr,Bit,Ref,Bit);
+			Count++;
+			}
+		//xdataӳļĴ
+		else if(sscanf(Line," #define %63[A-Za-z0-9_] *(volatile unsigned char xdata *) %x",Name,&Addr)==2)
+			{
+			if(Addr<XSFRBase||Addr>=XSFRBase+XSFRSize)
+				{
+				fprintf(stderr,"Ĵ%sĵַ0x%04XΧ\n",Name,Addr);
+				return 1;
+				}
+			if(!IsXSFRDone)
+				{
+				fprintf(Hdr,"//xdataӳļĴ\n");
+				IsXSFRDone=1;
+				}
+			fprintf(Hdr,"#define %s (*HostXSFR_Access(0x%04X))\n",Name,Addr);
+			Count++;
+			}
+		//ͣһͶ滻Ϊ׼ͷļɾ
+		else if(IsStdIntTypedef(Line))
+			{
+			if(!IsStdIntDone)fprintf(Hdr,"#include <stdint.h> //PCʹñ׼Ķ(ȺC51ͬ)\n");
+			IsStdIntDone=1;
+			}
+		//ж
+		else if(sscanf(Line," #define %63[A-Za-z0-9_] %u",Name,&Addr)==2&&strstr(Name,"_VECTOR")!=NULL)
+			fprintf(Hdr,"#define %s /*%u*/\n",Name,Addr);
+		//ԭ
+		else fputs(Line,Hdr);
+		}
+	PrintPortAsRAM(Hdr,Port,PortAddr,PortCount);
+	fclose(fp);
+	fclose(Hdr);
+	fclose(Src);
+	fprintf(stderr,"ת%dĴ\n",Count);
+	return 0;
+	}
@@ -0,0 +1,495 @@
+/****************************************************************************/
+/** \file SimCore.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļLaserSimںˣʱƽĴд⡢
+ʱT0/T1/T2жϷַSTOP˯Լλ
+
+ʱ䣺̼Ŀļʹ-fsanitize-coverage=trace-pc룬ÿִ֮ǰ
+__sanitizer_cov_trace_pcѷʱƽCyclePerBlockʱ(Ĭ240.5uS
+ʹ-cpbʵѭٶУ׼)Ȼڵ¼жϡжϴ
+ֻڻı߽ϱãC51һһCڵĶд
+
+Ĵд⣺HostSFR_AccessÿηSFR֮ǰSimCore_Hook±ʵ
+ַһηʻһ鿪ʼʱȽϼĴֵӰֵһ˵̼д
+ĴٽӦ账дĴ(I2CMCR)账֮ѼĴ
+ָΪ״ֵ̬״ֵ̬κֵͬظдͬһҲԱ⵽ȡ
+ʱ֮ǰȰѵǰֵͬĴڡ
+
+жϣ8051ĹΪߵȼͬһȼڰжŴСѯT0T1
+־ڽжʱӲı־жϴ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include "HostSim.h"
+#include <stdlib.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/time.h>
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+#define SimISRCycles 40 //˳жϵĿ(ѹջLCALLRETIʱ)
+#define SimMaxPending 16 //μ֮¼ļĴʴ
+#define SimTimerCount 3 //T0T1T2
+#define SimStallCheckUS 200000 //ѭļ(CPUʱ䣬uS)
+
+/****************************************************************************/
+/*	Local type definitions('typedef')
+****************************************************************************/
+typedef struct
+	{
+	_Bool IsRun;				//ʱڼ
+	SimTimeDef Base;			//ʼʱ
+	unsigned int BaseCount;		//ʼʱļֵ
+	unsigned int Div;			//ʱӵķƵ
+	unsigned char TH,TL;		//Ĵĵַ
+	}SimTimerDef;
+
+typedef struct
+	{
+	unsigned char Vector;		//ж
+	void (*Handler)(void);		//жϴ
+	}SimIRQDef;
+
+/****************************************************************************/
+/*	External function prototypes(̼ڵжϴ)
+****************************************************************************/
+extern void Timer0_IRQHandler(void) __attribute__((weak));
+extern void Timer1_IRQHandler(void) __attribute__((weak));
+extern void Timer2_IRQHandler(void) __attribute__((weak));
+extern void Key_IRQHandler(void) __attribute__((weak));
+extern void PWM_IRQHandler(void) __attribute__((weak));
+extern void ADC_IRQHandler(void) __attribute__((weak));
+extern void I2C_IRQHandler(void) __attribute__((weak));
+
+/****************************************************************************/
+/*	Global variable definitions(declared in header file with 'extern')
+****************************************************************************/
+SimParamDef SimParam;
+SimStateDef *Sim;
+FILE *SimTrace;
+
+/****************************************************************************/
+/*	Local variable  definitions('static')
+****************************************************************************/
+static _Bool IsSimActive; //̼ڷ
+static SimTimeDef EventTime[SimEv_Count];
+static SimTimeDef NextEvent=SimNever;
+static unsigned char Shadow[256]; //ĴӰֵ
+static _Bool IsWatched[256]; //ҪдļĴ
+static unsigned char PendingAddr[SimMaxPending];
+static int PendingCount;
+static unsigned char IRQLevel; //ִежȼ(0=ѭ1=ȼ2=ȼ)
+static _Bool IsInStop; //STOP˯
+static SimTimerDef Timer[SimTimerCount];
+static SimTimeDef StallNow; //һοѭʱķʱ
+
+static const SimIRQDef IRQTable[]=
+	{
+	{1,Timer0_IRQHandler},
+	{3,Timer1_IRQHandler},
+	{5,Timer2_IRQHandler},
+	{8,Key_IRQHandler},
+	{18,PWM_IRQHandler},
+	{19,ADC_IRQHandler},
+	{21,I2C_IRQHandler}
+	};
+
+#define IRQCount (int)(sizeof(IRQTable)/sizeof(SimIRQDef))
+
+static const unsigned char WatchList[]=
+	{
+	SFR_PCON,SFR_TCON,SFR_TL0,SFR_TL1,SFR_TH0,SFR_TH1,SFR_WDCON,SFR_EIF2,SFR_WUTCRH,
+	SFR_T2CON,SFR_TL2,SFR_TH2,SFR_ADCON0,SFR_I2CMCR,SFR_MCTRL
+	};
+
+/****************************************************************************/
+/*	Function implementation - local('static')
+****************************************************************************/
+//¼¼ʱ
+static void UpdateNextEvent(void)
+	{
+	int i;
+	NextEvent=SimNever;
+	for(i=0;i<SimEv_Count;i++)if(EventTime[i]<NextEvent)NextEvent=EventTime[i];
+	}
+
+//ʱĵǰֵ
+static unsigned int TimerCount(const SimTimerDef *T)
+	{
+	if(!T->IsRun)return ((unsigned int)SimSFR(T->TH)<<8)|SimSFR(T->TL);
+	return (T->BaseCount+(unsigned int)((Sim->Now-T->Base)/T->Div))&0xFFFF;
+	}
+
+//ѶʱĵǰֵдĴ
+static void TimerSync(SimTimerDef *T)
+	{
+	unsigned int Count=TimerCount(T);
+	SimSFR_Set(T->TH,(unsigned char)(Count>>8));
+	SimSFR_Set(T->TL,(unsigned char)Count);
+	}
+
+//ռĴڵļֵʼ¼
+static void TimerStart(int Idx)
+	{
+	SimTimerDef *T=&Timer[Idx];
+	switch(Idx)
+		{
+		case 0:T->Div=SimSFR(SFR_CKCON)&0x08?4:12;break;
+		case 1:T->Div=SimSFR(SFR_CKCON)&0x10?4:12;break;
+		default:T->Div=SimSFR(SFR_T2CON)&0x80?24:12;break;
+		}
+	T->BaseCount=((unsigned int)SimSFR(T->TH)<<8)|SimSFR(T->TL);
+	T->Base=Sim->Now;
+	T->IsRun=1;
+	SimEvent_Set((SimEventDef)(SimEv_T0+Idx),T->Base+(SimTimeDef)(0x10000-T->BaseCount)*T->Div);
+	}
+
+//ֵֹͣڼĴ
+static void TimerStop(int Idx)
+	{
+	SimTimerDef *T=&Timer[Idx];
+	if(!T->IsRun)return;
+	TimerSync(T);
+	T->IsRun=0;
+	SimEvent_Set((SimEventDef)(SimEv_T0+Idx),SimNever);
+	}
+
+//ʱλ־֮(T2װؼĴʼ)
+static void TimerOverflow(int Idx)
+	{
+	SimTimerDef *T=&Timer[Idx];
+	if(!T->IsRun)return;
+	T->Base=EventTime[SimEv_T0+Idx]!=SimNever?EventTime[SimEv_T0+Idx]:Sim->Now;
+	switch(Idx)
+		{
+		case 0:T->BaseCount=0;SimSFR_Set(SFR_TCON,SimSFR(SFR_TCON)|0x20);break;
+		case 1:T->BaseCount=0;SimSFR_Set(SFR_TCON,SimSFR(SFR_TCON)|0x80);break;
+		default:
+			T->BaseCount=((unsigned int)SimSFR(SFR_RLDH)<<8)|SimSFR(SFR_RLDL);
+			SimSFR_Set(SFR_T2IF,SimSFR(SFR_T2IF)|0x80);
+			break;
+		}
+	SimEvent_Set((SimEventDef)(SimEv_T0+Idx),T->Base+(SimTimeDef)(0x10000-T->BaseCount)*T->Div);
+	}
+
+//ڵ¼
+static void RunEvents(void)
+	{
+	int i,Ev;
+	SimTimeDef When;
+	while(NextEvent<=Sim->Now)
+		{
+		//ȡ¼
+		Ev=0;
+		for(i=1;i<SimEv_Count;i++)if(EventTime[i]<EventTime[Ev])Ev=i;
+		When=EventTime[Ev];
+		switch(Ev)
+			{
+			case SimEv_T0:
+			case SimEv_T1:
+			case SimEv_T2:
+				TimerOverflow(Ev-SimEv_T0);
+				if(EventTime[Ev]==When)SimEvent_Set((SimEventDef)Ev,SimNever);
+				break;
+			case SimEv_Plant:
+				SimEvent_Set(SimEv_Plant,SimNever);
+				SimPlant_Event();
+				break;
+			case SimEv_Script:
+				SimEvent_Set(SimEv_Script,SimNever);
+				SimScript_Event();
+				break;
+			default:
+				SimEvent_Set((SimEventDef)Ev,SimNever);
+				SimPeriph_Event((SimEventDef)Ev);
+				break;
+			}
+		}
+	}
+
+//жԴǷδ
+static _Bool IRQIsPending(unsigned char Vector)
+	{
+	switch(Vector)
+		{
+		case 1:return (SimSFR(SFR_TCON)&0x20)&&(SimSFR(SFR_IE)&0x02);
+		case 3:return (SimSFR(SFR_TCON)&0x80)&&(SimSFR(SFR_IE)&0x08);
+		case 5:return (SimSFR(SFR_T2IF)&0x80)&&(SimSFR(SFR_T2IE)&0x80)&&(SimSFR(SFR_IE)&0x20);
+		case 8:return (SimSFR(SFR_P1EXTIF)&SimSFR(SFR_P1EXTIE))!=0;
+		case 18:return (SimXSFR(XSFR_PWMPIF)&SimXSFR(XSFR_PWMPIE)&0x3F)&&(SimSFR(SFR_EIE2)&0x08);
+		case 19:return (SimSFR(SFR_EIF2)&0x10)&&(SimSFR(SFR_EIE2)&0x10);
+		case 21:return (SimSFR(SFR_I2CMCR)&0x80)&&(SimSFR(SFR_EIE2)&0x40);
+		default:return 0;
+		}
+	}
+
+//жϵȼ(1=ͣ2=)ȼĴλ7֮Ŵ1
+static unsigned char IRQPriority(unsigned char Vector)
+	{
+	unsigned char Module=Vector<7?Vector:Vector+1;
+	unsigned char Reg=Module<8?SimSFR(SFR_IP):Module<16?SimSFR(SFR_EIP1):SimSFR(SFR_EIP2);
+	return Reg&(1<<(Module&0x07))?2:1;
+	}
+
+//鲢ִж
+static void IRQDispatch(void)
+	{
+	int i,Best;
+	unsigned char Level,BestLevel,Save;
+	while((SimSFR(SFR_IE)&0x80)&&IRQLevel<2)
+		{
+		//ȼߵ
+		Best=-1;
+		BestLevel=0;
+		for(i=0;i<IRQCount;i++)
+			{
+			if(!IRQIsPending(IRQTable[i].Vector))continue;
+			Level=IRQPriority(IRQTable[i].Vector);
+			if(Level>IRQLevel&&Level>BestLevel)
+				{
+				Best=i;
+				BestLevel=Level;
+				}
+			}
+		if(Best<0)return;
+		if(IRQTable[Best].Handler==NULL)SimCore_Fatal("interrupt without handler");
+		//T0T1־Ӳڽжʱ
+		if(IRQTable[Best].Vector==1)SimSFR_Set(SFR_TCON,SimSFR(SFR_TCON)&0xDF);
+		if(IRQTable[Best].Vector==3)SimSFR_Set(SFR_TCON,SimSFR(SFR_TCON)&0x7F);
+		//ִжϴ
+		Save=IRQLevel;
+		IRQLevel=BestLevel;
+		Sim->Now+=SimISRCycles;
+		IRQTable[Best].Handler();
+		IRQLevel=Save;
+		}
+	}
+
+//STOP˯ߣϵͳʱֱֹͣఴжϻ߻Ѷʱ
+static void EnterStop(void)
+	{
+	SimTimeDef Frozen[SimEv_MCUCount],Start=Sim->Now,Delta;
+	int i;
+	//ͬʱֵϵͳʱӵ¼
+	for(i=0;i<SimTimerCount;i++)if(Timer[i].IsRun)TimerSync(&Timer[i]);
+	for(i=0;i<SimEv_MCUCount;i++)
+		{
+		Frozen[i]=EventTime[i];
+		EventTime[i]=SimNever;
+		}
+	UpdateNextEvent();
+	IsInStop=1;
+	if(SimParam.IsVerbose)printf("LaserSim: STOP at %.6fs\n",SimToSec(Start));
+	//ֻбض󡢽űͻѶʱֱ
+	while(!(SimSFR(SFR_P1EXTIF)&SimSFR(SFR_P1EXTIE))&&IsInStop)
+		{
+		if(NextEvent==SimNever)SimCore_Fatal("STOP without any wake-up source");
+		Sim->Now=NextEvent;
+		RunEvents();
+		}
+	IsInStop=0;
+	//ָϵͳʱӣ¼Ͷʱ˳˯ߵʱ
+	Delta=Sim->Now-Start;
+	for(i=0;i<SimEv_MCUCount;i++)EventTime[i]=Frozen[i]==SimNever?SimNever:Frozen[i]+Delta;
+	for(i=0;i<SimTimerCount;i++)Timer[i].Base+=Delta;
+	Sim->Meas.LoopLast+=Delta; //˯ߵʱ䲻ѭĵȦʱ
+	UpdateNextEvent();
+	SimSFR_Set(SFR_PCON,SimSFR(SFR_PCON)&0xF9);
+	if(SimParam.IsVerbose)printf("LaserSim: wake up at %.6fs\n",SimToSec(Sim->Now));
+	}
+
+//Ĵд
+static void HandleWrite(unsigned char Addr,unsigned char Old,unsigned char New)
+	{
+	switch(Addr)
+		{
+		case SFR_TCON:
+			if((New^Old)&0x10)
+				{
+				if(New&0x10)TimerStart(0);
+				else TimerStop(0);
+				}
+			if((New^Old)&0x40)
+				{
+				if(New&0x40)TimerStart(1);
+				else TimerStop(1);
+				}
+			break;
+		case SFR_TH0:
+		case SFR_TL0:if(Timer[0].IsRun)TimerStart(0);break;
+		case SFR_TH1:
+		case SFR_TL1:if(Timer[1].IsRun)TimerStart(1);break;
+		case SFR_TH2:
+		case SFR_TL2:if(Timer[2].IsRun)TimerStart(2);break;
+		case SFR_T2CON:
+			if((New&0x03)&&!Timer[2].IsRun)TimerStart(2);
+			else if(!(New&0x03))TimerStop(2);
+			break;
+		case SFR_EIF2:SimSFR_Set(SFR_EIF2,Old&New);break; //д0д1Ӱ
+		case SFR_PCON:if(New&0x02)EnterStop();break;
+		case SFR_WDCON:if(New&0x80)SimCore_Exit(SimExit_Reset);break; //λ
+		case SFR_WUTCRH:SimWUT_Write();break;
+		default:SimPeriph_Write(Addr,Old,New);break;
+		}
+	}
+
+//һη֮дļĴ
+static void DetectWrite(void)
+	{
+	int i,Count=PendingCount;
+	unsigned char Addr,Old,New;
+	PendingCount=0;
+	for(i=0;i<Count;i++)
+		{
+		Addr=PendingAddr[i];
+		Old=Shadow[Addr];
+		New=SimSFR(Addr);
+		if(New==Old)continue;
+		Shadow[Addr]=New;
+		HandleWrite(Addr,Old,New);
+		}
+	}
+
+//Ĵʻصڹ̼ʼĴ֮ǰ
+static void SimCore_Hook(unsigned char IsXSFR,unsigned short Addr)
+	{
+	if(!IsSimActive)return;
+	if(PendingCount)DetectWrite();
+	if(IsXSFR||!IsWatched[Addr])return;
+	//ȡʱֵ֮ǰͬ
+	switch(Addr)
+		{
+		case SFR_TH0:case SFR_TL0:if(Timer[0].IsRun)TimerSync(&Timer[0]);break;
+		case SFR_TH1:case SFR_TL1:if(Timer[1].IsRun)TimerSync(&Timer[1]);break;
+		case SFR_TH2:case SFR_TL2:if(Timer[2].IsRun)TimerSync(&Timer[2]);break;
+		default:break;
+		}
+	if(PendingCount<SimMaxPending)PendingAddr[PendingCount++]=(unsigned char)Addr;
+	}
+
+//ѭ⡣gccûκѭ(λ֮while(1);)׮ѭ
+//ڷʱ䲻ƽﶨڼʱ䣬ûƽʱȴûмļĴд
+//(λͨЧ)Ȼû˳˵̼
+static void StallCheck(int Sig)
+	{
+	(void)Sig;
+	if(!IsSimActive)return;
+	if(Sim->Now!=StallNow)
+		{
+		StallNow=Sim->Now;
+		return;
+		}
+	if(PendingCount)DetectWrite();
+	SimCore_Fatal("firmware stuck in a loop without basic blocks");
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+//׮صƽʱ䲢¼ж
+void __sanitizer_cov_trace_pc(void)
+	{
+	if(!IsSimActive)return;
+	Sim->Now+=SimParam.CyclePerBlock;
+	if(PendingCount)DetectWrite();
+	if(Sim->Now>=NextEvent)RunEvents();
+	if(IRQLevel<2&&(SimSFR(SFR_IE)&0x80))IRQDispatch();
+	}
+
+//¼ʱ(SimNeverʾȡ)
+void SimEvent_Set(SimEventDef Ev,SimTimeDef When)
+	{
+	EventTime[Ev]=When;
+	if(When<NextEvent)NextEvent=When;
+	else UpdateNextEvent();
+	}
+
+//ȡ¼ʱ
+SimTimeDef SimEvent_Get(SimEventDef Ev)
+	{
+	return EventTime[Ev];
+	}
+
+//޸ļĴͬʱӰֵ(ᱻ̼д)
+void SimSFR_Set(unsigned char Addr,unsigned char Value)
+	{
+	SimSFR(Addr)=Value;
+	Shadow[Addr]=Value;
+	}
+
+//ѶʱڣSTOP˯
+void SimCore_WakeUp(void)
+	{
+	IsInStop=0;
+	}
+
+//ϵ߸λ֮ʼƬʼ
+void SimCore_Boot(void)
+	{
+	struct itimerval Stall;
+	int i;
+	//Ĵλֵ(ûй̼мĴ͹̼ϵ״̬)
+	SimSFR(SFR_SP)=0x07;
+	SimSFR(SFR_I2CMCR)=0x20; //I2Cؿ
+	memset(Shadow,0,sizeof(Shadow));
+	for(i=0;i<256;i++)Shadow[i]=SimSFR(i);
+	for(i=0;i<(int)sizeof(WatchList);i++)IsWatched[WatchList[i]]=1;
+	//̼sbitPCϳʼΪ1(Ĵַ)Ϊϵ״̬
+	DCDCEN=0;
+	LDMOSEN=0;
+	RLED=0;
+	GLED=0;
+	PWMDACPin=0;
+	PreChargeDACPin=0;
+	KeyPress=!Sim->IsKeyPressed;
+	//ʱ
+	Timer[0].TH=SFR_TH0;
+	Timer[0].TL=SFR_TL0;
+	Timer[1].TH=SFR_TH1;
+	Timer[1].TL=SFR_TL1;
+	Timer[2].TH=SFR_TH2;
+	Timer[2].TL=SFR_TL2;
+	//¼
+	for(i=0;i<SimEv_Count;i++)EventTime[i]=SimNever;
+	NextEvent=SimNever;
+	Sim->BootCount++;
+	Sim->In.IsMCUOn=1;
+	SimPeriph_Boot();
+	SimEvent_Set(SimEv_Plant,Sim->Now);
+	SimEvent_Set(SimEv_Script,Sim->ScriptWake>Sim->Now?Sim->ScriptWake:Sim->Now);
+	//ʼ
+	HostSFRHook=SimCore_Hook;
+	IsSimActive=1;
+	//ѭ
+	StallNow=SimNever;
+	memset(&Stall,0,sizeof(Stall));
+	signal(SIGVTALRM,StallCheck);
+	Stall.it_interval.tv_usec=SimStallCheckUS;
+	Stall.it_value.tv_usec=SimStallCheckUS;
+	setitimer(ITIMER_VIRTUAL,&Stall,NULL);
+	}
+
+//Уص
+void SimCore_Exit(SimExitDef Code)
+	{
+	IsSimActive=0;
+	SimPlant_Sync();
+	Sim->In.IsMCUOn=0;
+	fflush(stdout);
+	if(SimTrace!=NULL)fflush(SimTrace);
+	_exit((int)Code);
+	}
+
+//ڲ
+void SimCore_Fatal(const char *Msg)
+	{
+	printf("LaserSim: %s at %.6fs\n",Msg,SimToSec(Sim->Now));
+	SimCore_Exit(SimExit_Fail);
+	}
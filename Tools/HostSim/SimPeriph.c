@@ -0,0 +1,375 @@
+/****************************************************************************/
+/** \file SimPeriph.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļLaserSimģ̼ͣõADCPWMI2Cء
+FlashఴⲿжϺͻѶʱ(WUT)ʱֵ棺
+	PWM      ʱΪFsysPWMPx+1ʱӵڲڱ߽¼PWMLOADEN
+	         ڱ߽װռձȲӲ㣬ͨ0ڱ߽λPWMPIF
+	ADC      ÿת16ADCʱӣADCʱΪFsys/2^(ADCKS+1)תλEIF2ADCIF
+	I2C      400KHzÿֽ(Ӧλ)9SCLʱӣʼλֹͣλ1ʱӼ
+	Flash    ȡɣд30uS4mS(ֵΪֵҪֲ)
+	WUT      ʱΪ125KHzʱʱ=ֵxƵx8uS
+PWMDACŵ(ռձȻGPIOƽ)ɱضģȡͨRC˲õDACѹ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include "HostSim.h"
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+#define PWMIdlePoll SimUS(100) //PWMرʱǷѾļ
+#define ADCConvClock 16 //ÿתADCʱ
+#define I2CBitTime SimUS(2.5) //SCL(400KHz)
+#define FlashWriteTime SimUS(30)
+#define FlashEraseTime SimMS(4)
+#define FlashSectorSize 512
+
+//I2C״̬Ĵ(I2CMSR)
+#define I2CSR_IF 0x80
+#define I2CSR_BusBusy 0x40
+#define I2CSR_Idle 0x20
+#define I2CSR_DataNAK 0x08
+#define I2CSR_AddrNAK 0x04
+#define I2CSR_Error 0x02
+#define I2CSR_Busy 0x01
+
+//I2CĴ(I2CMCR)
+#define I2CCR_RST 0x80
+#define I2CCR_ACK 0x08
+#define I2CCR_STOP 0x04
+#define I2CCR_START 0x02
+#define I2CCR_RUN 0x01
+
+/****************************************************************************/
+/*	Local type definitions('typedef')
+****************************************************************************/
+typedef struct
+	{
+	unsigned int Duty;			//ǰʹõռձ
+	unsigned int Period;		//ǰڵĳ(ֵ)
+	SimEventDef Ev;				//ڱ߽¼
+	unsigned short PL,DL;		//ںռձȼĴĵַ
+	unsigned char Msk;			//ͨPWMCNTEȼĴڵbit
+	}SimPWMChDef;
+
+/****************************************************************************/
+/*	Local variable  definitions('static')
+****************************************************************************/
+static SimPWMChDef PWMCh[2]=
+	{
+	{0,0,SimEv_PWM0,XSFR_PWMP0L,XSFR_PWMD0L,0x01},
+	{0,0,SimEv_PWM4,XSFR_PWMP4L,XSFR_PWMD4L,0x10}
+	};
+
+//I2C
+static unsigned char I2CStatus; //״̬Ĵֵ(IF)
+static _Bool IsI2CBusOwned; //Ѿʼλ߱ռ
+static _Bool IsI2CRead; //ǰ䷽Ϊȡ
+static _Bool IsI2CRegPhase; //д봫ĵһΪĴַ
+static _Bool IsI2CSlaveACK; //ӻԵַӦ
+static unsigned char I2CRegPtr; //ӻļĴַָ
+static unsigned char I2CRxData; //дI2CMBUF
+static _Bool IsI2CStopOnly; //ǰֹֻͣλ
+
+//Flash
+static unsigned char FlashOp;
+
+/****************************************************************************/
+/*	Function implementation - local('static')
+****************************************************************************/
+//ȡ16bitxdataĴ(ֽǰ)
+static unsigned int XSFR16(unsigned short AddrL)
+	{
+	return SimXSFR(AddrL)|((unsigned int)SimXSFR(AddrL+1)<<8);
+	}
+
+//PWMڱ߽磬װռձȲһ
+static void PWMBoundary(SimPWMChDef *Ch)
+	{
+	if(!(SimXSFR(XSFR_PWMCNTE)&Ch->Msk))
+		{
+		SimEvent_Set(Ch->Ev,Sim->Now+PWMIdlePoll);
+		return;
+		}
+	//װռձ(װϺӲPWMLOADEN)
+	if(SimXSFR(XSFR_PWMLOADEN)&Ch->Msk)
+		{
+		Ch->Duty=XSFR16(Ch->DL);
+		SimXSFR(XSFR_PWMLOADEN)&=~Ch->Msk;
+		}
+	Ch->Period=XSFR16(Ch->PL)+1;
+	SimXSFR(XSFR_PWMPIF)|=Ch->Msk;
+	SimEvent_Set(Ch->Ev,Sim->Now+Ch->Period);
+	}
+
+//I2Cɣλжϱ־
+static void I2CComplete(void)
+	{
+	if(IsI2CStopOnly)
+		{
+		//ֹͣλϣ߿
+		IsI2CBusOwned=0;
+		I2CStatus=(I2CStatus&(I2CSR_Error|I2CSR_AddrNAK|I2CSR_DataNAK))|I2CSR_Idle;
+		SimSFR_Set(SFR_I2CMCR,I2CStatus|(SimSFR(SFR_I2CMCR)&I2CSR_IF));
+		return;
+		}
+	if(IsI2CRead&&!(I2CStatus&I2CSR_Error))SimSFR_Set(SFR_I2CMBUF,I2CRxData);
+	SimSFR_Set(SFR_I2CMCR,I2CStatus|I2CSR_IF);
+	}
+
+//ִI2CҪʱ
+static SimTimeDef I2CCommand(unsigned char Cmd)
+	{
+	SimTimeDef Bits=0;
+	unsigned char Addr;
+	I2CStatus=I2CSR_BusBusy;
+	IsI2CStopOnly=0;
+	//ʼλ͵ַ
+	if(Cmd&I2CCR_START)
+		{
+		Addr=SimSFR(SFR_I2CMSA);
+		IsI2CRead=Addr&0x01;
+		IsI2CRegPhase=!IsI2CRead;
+		IsI2CBusOwned=1;
+		IsI2CSlaveACK=(Addr>>1)==0x62&&SimSC8721_IsACK();
+		Bits+=10;
+		if(!IsI2CSlaveACK)
+			{
+			I2CStatus|=I2CSR_Error|I2CSR_AddrNAK;
+			return Bits*I2CBitTime;
+			}
+		}
+	//һֽ
+	if(Cmd&I2CCR_RUN)
+		{
+		Bits+=9;
+		if(!IsI2CBusOwned||!IsI2CSlaveACK||!SimSC8721_IsACK())
+			{
+			//ӻûбռ
+			I2CStatus|=I2CSR_Error|I2CSR_DataNAK;
+			return Bits*I2CBitTime;
+			}
+		if(IsI2CRead)I2CRxData=SimSC8721_Read(I2CRegPtr++);
+		else if(IsI2CRegPhase)
+			{
+			I2CRegPtr=SimSFR(SFR_I2CMBUF);
+			IsI2CRegPhase=0;
+			}
+		else SimSC8721_Write(I2CRegPtr++,SimSFR(SFR_I2CMBUF));
+		}
+	//ֹͣλ
+	if((Cmd&I2CCR_STOP)&&!(Cmd&(I2CCR_START|I2CCR_RUN)))
+		{
+		IsI2CStopOnly=1;
+		Bits+=1;
+		}
+	return Bits*I2CBitTime;
+	}
+
+//I2CĴд
+static void I2CWrite(unsigned char Old,unsigned char New)
+	{
+	SimTimeDef Time;
+	//д0x00жϱ־
+	if(!New)
+		{
+		SimSFR_Set(SFR_I2CMCR,Old&~I2CSR_IF);
+		return;
+		}
+	//ģ鸴λ
+	if(New&I2CCR_RST)
+		{
+		IsI2CBusOwned=0;
+		IsI2CStopOnly=0;
+		SimEvent_Set(SimEv_I2C,SimNever);
+		SimSFR_Set(SFR_I2CMCR,I2CSR_Idle);
+		return;
+		}
+	//һβûɣԱ
+	if(SimEvent_Get(SimEv_I2C)!=SimNever)
+		{
+		if(SimParam.IsVerbose)printf("LaserSim: I2C command 0x%02X while busy at %.6fs\n",New,SimToSec(Sim->Now));
+		SimSFR_Set(SFR_I2CMCR,Old);
+		return;
+		}
+	//ʼִУ֮ǰ״̬Ϊæ
+	Time=I2CCommand(New);
+	SimSFR_Set(SFR_I2CMCR,(Old&I2CSR_IF)|I2CSR_BusBusy|I2CSR_Busy);
+	SimEvent_Set(SimEv_I2C,Sim->Now+Time);
+	}
+
+//ADCʼת
+static void ADCStart(void)
+	{
+	unsigned char KS=(SimSFR(SFR_ADCON1)>>4)&0x07;
+	if(!(SimSFR(SFR_ADCON1)&0x80))
+		{
+		//ADCûʹܣתῪʼ
+		SimSFR_Set(SFR_ADCON0,SimSFR(SFR_ADCON0)&0xFD);
+		return;
+		}
+	SimEvent_Set(SimEv_ADC,Sim->Now+((SimTimeDef)ADCConvClock<<(KS+1)));
+	}
+
+//ADCת
+static void ADCComplete(void)
+	{
+	unsigned char Ch=((SimSFR(SFR_ADCON0)&0x80)>>3)|(SimSFR(SFR_ADCON1)&0x0F);
+	double VRef,Code;
+	unsigned int Result;
+	static const double VSel[4]={1.2,2.0,2.4,3.0};
+	//׼ѹ
+	if(SimXSFR(XSFR_ADCLDO)&0x80)VRef=VSel[(SimXSFR(XSFR_ADCLDO)>>5)&0x03];
+	else VRef=SimPlant_VDD();
+	//ת
+	Code=SimPlant_ADCInput(Ch)*4096.0/VRef;
+	if(SimParam.ADCNoise>0)
+		{
+		Sim->ADCSeed=Sim->ADCSeed*1103515245u+12345u;
+		Code+=(((Sim->ADCSeed>>16)&0x7FFF)/32767.0-0.5)*SimParam.ADCNoise;
+		}
+	if(Code<0)Code=0;
+	Result=Code>4095?4095:(unsigned int)Code;
+	//дADFM=1ʱҶ
+	if(SimSFR(SFR_ADCON0)&0x40)
+		{
+		SimSFR_Set(SFR_ADRESH,(unsigned char)(Result>>8));
+		SimSFR_Set(SFR_ADRESL,(unsigned char)Result);
+		}
+	else
+		{
+		SimSFR_Set(SFR_ADRESH,(unsigned char)(Result>>4));
+		SimSFR_Set(SFR_ADRESL,(unsigned char)(Result<<4));
+		}
+	SimSFR_Set(SFR_ADCON0,SimSFR(SFR_ADCON0)&0xFD);
+	SimSFR_Set(SFR_EIF2,SimSFR(SFR_EIF2)|0x10);
+	}
+
+//Flashʼ
+static void FlashStart(unsigned char Op)
+	{
+	unsigned int Addr=(((unsigned int)SimSFR(SFR_MADRH)<<8)|SimSFR(SFR_MADRL))%SimFlashSize;
+	if(!(Op&0x01))return;
+	//Flashδִ
+	if(SimSFR(SFR_MLOCK)!=0xAA)
+		{
+		if(SimParam.IsVerbose)printf("LaserSim: flash operation 0x%02X while locked\n",Op);
+		SimSFR_Set(SFR_MCTRL,Op&0xFE);
+		return;
+		}
+	FlashOp=Op;
+	switch(Op)
+		{
+		case 0x11: //ȡ
+			SimSFR_Set(SFR_MDATA,Sim->Flash[Addr]);
+			SimSFR_Set(SFR_MCTRL,Op&0xFE);
+			break;
+		case 0x19: //д(ֻܰ1дΪ0)
+			Sim->Flash[Addr]&=SimSFR(SFR_MDATA);
+			SimEvent_Set(SimEv_Flash,Sim->Now+FlashWriteTime);
+			break;
+		case 0x1D: //
+			memset(&Sim->Flash[Addr&~(FlashSectorSize-1)],0xFF,FlashSectorSize);
+			SimEvent_Set(SimEv_Flash,Sim->Now+FlashEraseTime);
+			break;
+		default:
+			SimCore_Fatal("unknown flash operation");
+			break;
+		}
+	}
+
+//ѶʱĶʱʱ
+static SimTimeDef WUTPeriod(void)
+	{
+	static const unsigned int Div[4]={1,8,32,256};
+	unsigned int Count=((SimSFR(SFR_WUTCRH)&0x0F)<<8)|SimSFR(SFR_WUTCRL);
+	return SimUS(8ULL*Count*Div[(SimSFR(SFR_WUTCRH)>>4)&0x03]);
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+//ϵ縴λʼ״̬
+void SimPeriph_Boot(void)
+	{
+	int i;
+	for(i=0;i<2;i++)
+		{
+		PWMCh[i].Duty=0;
+		PWMCh[i].Period=0;
+		SimEvent_Set(PWMCh[i].Ev,Sim->Now+PWMIdlePoll);
+		}
+	I2CStatus=I2CSR_Idle;
+	IsI2CBusOwned=0;
+	IsI2CStopOnly=0;
+	}
+
+//¼
+void SimPeriph_Event(SimEventDef Ev)
+	{
+	switch(Ev)
+		{
+		case SimEv_PWM0:PWMBoundary(&PWMCh[0]);break;
+		case SimEv_PWM4:PWMBoundary(&PWMCh[1]);break;
+		case SimEv_ADC:ADCComplete();break;
+		case SimEv_I2C:I2CComplete();break;
+		case SimEv_Flash:SimSFR_Set(SFR_MCTRL,FlashOp&0xFE);break;
+		case SimEv_WUT:
+			//ѶʱڣSTOP˯߲ʼһ
+			SimCore_WakeUp();
+			if(SimSFR(SFR_WUTCRH)&0x80)SimEvent_Set(SimEv_WUT,Sim->Now+WUTPeriod());
+			break;
+		default:break;
+		}
+	}
+
+//̼дĴ
+void SimPeriph_Write(unsigned char Addr,unsigned char Old,unsigned char New)
+	{
+	switch(Addr)
+		{
+		case SFR_ADCON0:if((New&0x02)&&!(Old&0x02))ADCStart();break;
+		case SFR_I2CMCR:I2CWrite(Old,New);break;
+		case SFR_MCTRL:FlashStart(New);break;
+		default:break;
+		}
+	}
+
+//ȡPWMDACŵƽƽ(0~1)Ch=0ΪDAC(ͨ0)Ch=1ΪԤDAC(ͨ4)
+double SimPWM_Output(int Ch)
+	{
+	const SimPWMChDef *PCh=&PWMCh[Ch];
+	unsigned char Msk=PCh->Msk;
+	//PWMδãGPIOƽ
+	if(!(SimXSFR(XSFR_PWMCNTE)&Msk)||!(SimXSFR(XSFR_PWMOE)&Msk))return (Ch?PreChargeDACPin:PWMDACPin)?1.0:0.0;
+	//Σεƽ
+	if(SimXSFR(XSFR_PWMMASKE)&Msk)return SimXSFR(XSFR_PWMMASKD)&Msk?1.0:0.0;
+	if(!PCh->Period)return 0;
+	return PCh->Duty>=PCh->Period?1.0:(double)PCh->Duty/(double)PCh->Period;
+	}
+
+//ఴ״̬ı
+void SimKey_Set(_Bool IsPressed)
+	{
+	unsigned char Mode;
+	if(IsPressed==Sim->IsKeyPressed)return;
+	Sim->IsKeyPressed=IsPressed;
+	if(!Sim->In.IsMCUOn)return;
+	//ʱΪ͵ƽP13EICFGĴλжϱ־
+	KeyPress=!IsPressed;
+	Mode=SimXSFR(XSFR_P13EICFG)&0x03;
+	if((IsPressed&&(Mode&0x02))||(!IsPressed&&(Mode&0x01)))SimSFR_Set(SFR_P1EXTIF,SimSFR(SFR_P1EXTIF)|0x08);
+	}
+
+//ѶʱüĴд
+void SimWUT_Write(void)
+	{
+	if(!(SimSFR(SFR_WUTCRH)&0x80))SimEvent_Set(SimEv_WUT,SimNever);
+	else if(SimEvent_Get(SimEv_WUT)==SimNever)SimEvent_Set(SimEv_WUT,Sim->Now+WUTPeriod());
+	}
@@ -0,0 +1,355 @@
+/****************************************************************************/
+/** \file SimPlant.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļLaserSimıضģͣSC8721AļĴ͹ʼ
+PWMDACRC˲LD﮵ԼǺNTCģ͡
+
+ʼܿصѹԴⲿģʽCVעѹΪ
+	Vcv=6.1806*SS-1.5454*Vdac4(V)
+ǹ̼PreChargeDACCalcħʽķSSΪ𶯽ȡΪ
+CSOϵĺ׼
+	Iset=Vdac0*(200/177)*(1000/LDCurrentOffset)
+UccʼָѹΪmin(Vcv,Ucc)Ϊ(ָѹ-Vout)/RConv
+CSO_SETֵֵǯλ(ܷյ)ͨӲ水
+̼LDCurrentOffsetϵ׼ȷģ˵ֻԹ̼Ͷ
+
+ģбע""Ĳûоʵ⣬ֻڸֹ̼ʱͱ߼
+ȷLDİȫԣҪʵֵ滻ʱֻ޸ıļͷĺ궨弴ɡ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include "LDProfile.h"
+#include "HostSim.h"
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+//SC8721A(ֲֵĵֵ)
+#define SC8721PORTime 0.5e-3		//EN֮I2Cͨŵʱ()
+#define SC8721SoftStart 1e-3		//ʱ()
+#define SC8721UVLO 2.9				//Ƿѹѹ(V)
+#define SC8721CBCLimit 6.0			//ֵ(A)
+#define SC8721CSOFullScale 6.0		//CSO_SET=0xFFʱֵ(A)
+#define SC8721RConv 0.02			//ʼѹĵЧ迹()
+#define SC8721CCGain 12000.0		//(V/(A*s))
+#define SC8721CCHeadroom 0.1		//Voutֵ(V)Ŀǯλ
+#define SC8721VintFB 5.0			//ڲģʽѹ(V)
+#define SC8721CSODefault 0xFF		//CSO_SETϵĬֵ()
+
+//(ֵ)
+#define OutputCap 44e-6				//(F)
+#define OutputBleed 100e3			//˵йŵ(ѹȣ)
+#define CCDACTau 1e-3				//PWMDACRC˲ʱ䳣()
+#define CVDACTau 3e-3				//ԤPWMDACRC˲ʱ䳣()
+
+//LDͨѹͶ̬LDļ
+#define LDVth (LDThresholdVolt/1000.0)
+#define LDRd ((LDConstantVolt-LDThresholdVolt)/(double)LDILEDConstant)
+#define LDHeatFraction 0.8			//繦бΪı(ThermalBenchһ)
+
+//(ֵ)
+#define CellCapacity 3.0			//ڵ(Ah)
+#define CellRes 0.04				//ڵ()
+#define ConvEfficiency 0.9			//DCDCЧ
+#define MCUCurrent 0.005			//ƬָʾƵĹ(A)
+#define MCULDOOut 3.0				//ƬLDOѹ(V)
+#define MCULDODrop 0.15				//ƬLDOѹ(V)
+
+//NTCNTC.cĲұһ
+#define NTCR25 100e3
+#define NTCBeta 4250.0
+#define NTCPullUp 470e3
+
+//ֲ
+#define PlantStepActive 5e-6		//ʼʱĻֲ()
+#define PlantEventActive SimUS(20)	//ʼʱ¼
+#define PlantEventIdle SimMS(1)		//ʼʱ¼
+
+/****************************************************************************/
+/*	Local variable  definitions('static')
+****************************************************************************/
+//﮵ؿ·ѹ10%ɵ״̬
+static const double CellOCVTable[11]={3.00,3.45,3.60,3.68,3.74,3.79,3.85,3.92,4.00,4.08,4.20};
+
+//SC8721AĴϵĬֵ(0x00-0x0F)
+static const unsigned char SC8721Default[16]=
+	{
+	0x00,SC8721CSODefault,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x00
+	};
+
+/****************************************************************************/
+/*	Function implementation - local('static')
+****************************************************************************/
+//ݺɵ״̬㵥ڵصĿ·ѹ
+static double CellOCV(double SOC)
+	{
+	int i;
+	double x=SOC*10;
+	if(x<=0)return CellOCVTable[0];
+	if(x>=10)return CellOCVTable[10];
+	i=(int)x;
+	return CellOCVTable[i]+(CellOCVTable[i+1]-CellOCVTable[i])*(x-i);
+	}
+
+//ݵڵصĿ·ѹɵ״̬
+static double CellSOC(double OCV)
+	{
+	int i;
+	if(OCV<=CellOCVTable[0])return 0;
+	if(OCV>=CellOCVTable[10])return 1;
+	for(i=0;i<10;i++)if(OCV<CellOCVTable[i+1])break;
+	return (i+(OCV-CellOCVTable[i])/(CellOCVTable[i+1]-CellOCVTable[i]))/10.0;
+	}
+
+//SC8721AλĴָΪĬֵ
+static void SC8721Reset(SimPlantDef *Pt)
+	{
+	memcpy(Pt->Reg,SC8721Default,sizeof(Pt->Reg));
+	Pt->CSOActive=SC8721CSODefault;
+	Pt->Status1=0;
+	Pt->Status2=0;
+	Pt->IsRunning=0;
+	Pt->SSFrac=0;
+	}
+
+//һֲʱѹ(ʹʽŷLD͹ʼ迹Сʽֻ᲻ȶ)
+static double SolveVout(const SimPlantDef *Pt,double h,double IConv,_Bool IsConvVS,double VCmd,_Bool IsLDOn)
+	{
+	double G=1.0/OutputBleed,I=0,k=h/OutputCap;
+	if(IsConvVS)
+		{
+		G+=1.0/SC8721RConv;
+		I+=VCmd/SC8721RConv;
+		}
+	else I+=IConv;
+	if(IsLDOn)
+		{
+		G+=1.0/LDRd;
+		I+=LDVth/LDRd;
+		}
+	return (Pt->Vout+k*I)/(1+k*G);
+	}
+
+//һ
+static void PlantStep(SimPlantDef *Pt,const SimPlantInDef *In,double h)
+	{
+	double VDD,VCv,VCmd,ISet,ILim,V;
+	_Bool IsLDMOS=In->IsMCUOn&&In->LDMOSEN,IsEN=In->IsMCUOn&&In->DCDCEN,IsLDOn;
+	//PWMDACRC˲
+	VDD=SimPlant_VDD();
+	Pt->Vdac0+=((In->IsMCUOn?In->Duty0*VDD:0)-Pt->Vdac0)*(1-exp(-h/CCDACTau));
+	Pt->Vdac4+=((In->IsMCUOn?In->Duty4*VDD:0)-Pt->Vdac4)*(1-exp(-h/CVDACTau));
+	//ENţEN֮оƬλ
+	if(IsEN&&!Pt->IsEN)Pt->ENTime=Pt->Time;
+	if(!IsEN&&Pt->IsEN)SC8721Reset(Pt);
+	Pt->IsEN=IsEN;
+	//ʼǷ(оƬϵ硢ѹûб)
+	Pt->IsRunning=SimSC8721_IsACK()&&!(Pt->Reg[0x05]&0x04);
+	if(!Pt->IsRunning)Pt->SSFrac=0;
+	else if(Pt->SSFrac<1)
+		{
+		Pt->SSFrac+=h/SC8721SoftStart;
+		if(Pt->SSFrac>1)Pt->SSFrac=1;
+		}
+	//ѹͺĿ
+	if(Pt->Reg[0x04]&0x10)VCv=SC8721VintFB*Pt->SSFrac;
+	else VCv=6.1806*Pt->SSFrac-1.5454*Pt->Vdac4;
+	if(VCv<0)VCv=0;
+	ISet=Pt->Vdac0*(200.0/177.0)*(1000.0/LDCurrentOffset);
+	Pt->Ucc+=SC8721CCGain*(ISet-Pt->ILD)*h;
+	if(Pt->Ucc>Pt->Vout+SC8721CCHeadroom)Pt->Ucc=Pt->Vout+SC8721CCHeadroom;
+	if(Pt->Ucc<0)Pt->Ucc=0;
+	VCmd=VCv<Pt->Ucc?VCv:Pt->Ucc;
+	//ֵ
+	ILim=SC8721CSOFullScale*(Pt->CSOActive+1)/256.0;
+	if(ILim>SC8721CBCLimit)ILim=SC8721CBCLimit;
+	//ѹȼLDͨLDֵٰյͨ
+	IsLDOn=0;
+	V=Pt->IsRunning?SolveVout(Pt,h,0,1,VCmd,0):SolveVout(Pt,h,0,0,0,0);
+	if(IsLDMOS&&V>LDVth)
+		{
+		IsLDOn=1;
+		V=Pt->IsRunning?SolveVout(Pt,h,0,1,VCmd,1):SolveVout(Pt,h,0,0,0,1);
+		}
+	Pt->IConv=Pt->IsRunning?(VCmd-V)/SC8721RConv:0;
+	//ʼյֵʱֵ
+	if(Pt->IConv<0||Pt->IConv>ILim)
+		{
+		if(Pt->IConv>ILim)
+			{
+			Pt->IConv=ILim;
+			if(ILim<SC8721CBCLimit)Pt->Status2|=0x02; //BUS_ILIM
+			else Pt->Status1|=0x01; //CBC_OCP
+			}
+		else Pt->IConv=0;
+		V=SolveVout(Pt,h,Pt->IConv,0,0,IsLDOn);
+		}
+	if(V<0)V=0;
+	Pt->Vout=V;
+	Pt->ILD=IsLDOn&&V>LDVth?(V-LDVth)/LDRd:0;
+	//·(ʼѾϵѹȻܵ)
+	if(Pt->IsRunning&&Pt->SSFrac>=1&&V<1.0&&Pt->IConv>=ILim)Pt->Status1|=0x80;
+	//أŵDCDC͵ƬĹ
+	Pt->Ibat=Pt->Vout*Pt->IConv/ConvEfficiency/(Pt->Vbat>1?Pt->Vbat:1)+(In->IsMCUOn?MCUCurrent:0);
+	Pt->SOC-=Pt->Ibat*h/(CellCapacity*3600.0);
+	if(Pt->SOC<0)Pt->SOC=0;
+	Pt->OCV=CellOCV(Pt->SOC)*SimParam.CellCount;
+	Pt->Vbat=Pt->OCV-Pt->Ibat*CellRes*SimParam.CellCount;
+	//ǺNTC¶
+	Pt->THost+=(LDHeatFraction*Pt->Vout*Pt->ILD-(Pt->THost-Pt->Ambient)/Pt->HostR)*h/Pt->HostC;
+	Pt->TNTC+=(Pt->THost-Pt->TNTC)*(1-exp(-h/SimParam.SensorTau));
+	Pt->Time+=h;
+	}
+
+//ȡƬضź
+static void ReadInput(SimPlantInDef *In)
+	{
+	In->IsMCUOn=Sim->In.IsMCUOn;
+	if(!In->IsMCUOn)
+		{
+		In->DCDCEN=0;
+		In->LDMOSEN=0;
+		In->Duty0=0;
+		In->Duty4=0;
+		return;
+		}
+	In->DCDCEN=DCDCEN;
+	In->LDMOSEN=LDMOSEN;
+	In->Duty0=SimPWM_Output(0);
+	In->Duty4=SimPWM_Output(1);
+	}
+
+//ضǷҪСֵ״̬(ʼLDͨʱֻʣһ׵RC̣
+//˲NTCʹþȷָ⣬ʹʽŷ󲽳Ҳȶ)
+static _Bool IsPlantActive(const SimPlantDef *Pt)
+	{
+	if(Pt->IsEN||Pt->ILD>0)return 1;
+	return Sim->In.IsMCUOn&&Sim->In.LDMOSEN&&Pt->Vout>LDVth;
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+//濪ʼʱʼض
+void SimPlant_Init(void)
+	{
+	SimPlantDef *Pt=&Sim->Plant;
+	memset(Pt,0,sizeof(SimPlantDef));
+	SC8721Reset(Pt);
+	Pt->Ambient=SimParam.Ambient;
+	Pt->HostC=SimParam.HostC;
+	Pt->HostR=SimParam.HostR;
+	Pt->THost=Pt->Ambient;
+	Pt->TNTC=Pt->Ambient;
+	SimPlant_SetBattery(SimParam.VbatInit);
+	}
+
+//õصĿ·ѹ(V)
+void SimPlant_SetBattery(double Volt)
+	{
+	SimPlantDef *Pt=&Sim->Plant;
+	Pt->SOC=CellSOC(Volt/SimParam.CellCount);
+	Pt->OCV=Volt;
+	Pt->Vbat=Volt;
+	}
+
+//ѱضֵָʱ
+void SimPlant_Advance(SimTimeDef Until)
+	{
+	SimPlantDef *Pt=&Sim->Plant;
+	double End=SimToSec(Until),h;
+	ReadInput(&Sim->In);
+	while(Pt->Time<End-1e-12)
+		{
+		h=End-Pt->Time;
+		if(IsPlantActive(Pt)&&h>PlantStepActive)h=PlantStepActive;
+		PlantStep(Pt,&Sim->In,h);
+		}
+	SimScript_Sample();
+	}
+
+//ѱضֵǰʱ
+void SimPlant_Sync(void)
+	{
+	SimPlant_Advance(Sim->Now);
+	}
+
+//ض¼
+void SimPlant_Event(void)
+	{
+	SimPlant_Sync();
+	SimEvent_Set(SimEv_Plant,Sim->Now+(IsPlantActive(&Sim->Plant)?PlantEventActive:PlantEventIdle));
+	}
+
+//ƬĹѹ
+double SimPlant_VDD(void)
+	{
+	double V=Sim->Plant.Vbat-MCULDODrop;
+	return V>MCULDOOut?MCULDOOut:V;
+	}
+
+//ADCͨѹ
+double SimPlant_ADCInput(unsigned char Ch)
+	{
+	const SimPlantDef *Pt=&Sim->Plant;
+	double R;
+	switch(Ch)
+		{
+		case 5: //NTCVDD͵֮䣬470K
+			R=NTCR25*exp(NTCBeta*(1.0/(Pt->TNTC+273.15)-1.0/298.15));
+			return SimPlant_VDD()*R/(R+NTCPullUp);
+		case 8:return Pt->Vout*75.0/755.0; //ѹѹ680K/75K
+		case 14:return Pt->Vbat*100.0/570.0; //صѹѹ470K/100K
+		case 31:return 1.2; //϶׼
+		default:return 0;
+		}
+	}
+
+//SC8721AǷͨ(ENΪ߲ϵ)
+_Bool SimSC8721_IsACK(void)
+	{
+	const SimPlantDef *Pt=&Sim->Plant;
+	return Pt->IsEN&&(Pt->Time-Pt->ENTime)>=SC8721PORTime&&Pt->Vbat>SC8721UVLO;
+	}
+
+//ȡSC8721AļĴ(STATUSĴȡ֮ı־)
+unsigned char SimSC8721_Read(unsigned char Reg)
+	{
+	SimPlantDef *Pt=&Sim->Plant;
+	unsigned char Value;
+	SimPlant_Sync();
+	Reg&=0x0F;
+	switch(Reg)
+		{
+		case 0x09:
+			Value=Pt->Status1|(Pt->Vout>Pt->Vbat?0x40:0x00);
+			Pt->Status1=0;
+			return Value;
+		case 0x0A:
+			Value=Pt->Status2;
+			Pt->Status2=0;
+			return Value;
+		default:return Pt->Reg[Reg];
+		}
+	}
+
+//дSC8721AļĴ
+void SimSC8721_Write(unsigned char Reg,unsigned char Value)
+	{
+	SimPlantDef *Pt=&Sim->Plant;
+	SimPlant_Sync();
+	Reg&=0x0F;
+	if(Reg==0x00||Reg>=0x09)return; //ֻĴ
+	//LoadλCSO_SETصʼϺԶ
+	if(Reg==0x05&&(Value&0x02))
+		{
+		Pt->CSOActive=Pt->Reg[0x01];
+		Value&=~0x02;
+		}
+	Pt->Reg[Reg]=Value;
+	}
@@ -0,0 +1,438 @@
+/****************************************************************************/
+/** \file SimScript.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļLaserSimĳűͽ顣ļÿһ
+#֮Ϊעͣʱ䵥λΪmS
+	wait <ms>              ȴ
+	press / release        »ɿఴ
+	hold <ms>              סఴָʱɿ
+	click [n]              n(100mSɿ150mSһɿ֮󲻵ȴ)
+	battery <V>            õĿ·ѹ
+	ambient <>           û¶
+	host <J/K> <K/W>       ݺ(ʱ䳣ӿ¿صķ)
+	powercycle <ms>        Ͽָʱϵ
+	measure <name>         ʼһµĲ(ִʱ̿ʼʱ)
+	report                 
+	expect <ָ> <Ƚ> <ֵ>  һβĽȽΪ< <= > >= ==
+	end                    
+ָ꣺
+	on_ms         LDʼͨ(10mA)ʱ
+	target_ms     һδﵽĿֵ95%ʱ
+	settle_ms     һν벢Ŀֵ5%ڵʱ(10Ĳͳ)
+	target_ma     ʱλĿ
+	peak_ma       LDֵ
+	overshoot_ma  ֵĿĲ֣overshoot_pctΪٷֱ
+	final_ma      ǰ50mSƽavg_maΪڼƽ
+	vout_peak_mv  ѹֵ
+	mode          ʱĵλ(ModeIdxDef)faultΪ(FaultCodeDef)
+	loop_hz       ѭƽƵʣloop_max_usΪĵȦʱ(STOP˯)
+	temp_c        ʱ¶ȣtemp_peak_cΪֵ¶
+	temp_settle_s ¶һν벢¶ȡ1ڵʱ
+ʱָûдﵽʱΪ-1
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include "ModeControl.h"
+#include "SelfTest.h"
+#include "OutputChannel.h"
+#include "HostSim.h"
+#include <stddef.h>
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+#define ScriptMaxCmd 4096 //ļչ֮
+#define ClickPressMS 100 //ʱµʱ
+#define ClickGapMS 150 //֮ɿʱ
+#define OnThreshold 0.01 //жLDͨĵ(A)
+#define SettleBand 0.05 //ȶ
+#define TempSettleBand 1.0 //¶ȶ()
+
+/****************************************************************************/
+/*	Local type definitions('typedef')
+****************************************************************************/
+typedef enum
+	{
+	Cmd_Wait,
+	Cmd_Press,
+	Cmd_Release,
+	Cmd_Battery,
+	Cmd_Ambient,
+	Cmd_Host,
+	Cmd_PowerCycle,
+	Cmd_Measure,
+	Cmd_Report,
+	Cmd_Expect,
+	Cmd_End
+	}ScriptOpDef;
+
+typedef struct
+	{
+	ScriptOpDef Op;
+	double Arg,Arg2;
+	char Name[32];				//ƻ߼ָ
+	char Cmp[3];				//ıȽ
+	int Line;					//ڵк
+	}ScriptCmdDef;
+
+typedef enum
+	{
+	Metric_OnMS,
+	Metric_TargetMS,
+	Metric_SettleMS,
+	Metric_TargetMA,
+	Metric_PeakMA,
+	Metric_OvershootMA,
+	Metric_OvershootPct,
+	Metric_FinalMA,
+	Metric_AvgMA,
+	Metric_VoutPeakMV,
+	Metric_Mode,
+	Metric_Fault,
+	Metric_LoopHz,
+	Metric_LoopMaxUS,
+	Metric_TempC,
+	Metric_TempPeakC,
+	Metric_TempSettleS,
+	MetricCount
+	}MetricIdxDef;
+
+typedef struct
+	{
+	const char *Name;
+	const char *Format;
+	}MetricDef;
+
+/****************************************************************************/
+/*	Local variable  definitions('static')
+****************************************************************************/
+static ScriptCmdDef Script[ScriptMaxCmd];
+static int ScriptCount;
+
+//ָƺʽMetricIdxDef˳
+static const MetricDef MetricTable[MetricCount]=
+	{
+	{"on_ms","%.1f"},
+	{"target_ms","%.1f"},
+	{"settle_ms","%.1f"},
+	{"target_ma","%.0f"},
+	{"peak_ma","%.1f"},
+	{"overshoot_ma","%.1f"},
+	{"overshoot_pct","%.2f"},
+	{"final_ma","%.1f"},
+	{"avg_ma","%.1f"},
+	{"vout_peak_mv","%.0f"},
+	{"mode","%.0f"},
+	{"fault","%.0f"},
+	{"loop_hz","%.0f"},
+	{"loop_max_us","%.1f"},
+	{"temp_c","%.2f"},
+	{"temp_peak_c","%.2f"},
+	{"temp_settle_s","%.1f"}
+	};
+
+/****************************************************************************/
+/*	Function implementation - local('static')
+****************************************************************************/
+//һ
+static int AddCmd(ScriptOpDef Op,double Arg,const char *Name,int Line)
+	{
+	ScriptCmdDef *C;
+	if(ScriptCount>=ScriptMaxCmd)
+		{
+		printf("LaserSim: too many commands at line %d\n",Line);
+		return 0;
+		}
+	C=&Script[ScriptCount++];
+	memset(C,0,sizeof(ScriptCmdDef));
+	C->Op=Op;
+	C->Arg=Arg;
+	C->Line=Line;
+	if(Name!=NULL)snprintf(C->Name,sizeof(C->Name),"%s",Name);
+	return 1;
+	}
+
+//ָı
+static int FindMetric(const char *Name)
+	{
+	int i;
+	for(i=0;i<MetricCount;i++)if(!strcmp(MetricTable[i].Name,Name))return i;
+	return -1;
+	}
+
+//ӿٲвҵһ뿪ʱ䣬һֱڷ0ûн-1
+static double SettleTime(const float *Buf,long Count,double Target,double Band,double Step)
+	{
+	long i;
+	if(Count<=0||Target<=0)return -1;
+	for(i=Count-1;i>=0;i--)if(fabs(Buf[i]-Target)>Target*Band)break;
+	if(i==Count-1)return -1;
+	return (i+1)*Step;
+	}
+
+//һβȫָ
+static void ComputeMetric(void)
+	{
+	SimMeasDef *M=&Sim->Meas;
+	double *R=M->Result,Target=0,Final=0,Dur;
+	long i,n=M->FastCount<SimFastSampleCount?M->FastCount:SimFastSampleCount;
+	long Slow=M->SlowCount<SimSlowSampleCount?M->SlowCount:SimSlowSampleCount;
+	long Count=M->FastCount<SimFinalSampleCount?M->FastCount:SimFinalSampleCount;
+	_Bool IsFWValid=Sim->In.IsMCUOn&&CurrentMode!=NULL;
+	//Ŀ͵λ
+	if(IsFWValid)Target=CurrentMode->Current/1000.0;
+	R[Metric_TargetMA]=Target*1000;
+	R[Metric_Mode]=IsFWValid?CurrentMode->ModeIdx:Mode_OFF;
+	R[Metric_Fault]=IsFWValid?ErrCode:Fault_None;
+	//ʱָ
+	R[Metric_OnMS]=-1;
+	R[Metric_TargetMS]=-1;
+	for(i=0;i<n;i++)if(M->FastI[i]>OnThreshold)
+		{
+		R[Metric_OnMS]=i*SimFastSampleUS/1000.0;
+		break;
+		}
+	for(i=0;i<n&&Target>0;i++)if(M->FastI[i]>=Target*(1-SettleBand))
+		{
+		R[Metric_TargetMS]=i*SimFastSampleUS/1000.0;
+		break;
+		}
+	R[Metric_SettleMS]=M->FastCount>SimFastSampleCount?-1:SettleTime(M->FastI,n,Target,SettleBand,SimFastSampleUS/1000.0);
+	//ֵƽֵ
+	R[Metric_PeakMA]=M->PeakI*1000;
+	R[Metric_OvershootMA]=M->PeakI>Target?(M->PeakI-Target)*1000:0;
+	R[Metric_OvershootPct]=Target>0?R[Metric_OvershootMA]/(Target*10):0;
+	for(i=0;i<Count;i++)Final+=M->FinalI[i];
+	R[Metric_FinalMA]=Count?Final*1000/Count:0;
+	R[Metric_AvgMA]=M->FastCount?M->SumI*1000/M->FastCount:0;
+	R[Metric_VoutPeakMV]=M->PeakV*1000;
+	//ѭ
+	Dur=SimToSec(Sim->Now-M->Start);
+	R[Metric_LoopHz]=Dur>0?M->LoopCount/Dur:0;
+	R[Metric_LoopMaxUS]=SimToSec(M->LoopMax)*1e6;
+	//¶
+	R[Metric_TempC]=Sim->Plant.THost;
+	R[Metric_TempPeakC]=M->PeakT;
+	R[Metric_TempSettleS]=-1;
+	if(Slow>0&&M->SlowCount<=SimSlowSampleCount)
+		{
+		for(i=Slow-1;i>=0;i--)if(fabs(M->SlowT[i]-Sim->Plant.THost)>TempSettleBand)break;
+		R[Metric_TempSettleS]=(i+1)*(SimSlowSampleMS/1000.0);
+		}
+	}
+
+//
+static void Report(void)
+	{
+	int i;
+	ComputeMetric();
+	Sim->Meas.IsActive=0;
+	printf("[%10.4fs] %s:",SimToSec(Sim->Now),Sim->Meas.Name);
+	for(i=0;i<MetricCount;i++)
+		{
+		printf(" %s=",MetricTable[i].Name);
+		printf(MetricTable[i].Format,Sim->Meas.Result[i]);
+		}
+	printf("\n");
+	}
+
+//һָ
+static void Expect(const ScriptCmdDef *C)
+	{
+	int Idx=FindMetric(C->Name);
+	double V;
+	_Bool IsOK;
+	if(Sim->Meas.IsActive)ComputeMetric();
+	V=Sim->Meas.Result[Idx];
+	if(!strcmp(C->Cmp,"<"))IsOK=V<C->Arg;
+	else if(!strcmp(C->Cmp,"<="))IsOK=V<=C->Arg;
+	else if(!strcmp(C->Cmp,">"))IsOK=V>C->Arg;
+	else if(!strcmp(C->Cmp,">="))IsOK=V>=C->Arg;
+	else IsOK=fabs(V-C->Arg)<1e-9;
+	Sim->CheckCount++;
+	if(!IsOK)Sim->FailCount++;
+	if(!IsOK||SimParam.IsVerbose)
+		{
+		printf("%s: line %d: %s.%s=",IsOK?"PASS":"FAIL",C->Line,Sim->Meas.Name,C->Name);
+		printf(MetricTable[Idx].Format,V);
+		printf(", expected %s %g\n",C->Cmp,C->Arg);
+		}
+	}
+
+//һв
+static void TraceLine(void)
+	{
+	const SimPlantDef *Pt=&Sim->Plant;
+	int Mode=Sim->In.IsMCUOn&&CurrentMode!=NULL?CurrentMode->ModeIdx:Mode_OFF;
+	fprintf(SimTrace,"%.4f,%.4f,%.2f,%.4f,%.4f,%.3f,%.3f,%d,%d,%.4f,%.4f,%d,%d\n",
+		SimToSec(Sim->Now),Pt->Vout,Pt->ILD*1000,Pt->Vdac0,Pt->Vdac4,Pt->Vbat,Pt->THost,
+		Sim->In.DCDCEN,Sim->In.LDMOSEN,Sim->In.Duty0,Sim->In.Duty4,Mode,Sim->IsKeyPressed);
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+//ȡչļɹ1
+int SimScript_Load(const char *File)
+	{
+	FILE *fp=fopen(File,"r");
+	char Line[256],Word[32],Name[32],Cmp[8];
+	int LineNo=0,n,i,Count;
+	double Arg,Arg2;
+	_Bool IsOK=1;
+	if(fp==NULL)
+		{
+		printf("LaserSim: cannot open %s\n",File);
+		return 0;
+		}
+	ScriptCount=0;
+	while(IsOK&&fgets(Line,sizeof(Line),fp)!=NULL)
+		{
+		LineNo++;
+		if(strchr(Line,'#')!=NULL)*strchr(Line,'#')=0;
+		n=sscanf(Line,"%31s",Word);
+		if(n<1)continue;
+		Arg=0;
+		Name[0]=0;
+		if(!strcmp(Word,"wait")&&sscanf(Line,"%*s %lf",&Arg)==1)IsOK=AddCmd(Cmd_Wait,Arg,NULL,LineNo);
+		else if(!strcmp(Word,"press"))IsOK=AddCmd(Cmd_Press,0,NULL,LineNo);
+		else if(!strcmp(Word,"release"))IsOK=AddCmd(Cmd_Release,0,NULL,LineNo);
+		else if(!strcmp(Word,"hold")&&sscanf(Line,"%*s %lf",&Arg)==1)
+			{
+			IsOK=AddCmd(Cmd_Press,0,NULL,LineNo)&&AddCmd(Cmd_Wait,Arg,NULL,LineNo)&&AddCmd(Cmd_Release,0,NULL,LineNo);
+			}
+		else if(!strcmp(Word,"click"))
+			{
+			Count=sscanf(Line,"%*s %d",&n)==1?n:1;
+			for(i=0;i<Count&&IsOK;i++)
+				{
+				if(i)IsOK=AddCmd(Cmd_Wait,ClickGapMS,NULL,LineNo);
+				IsOK=IsOK&&AddCmd(Cmd_Press,0,NULL,LineNo)&&AddCmd(Cmd_Wait,ClickPressMS,NULL,LineNo)&&AddCmd(Cmd_Release,0,NULL,LineNo);
+				}
+			}
+		else if(!strcmp(Word,"battery")&&sscanf(Line,"%*s %lf",&Arg)==1)IsOK=AddCmd(Cmd_Battery,Arg,NULL,LineNo);
+		else if(!strcmp(Word,"ambient")&&sscanf(Line,"%*s %lf",&Arg)==1)IsOK=AddCmd(Cmd_Ambient,Arg,NULL,LineNo);
+		else if(!strcmp(Word,"host")&&sscanf(Line,"%*s %lf %lf",&Arg,&Arg2)==2&&Arg>0&&Arg2>0)
+			{
+			IsOK=AddCmd(Cmd_Host,Arg,NULL,LineNo);
+			if(IsOK)Script[ScriptCount-1].Arg2=Arg2;
+			}
+		else if(!strcmp(Word,"powercycle")&&sscanf(Line,"%*s %lf",&Arg)==1)IsOK=AddCmd(Cmd_PowerCycle,Arg,NULL,LineNo);
+		else if(!strcmp(Word,"measure")&&sscanf(Line,"%*s %31s",Name)==1)IsOK=AddCmd(Cmd_Measure,0,Name,LineNo);
+		else if(!strcmp(Word,"report"))IsOK=AddCmd(Cmd_Report,0,NULL,LineNo);
+		else if(!strcmp(Word,"expect")&&sscanf(Line,"%*s %31s %7s %lf",Name,Cmp,&Arg)==3&&FindMetric(Name)>=0&&
+			(!strcmp(Cmp,"<")||!strcmp(Cmp,"<=")||!strcmp(Cmp,">")||!strcmp(Cmp,">=")||!strcmp(Cmp,"==")))
+			{
+			IsOK=AddCmd(Cmd_Expect,Arg,Name,LineNo);
+			if(IsOK)strcpy(Script[ScriptCount-1].Cmp,Cmp);
+			}
+		else if(!strcmp(Word,"end"))IsOK=AddCmd(Cmd_End,0,NULL,LineNo);
+		else
+			{
+			printf("LaserSim: %s:%d: invalid command\n",File,LineNo);
+			IsOK=0;
+			}
+		}
+	fclose(fp);
+	if(IsOK&&(!ScriptCount||Script[ScriptCount-1].Op!=Cmd_End))IsOK=AddCmd(Cmd_End,0,NULL,LineNo);
+	return IsOK;
+	}
+
+//ִеڵֱҪȴ
+void SimScript_Event(void)
+	{
+	const ScriptCmdDef *C;
+	SimMeasDef *M=&Sim->Meas;
+	while(Sim->ScriptPos<ScriptCount)
+		{
+		C=&Script[Sim->ScriptPos++];
+		switch(C->Op)
+			{
+			case Cmd_Wait:
+				Sim->ScriptWake=Sim->Now+SimUS(C->Arg*1000);
+				SimEvent_Set(SimEv_Script,Sim->ScriptWake);
+				return;
+			case Cmd_Press:SimKey_Set(1);break;
+			case Cmd_Release:SimKey_Set(0);break;
+			case Cmd_Battery:
+				SimPlant_Sync();
+				SimPlant_SetBattery(C->Arg);
+				break;
+			case Cmd_Ambient:
+				SimPlant_Sync();
+				Sim->Plant.Ambient=C->Arg;
+				break;
+			case Cmd_Host:
+				SimPlant_Sync();
+				Sim->Plant.HostC=C->Arg;
+				Sim->Plant.HostR=C->Arg2;
+				break;
+			case Cmd_PowerCycle:
+				Sim->PowerOnTime=Sim->Now+SimUS(C->Arg*1000);
+				Sim->ScriptWake=Sim->PowerOnTime;
+				SimCore_Exit(SimExit_PowerCycle);
+				break;
+			case Cmd_Measure:
+				SimPlant_Sync();
+				memset(M,0,offsetof(SimMeasDef,FastI));
+				snprintf(M->Name,sizeof(M->Name),"%s",C->Name);
+				M->IsActive=1;
+				M->Start=Sim->Now;
+				M->LoopLast=Sim->Now;
+				break;
+			case Cmd_Report:
+				SimPlant_Sync();
+				Report();
+				break;
+			case Cmd_Expect:Expect(C);break;
+			case Cmd_End:SimCore_Exit(SimExit_End);break;
+			}
+		}
+	SimCore_Exit(SimExit_End);
+	}
+
+//ض֮
+void SimScript_Sample(void)
+	{
+	SimMeasDef *M=&Sim->Meas;
+	const SimPlantDef *Pt=&Sim->Plant;
+	//
+	if(SimTrace!=NULL)while(Sim->TraceNext<=Sim->Now)
+		{
+		TraceLine();
+		Sim->TraceNext+=SimUS(SimParam.TraceStepMS*1000);
+		}
+	if(!M->IsActive)return;
+	//ֵ
+	if(Pt->ILD>M->PeakI)M->PeakI=Pt->ILD;
+	if(Pt->Vout>M->PeakV)M->PeakV=Pt->Vout;
+	if(Pt->THost>M->PeakT)M->PeakT=Pt->THost;
+	//ٺٲ
+	while(M->Start+(SimTimeDef)M->FastCount*SimUS(SimFastSampleUS)<=Sim->Now)
+		{
+		if(M->FastCount<SimFastSampleCount)M->FastI[M->FastCount]=(float)Pt->ILD;
+		M->FinalI[M->FastCount%SimFinalSampleCount]=(float)Pt->ILD;
+		M->SumI+=Pt->ILD;
+		M->FastCount++;
+		}
+	while(M->Start+(SimTimeDef)M->SlowCount*SimMS(SimSlowSampleMS)<=Sim->Now)
+		{
+		if(M->SlowCount<SimSlowSampleCount)M->SlowT[M->SlowCount]=(float)Pt->THost;
+		M->SlowCount++;
+		}
+	}
+
+//ѭÿȦһΣͳѭƵ
+void SimScript_Loop(void)
+	{
+	SimMeasDef *M=&Sim->Meas;
+	if(!M->IsActive)return;
+	if(M->LoopCount&&Sim->Now-M->LoopLast>M->LoopMax)M->LoopMax=Sim->Now-M->LoopLast;
+	M->LoopLast=Sim->Now;
+	M->LoopCount++;
+	}
@@ -0,0 +1,1374 @@
+/****************************************************************************/
+/** \file cms8s6990.h
+/** \Description ļTools/HostSim/SFRHostGen../../FirmwareCode/StdDriver/inc/cms8s6990.hԶɣ
+PCϱ̼Դļ벻Ҫֶ޸ġ
+*****************************************************************************/
+/*******************************************************************************
+* Copyright (C) 2019 China Micro Semiconductor Limited Company. All Rights Reserved.
+*
+* This software is owned and published by:
+* CMS LLC, No 2609-10, Taurus Plaza, TaoyuanRoad, NanshanDistrict, Shenzhen, China.
+*
+* BY DOWNLOADING, INSTALLING OR USING THIS SOFTWARE, YOU AGREE TO BE BOUND
+* BY ALL THE TERMS AND CONDITIONS OF THIS AGREEMENT.
+*
+* This software contains source code for use with CMS
+* components. This software is licensed by CMS to be adapted only
+* for use in systems utilizing CMS components. CMS shall not be
+* responsible for misuse or illegal use of this software for devices not
+* supported herein. CMS is providing this software "AS IS" and will
+* not be responsible for issues arising from incorrect user implementation
+* of the software.
+*
+* This software may be replicated in part or whole for the licensed use,
+* with the restriction that this Disclaimer and Copyright notice must be
+* included with each copy of this software, whether used in part or whole,
+* at all times.
+*/
+
+/*****************************************************************************/
+/** \file cms8s6990.h
+**
+**
+**
+** History:
+** 
+*****************************************************************************/
+#ifndef _CMS8S6990_H_
+#define _CMS8S6990_H_
+/*****************************************************************************/
+/* Include files */
+/*****************************************************************************/
+#include "intrins.h"
+
+/*****************************************************************************/
+/* Global pre-processor symbols/macros ('#define') */
+/*****************************************************************************/
+#include <stdint.h> //PCʹñ׼Ķ(ȺC51ͬ)
+
+
+typedef int32_t  s32;
+typedef int16_t  s16;
+typedef int8_t   s8;
+
+typedef uint32_t  u32;
+typedef uint16_t  u16;
+typedef uint8_t   u8;
+
+
+/*----------BYTE Register------------------*/
+/*-----------SFR(⹦ܼĴ)-------*/
+//PCϵļĴ洢ͷʺHostSFR.cʵ
+typedef union
+	{
+	unsigned char Byte;
+	struct
+		{
+		_Bool B0:1;
+		_Bool B1:1;
+		_Bool B2:1;
+		_Bool B3:1;
+		_Bool B4:1;
+		_Bool B5:1;
+		_Bool B6:1;
+		_Bool B7:1;
+		}Bit;
+	}HostSFRDef;
+#define HostXSFRBase 0xF000 //xdataӳĴʼַ
+#define HostXSFRSize 0x0800 //xdataӳĴĵַΧ
+extern volatile HostSFRDef HostSFR[256];
+extern volatile unsigned char HostXSFR[HostXSFRSize];
+extern void (*HostSFRHook)(unsigned char IsXSFR,unsigned short Addr); //ʻصڷ֮ǰ
+volatile HostSFRDef *HostSFR_Access(unsigned char Addr);
+volatile unsigned char *HostXSFR_Access(unsigned short Addr);
+
+#define P0 0x80 //˿ĬΪù̼sbitԱ
+#define SP (HostSFR_Access(0x81)->Byte)
+#define DPL0 (HostSFR_Access(0x82)->Byte)
+#define DPH0 (HostSFR_Access(0x83)->Byte)
+#define DPL1 (HostSFR_Access(0x84)->Byte)
+#define DPH1 (HostSFR_Access(0x85)->Byte)
+#define DPS (HostSFR_Access(0x86)->Byte)
+#define PCON (HostSFR_Access(0x87)->Byte)
+#define TCON (HostSFR_Access(0x88)->Byte)
+#define TMOD (HostSFR_Access(0x89)->Byte)
+#define TL0 (HostSFR_Access(0x8A)->Byte)
+#define TL1 (HostSFR_Access(0x8B)->Byte)
+#define TH0 (HostSFR_Access(0x8C)->Byte)
+#define TH1 (HostSFR_Access(0x8D)->Byte)
+#define CKCON (HostSFR_Access(0x8E)->Byte)
+#define CLKDIV (HostSFR_Access(0x8F)->Byte)
+
+#define P1 0x90 //˿ĬΪù̼sbitԱ
+#define FUNCCR (HostSFR_Access(0x91)->Byte)
+
+#define DPX0 (HostSFR_Access(0x93)->Byte)
+#define DPX1 (HostSFR_Access(0x95)->Byte)
+#define TA (HostSFR_Access(0x96)->Byte)
+#define WDCON (HostSFR_Access(0x97)->Byte)
+#define SCON0 (HostSFR_Access(0x98)->Byte)
+#define SBUF (HostSFR_Access(0x99)->Byte)
+#define SBUF0 (HostSFR_Access(0x99)->Byte)
+#define P0TRIS (HostSFR_Access(0x9A)->Byte)
+
+#define P2 0xA0 //˿ĬΪù̼sbitԱ
+#define P1TRIS (HostSFR_Access(0xA1)->Byte)
+#define P2TRIS (HostSFR_Access(0xA2)->Byte)
+#define P3TRIS (HostSFR_Access(0xA3)->Byte)
+
+#define IE (HostSFR_Access(0xA8)->Byte)
+#define EIE2 (HostSFR_Access(0xAA)->Byte)
+#define P0EXTIE (HostSFR_Access(0xAC)->Byte)
+#define P1EXTIE (HostSFR_Access(0xAD)->Byte)
+#define P2EXTIE (HostSFR_Access(0xAE)->Byte)
+#define P3EXTIE (HostSFR_Access(0xAF)->Byte)
+
+#define P3 0xB0 //˿ĬΪù̼sbitԱ
+#define EIF2 (HostSFR_Access(0xB2)->Byte)
+#define P0EXTIF (HostSFR_Access(0xB4)->Byte)
+#define P1EXTIF (HostSFR_Access(0xB5)->Byte)
+#define P2EXTIF (HostSFR_Access(0xB6)->Byte)
+#define P3EXTIF (HostSFR_Access(0xB7)->Byte)
+
+#define IP (HostSFR_Access(0xB8)->Byte)
+#define EIP1 (HostSFR_Access(0xB9)->Byte)
+#define EIP2 (HostSFR_Access(0xBA)->Byte)
+#define WUTCRL (HostSFR_Access(0xBC)->Byte)
+#define WUTCRH (HostSFR_Access(0xBD)->Byte)
+#define BUZDIV (HostSFR_Access(0xBE)->Byte)
+#define BUZCON (HostSFR_Access(0xBF)->Byte)
+
+#define CCL1 (HostSFR_Access(0xC2)->Byte)
+#define CCH1 (HostSFR_Access(0xC3)->Byte)
+#define CCL2 (HostSFR_Access(0xC4)->Byte)
+#define CCH2 (HostSFR_Access(0xC5)->Byte)
+#define CCL3 (HostSFR_Access(0xC6)->Byte)
+#define CCH3 (HostSFR_Access(0xC7)->Byte)
+
+#define T2CON (HostSFR_Access(0xC8)->Byte)
+#define T2IF (HostSFR_Access(0xC9)->Byte)
+#define RLDL (HostSFR_Access(0xCA)->Byte)
+#define RLDH (HostSFR_Access(0xCB)->Byte)
+#define TL2 (HostSFR_Access(0xCC)->Byte)
+#define TH2 (HostSFR_Access(0xCD)->Byte)
+#define CCEN (HostSFR_Access(0xCE)->Byte)
+#define T2IE (HostSFR_Access(0xCF)->Byte)
+
+#define PSW (HostSFR_Access(0xD0)->Byte)
+#define ADCMPC (HostSFR_Access(0xD1)->Byte)
+#define T34MOD (HostSFR_Access(0xD2)->Byte)
+#define ADDLYL (HostSFR_Access(0xD3)->Byte)
+#define ADCMPL (HostSFR_Access(0xD4)->Byte)
+#define ADCMPH (HostSFR_Access(0xD5)->Byte)
+
+#define TL3 (HostSFR_Access(0xDA)->Byte)
+#define TH3 (HostSFR_Access(0xDB)->Byte)
+#define ADRESL (HostSFR_Access(0xDC)->Byte)
+#define ADRESH (HostSFR_Access(0xDD)->Byte)
+#define ADCON1 (HostSFR_Access(0xDE)->Byte)
+#define ADCON0 (HostSFR_Access(0xDF)->Byte)
+
+#define ACC (HostSFR_Access(0xE0)->Byte)
+#define TL4 (HostSFR_Access(0xE2)->Byte)
+#define TH4 (HostSFR_Access(0xE3)->Byte)
+
+
+#define ADCON2 (HostSFR_Access(0xE9)->Byte)
+#define SCON1 (HostSFR_Access(0xEA)->Byte)
+#define SBUF1 (HostSFR_Access(0xEB)->Byte)
+#define SPCR (HostSFR_Access(0xEC)->Byte)
+#define SPSR (HostSFR_Access(0xED)->Byte)
+#define SPDR (HostSFR_Access(0xEE)->Byte)
+#define SSCR (HostSFR_Access(0xEF)->Byte)
+
+#define B (HostSFR_Access(0xF0)->Byte)
+#define I2CSADR (HostSFR_Access(0xF1)->Byte)
+#define I2CSCR (HostSFR_Access(0xF2)->Byte)
+#define I2CSSR (HostSFR_Access(0xF2)->Byte)
+#define I2CSBUF (HostSFR_Access(0xF3)->Byte)
+#define I2CMSA (HostSFR_Access(0xF4)->Byte)
+#define I2CMCR (HostSFR_Access(0xF5)->Byte)
+#define I2CMSR (HostSFR_Access(0xF5)->Byte)
+#define I2CMBUF (HostSFR_Access(0xF6)->Byte)
+#define I2CMTP (HostSFR_Access(0xF7)->Byte)
+
+#define MLOCK (HostSFR_Access(0xFB)->Byte)
+#define MADRL (HostSFR_Access(0xFC)->Byte)
+#define MADRH (HostSFR_Access(0xFD)->Byte)
+#define MDATA (HostSFR_Access(0xFE)->Byte)
+#define MCTRL (HostSFR_Access(0xFF)->Byte)
+
+/*-----------XSFR(⹦ܼĴ)-------*/
+//xdataӳļĴ
+#define P00CFG (*HostXSFR_Access(0xF000))
+#define P01CFG (*HostXSFR_Access(0xF001))
+#define P02CFG (*HostXSFR_Access(0xF002))
+#define P03CFG (*HostXSFR_Access(0xF003))
+#define P04CFG (*HostXSFR_Access(0xF004))
+#define P05CFG (*HostXSFR_Access(0xF005))
+
+#define P0OD (*HostXSFR_Access(0xF009))
+#define P0UP (*HostXSFR_Access(0xF00A))
+#define P0RD (*HostXSFR_Access(0xF00B))
+#define P0DR (*HostXSFR_Access(0xF00C))
+#define P0SR (*HostXSFR_Access(0xF00D))
+#define P0DS (*HostXSFR_Access(0xF00E))
+
+
+#define P13CFG (*HostXSFR_Access(0xF013))
+#define P14CFG (*HostXSFR_Access(0xF014))
+#define P15CFG (*HostXSFR_Access(0xF015))
+#define P16CFG (*HostXSFR_Access(0xF016))
+#define P17CFG (*HostXSFR_Access(0xF017))
+
+#define P1OD (*HostXSFR_Access(0xF019))
+#define P1UP (*HostXSFR_Access(0xF01A))
+#define P1RD (*HostXSFR_Access(0xF01B))
+#define P1DR (*HostXSFR_Access(0xF01C))
+#define P1SR (*HostXSFR_Access(0xF01D))
+#define P1DS (*HostXSFR_Access(0xF01E))
+	
+#define P21CFG (*HostXSFR_Access(0xF021))
+#define P22CFG (*HostXSFR_Access(0xF022))
+#define P23CFG (*HostXSFR_Access(0xF023))
+#define P24CFG (*HostXSFR_Access(0xF024))
+#define P25CFG (*HostXSFR_Access(0xF025))
+#define P26CFG (*HostXSFR_Access(0xF026))
+
+#define P2OD (*HostXSFR_Access(0xF029))
+#define P2UP (*HostXSFR_Access(0xF02A))
+#define P2RD (*HostXSFR_Access(0xF02B))
+#define P2DR (*HostXSFR_Access(0xF02C))
+#define P2SR (*HostXSFR_Access(0xF02D))
+#define P2DS (*HostXSFR_Access(0xF02E))
+
+#define P30CFG (*HostXSFR_Access(0xF030))
+#define P31CFG (*HostXSFR_Access(0xF031))
+#define P32CFG (*HostXSFR_Access(0xF032))
+#define P35CFG (*HostXSFR_Access(0xF035))
+#define P36CFG (*HostXSFR_Access(0xF036))
+
+#define P3OD (*HostXSFR_Access(0xF039))
+#define P3UP (*HostXSFR_Access(0xF03A))
+#define P3RD (*HostXSFR_Access(0xF03B))
+#define P3DR (*HostXSFR_Access(0xF03C))
+#define P3SR (*HostXSFR_Access(0xF03D))
+#define P3DS (*HostXSFR_Access(0xF03E))
+
+#define P00EICFG (*HostXSFR_Access(0xF080))
+#define P01EICFG (*HostXSFR_Access(0xF081))
+#define P02EICFG (*HostXSFR_Access(0xF082))
+#define P03EICFG (*HostXSFR_Access(0xF083))
+#define P04EICFG (*HostXSFR_Access(0xF084))
+#define P05EICFG (*HostXSFR_Access(0xF085))
+
+#define P13EICFG (*HostXSFR_Access(0xF08B))
+#define P14EICFG (*HostXSFR_Access(0xF08C))
+#define P15EICFG (*HostXSFR_Access(0xF08D))
+#define P16EICFG (*HostXSFR_Access(0xF08E))
+#define P17EICFG (*HostXSFR_Access(0xF08F))
+
+#define P21EICFG (*HostXSFR_Access(0xF091))
+#define P22EICFG (*HostXSFR_Access(0xF092))
+#define P23EICFG (*HostXSFR_Access(0xF093))
+#define P24EICFG (*HostXSFR_Access(0xF094))
+#define P25EICFG (*HostXSFR_Access(0xF095))
+#define P26EICFG (*HostXSFR_Access(0xF096))
+
+
+#define P30EICFG (*HostXSFR_Access(0xF098))
+#define P31EICFG (*HostXSFR_Access(0xF099))
+#define P32EICFG (*HostXSFR_Access(0xF09A))
+#define P35EICFG (*HostXSFR_Access(0xF09D))
+#define P36EICFG (*HostXSFR_Access(0xF09E))
+
+
+#define PS_INT0 (*HostXSFR_Access(0xF0C0))
+#define PS_INT1 (*HostXSFR_Access(0xF0C1))
+#define PS_T0 (*HostXSFR_Access(0xF0C2))
+#define PS_T0G (*HostXSFR_Access(0xF0C3))
+#define PS_T1 (*HostXSFR_Access(0xF0C4))
+#define PS_T1G (*HostXSFR_Access(0xF0C5))
+#define PS_T2 (*HostXSFR_Access(0xF0C6))
+#define PS_T2EX (*HostXSFR_Access(0xF0C7))
+#define PS_CAP0 (*HostXSFR_Access(0xF0C8))
+#define PS_CAP1 (*HostXSFR_Access(0xF0C9))
+#define PS_CAP2 (*HostXSFR_Access(0xF0CA))
+#define PS_CAP3 (*HostXSFR_Access(0xF0CB))
+#define PS_ADET (*HostXSFR_Access(0xF0CC))
+#define PS_FB (*HostXSFR_Access(0xF0CD))
+
+
+#define PWMCON (*HostXSFR_Access(0xF120))
+#define PWMOE (*HostXSFR_Access(0xF121))
+#define PWMPINV (*HostXSFR_Access(0xF122))
+#define PWM01PSC (*HostXSFR_Access(0xF123))
+#define PWM23PSC (*HostXSFR_Access(0xF124))
+#define PWM45PSC (*HostXSFR_Access(0xF125))
+#define PWMCNTE (*HostXSFR_Access(0xF126))
+#define PWMCNTM (*HostXSFR_Access(0xF127))
+#define PWMCNTCLR (*HostXSFR_Access(0xF128))
+#define PWMLOADEN (*HostXSFR_Access(0xF129))
+	
+#define PWM0DIV (*HostXSFR_Access(0xF12A))
+#define PWM1DIV (*HostXSFR_Access(0xF12B))
+#define PWM2DIV (*HostXSFR_Access(0xF12C))
+#define PWM3DIV (*HostXSFR_Access(0xF12D))
+#define PWM4DIV (*HostXSFR_Access(0xF12E))
+#define PWM5DIV (*HostXSFR_Access(0xF12F))
+
+#define PWMP0L (*HostXSFR_Access(0xF130))
+#define PWMP0H (*HostXSFR_Access(0xF131))
+#define PWMP1L (*HostXSFR_Access(0xF132))
+#define PWMP1H (*HostXSFR_Access(0xF133))
+#define PWMP2L (*HostXSFR_Access(0xF134))
+#define PWMP2H (*HostXSFR_Access(0xF135))
+#define PWMP3L (*HostXSFR_Access(0xF136))
+#define PWMP3H (*HostXSFR_Access(0xF137))
+#define PWMP4L (*HostXSFR_Access(0xF138))
+#define PWMP4H (*HostXSFR_Access(0xF139))
+#define PWMP5L (*HostXSFR_Access(0xF13A))
+#define PWMP5H (*HostXSFR_Access(0xF13B))
+
+#define PWMD0L (*HostXSFR_Access(0xF140))
+#define PWMD0H (*HostXSFR_Access(0xF141))
+#define PWMD1L (*HostXSFR_Access(0xF142))
+#define PWMD1H (*HostXSFR_Access(0xF143))
+#define PWMD2L (*HostXSFR_Access(0xF144))
+#define PWMD2H (*HostXSFR_Access(0xF145))
+#define PWMD3L (*HostXSFR_Access(0xF146))
+#define PWMD3H (*HostXSFR_Access(0xF147))
+#define PWMD4L (*HostXSFR_Access(0xF148))
+#define PWMD4H (*HostXSFR_Access(0xF149))
+#define PWMD5L (*HostXSFR_Access(0xF14A))
+#define PWMD5H (*HostXSFR_Access(0xF14B))
+
+#define PWMDD0L (*HostXSFR_Access(0xF150))
+#define PWMDD0H (*HostXSFR_Access(0xF151))
+#define PWMDD1L (*HostXSFR_Access(0xF152))
+#define PWMDD1H (*HostXSFR_Access(0xF153))
+#define PWMDD2L (*HostXSFR_Access(0xF154))
+#define PWMDD2H (*HostXSFR_Access(0xF155))
+#define PWMDD3L (*HostXSFR_Access(0xF156))
+#define PWMDD3H (*HostXSFR_Access(0xF157))
+#define PWMDD4L (*HostXSFR_Access(0xF158))
+#define PWMDD4H (*HostXSFR_Access(0xF159))
+#define PWMDD5L (*HostXSFR_Access(0xF15A))
+#define PWMDD5H (*HostXSFR_Access(0xF15B))
+
+#define PWMDTE (*HostXSFR_Access(0xF160))
+#define PWM01DT (*HostXSFR_Access(0xF161))
+#define PWM23DT (*HostXSFR_Access(0xF162))
+#define PWM45DT (*HostXSFR_Access(0xF163))
+#define PWMMASKE (*HostXSFR_Access(0xF164))
+#define PWMMASKD (*HostXSFR_Access(0xF165))
+#define PWMFBKC (*HostXSFR_Access(0xF166))
+#define PWMFBKD (*HostXSFR_Access(0xF167))
+#define PWMPIE (*HostXSFR_Access(0xF168))
+#define PWMZIE (*HostXSFR_Access(0xF169))
+#define PWMUIE (*HostXSFR_Access(0xF16A))
+#define PWMDIE (*HostXSFR_Access(0xF16B))
+#define PWMPIF (*HostXSFR_Access(0xF16C))
+#define PWMZIF (*HostXSFR_Access(0xF16D))
+#define PWMUIF (*HostXSFR_Access(0xF16E))
+#define PWMDIF (*HostXSFR_Access(0xF16F))
+
+#define C0CON0 (*HostXSFR_Access(0xF500))
+#define C0CON1 (*HostXSFR_Access(0xF501))
+#define C0CON2 (*HostXSFR_Access(0xF502))
+#define C1CON0 (*HostXSFR_Access(0xF503))
+#define C1CON1 (*HostXSFR_Access(0xF504))
+#define C1CON2 (*HostXSFR_Access(0xF505))
+	
+#define CNVRCON (*HostXSFR_Access(0xF506))
+#define CNFBCON (*HostXSFR_Access(0xF507))
+#define CNIE (*HostXSFR_Access(0xF508))
+#define CNIF (*HostXSFR_Access(0xF509))
+#define C0ADJE (*HostXSFR_Access(0xF50A))
+#define C1ADJE (*HostXSFR_Access(0xF50B))
+#define C0HYS (*HostXSFR_Access(0xF50C))
+#define C1HYS (*HostXSFR_Access(0xF50D))
+
+
+#define OP0CON0 (*HostXSFR_Access(0xF520))
+#define OP0CON1 (*HostXSFR_Access(0xF521))
+#define OP1CON0 (*HostXSFR_Access(0xF523))
+#define OP1CON1 (*HostXSFR_Access(0xF524))
+#define OP0ADJE (*HostXSFR_Access(0xF526))
+#define OP1ADJE (*HostXSFR_Access(0xF527))
+
+
+#define PGACON0 (*HostXSFR_Access(0xF529))
+#define PGACON1 (*HostXSFR_Access(0xF52A))
+#define PGACON2 (*HostXSFR_Access(0xF52B))
+#define PGACON3 (*HostXSFR_Access(0xF52C))
+#define PGAADJE (*HostXSFR_Access(0xF52D))
+
+#define BRTCON (*HostXSFR_Access(0xF5C0))
+#define BRTDL (*HostXSFR_Access(0xF5C1))
+#define BRTDH (*HostXSFR_Access(0xF5C2))
+
+#define LVDCON (*HostXSFR_Access(0xF690))
+#define BOOTCON (*HostXSFR_Access(0xF691))
+#define ADCLDO (*HostXSFR_Access(0xF692))
+#define LSECRL (*HostXSFR_Access(0xF694))
+#define LSECRH (*HostXSFR_Access(0xF695))
+#define LSECON (*HostXSFR_Access(0xF696))
+
+
+#define UID0 (*HostXSFR_Access(0xF5E0))
+#define UID1 (*HostXSFR_Access(0xF5E1))
+#define UID2 (*HostXSFR_Access(0xF5E2))
+#define UID3 (*HostXSFR_Access(0xF5E3))
+#define UID4 (*HostXSFR_Access(0xF5E4))
+#define UID5 (*HostXSFR_Access(0xF5E5))
+#define UID6 (*HostXSFR_Access(0xF5E6))
+#define UID7 (*HostXSFR_Access(0xF5E7))
+#define UID8 (*HostXSFR_Access(0xF5E8))
+#define UID9 (*HostXSFR_Access(0xF5E9))
+#define UID10 (*HostXSFR_Access(0xF5EA))
+#define UID11 (*HostXSFR_Access(0xF5EB))
+
+
+/*--------------------------------------------------------------- --------
+  BIT Register  
+-------------------------------------------------------------------------*/
+/*  P0  */
+#define P07 (HostSFR_Access(0x80)->Bit.B7) //P0^7
+#define P06 (HostSFR_Access(0x80)->Bit.B6) //P0^6
+#define P05 (HostSFR_Access(0x80)->Bit.B5) //P0^5
+#define P04 (HostSFR_Access(0x80)->Bit.B4) //P0^4
+#define P03 (HostSFR_Access(0x80)->Bit.B3) //P0^3
+#define P02 (HostSFR_Access(0x80)->Bit.B2) //P0^2
+#define P01 (HostSFR_Access(0x80)->Bit.B1) //P0^1
+#define P00 (HostSFR_Access(0x80)->Bit.B0) //P0^0
+/*  P1  */
+#define P17 (HostSFR_Access(0x90)->Bit.B7) //P1^7
+#define P16 (HostSFR_Access(0x90)->Bit.B6) //P1^6
+#define P15 (HostSFR_Access(0x90)->Bit.B5) //P1^5
+#define P14 (HostSFR_Access(0x90)->Bit.B4) //P1^4
+#define P13 (HostSFR_Access(0x90)->Bit.B3) //P1^3
+#define P12 (HostSFR_Access(0x90)->Bit.B2) //P1^2
+#define P11 (HostSFR_Access(0x90)->Bit.B1) //P1^1
+#define P10 (HostSFR_Access(0x90)->Bit.B0) //P1^0
+/*  P2  */
+#define P27 (HostSFR_Access(0xA0)->Bit.B7) //P2^7
+#define P26 (HostSFR_Access(0xA0)->Bit.B6) //P2^6
+#define P25 (HostSFR_Access(0xA0)->Bit.B5) //P2^5
+#define P24 (HostSFR_Access(0xA0)->Bit.B4) //P2^4
+#define P23 (HostSFR_Access(0xA0)->Bit.B3) //P2^3
+#define P22 (HostSFR_Access(0xA0)->Bit.B2) //P2^2
+#define P21 (HostSFR_Access(0xA0)->Bit.B1) //P2^1
+#define P20 (HostSFR_Access(0xA0)->Bit.B0) //P2^0
+/*  P3  */
+#define P37 (HostSFR_Access(0xB0)->Bit.B7) //P3^7
+#define P36 (HostSFR_Access(0xB0)->Bit.B6) //P3^6
+#define P35 (HostSFR_Access(0xB0)->Bit.B5) //P3^5
+#define P34 (HostSFR_Access(0xB0)->Bit.B4) //P3^4
+#define P33 (HostSFR_Access(0xB0)->Bit.B3) //P3^3
+#define P32 (HostSFR_Access(0xB0)->Bit.B2) //P3^2
+#define P31 (HostSFR_Access(0xB0)->Bit.B1) //P3^1
+#define P30 (HostSFR_Access(0xB0)->Bit.B0) //P3^0
+/*  TCON  */
+#define IT0 (HostSFR_Access(0x88)->Bit.B0) //TCON^0
+#define IE0 (HostSFR_Access(0x88)->Bit.B1) //TCON^1
+#define IT1 (HostSFR_Access(0x88)->Bit.B2) //TCON^2
+#define IE1 (HostSFR_Access(0x88)->Bit.B3) //TCON^3
+#define TR0 (HostSFR_Access(0x88)->Bit.B4) //TCON^4
+#define TF0 (HostSFR_Access(0x88)->Bit.B5) //TCON^5
+#define TR1 (HostSFR_Access(0x88)->Bit.B6) //TCON^6
+#define TF1 (HostSFR_Access(0x88)->Bit.B7) //TCON^7
+/*  SCON0 */
+#define RI0 (HostSFR_Access(0x98)->Bit.B0) //SCON0^0
+#define TI0 (HostSFR_Access(0x98)->Bit.B1) //SCON0^1
+#define U0RB8 (HostSFR_Access(0x98)->Bit.B2) //SCON0^2
+#define U0TB8 (HostSFR_Access(0x98)->Bit.B3) //SCON0^3
+#define U0REN (HostSFR_Access(0x98)->Bit.B4) //SCON0^4
+#define U0SM2 (HostSFR_Access(0x98)->Bit.B5) //SCON0^5
+#define U0SM1 (HostSFR_Access(0x98)->Bit.B6) //SCON0^6
+#define U0SM0 (HostSFR_Access(0x98)->Bit.B7) //SCON0^7
+/*  IE */
+#define EX0 (HostSFR_Access(0xA8)->Bit.B0) //IE^0
+#define ET0 (HostSFR_Access(0xA8)->Bit.B1) //IE^1
+#define EX1 (HostSFR_Access(0xA8)->Bit.B2) //IE^2
+#define ET1 (HostSFR_Access(0xA8)->Bit.B3) //IE^3
+#define ES0 (HostSFR_Access(0xA8)->Bit.B4) //IE^4
+#define ET2 (HostSFR_Access(0xA8)->Bit.B5) //IE^5
+#define ES1 (HostSFR_Access(0xA8)->Bit.B6) //IE^6
+#define EA (HostSFR_Access(0xA8)->Bit.B7) //IE^7
+ /*  IP */
+#define PX0 (HostSFR_Access(0xB8)->Bit.B0) //IP^0
+#define PT0 (HostSFR_Access(0xB8)->Bit.B1) //IP^1
+#define PX1 (HostSFR_Access(0xB8)->Bit.B2) //IP^2
+#define PT1 (HostSFR_Access(0xB8)->Bit.B3) //IP^3
+#define PS0 (HostSFR_Access(0xB8)->Bit.B4) //IP^4
+#define PT2 (HostSFR_Access(0xB8)->Bit.B5) //IP^5
+#define PS1 (HostSFR_Access(0xB8)->Bit.B6) //IP^6
+ /*  T2CON */
+#define T2I0 (HostSFR_Access(0xC8)->Bit.B0) //T2CON^0
+#define T2I1 (HostSFR_Access(0xC8)->Bit.B1) //T2CON^1
+#define T2CM (HostSFR_Access(0xC8)->Bit.B2) //T2CON^2
+#define T2R0 (HostSFR_Access(0xC8)->Bit.B3) //T2CON^3
+#define T2R1 (HostSFR_Access(0xC8)->Bit.B4) //T2CON^4
+#define CAPES (HostSFR_Access(0xC8)->Bit.B5) //T2CON^5
+#define I3FR (HostSFR_Access(0xC8)->Bit.B6) //T2CON^6
+#define T2PS (HostSFR_Access(0xC8)->Bit.B7) //T2CON^7
+ /* PSW  */
+#define P (HostSFR_Access(0xD0)->Bit.B0) //PSW^0
+#define OV (HostSFR_Access(0xD0)->Bit.B2) //PSW^2
+#define RS0 (HostSFR_Access(0xD0)->Bit.B3) //PSW^3
+#define RS1 (HostSFR_Access(0xD0)->Bit.B4) //PSW^4
+#define F0 (HostSFR_Access(0xD0)->Bit.B5) //PSW^5
+#define AC (HostSFR_Access(0xD0)->Bit.B6) //PSW^6
+#define CY (HostSFR_Access(0xD0)->Bit.B7) //PSW^7
+		
+/*****************************************************************************/
+/* Global type definitions ('typedef') */
+/*****************************************************************************/
+
+/*-----------------------------------------------------------------
+**	Peripheral memory map
+------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+**IRQ ж 
+------------------------------------------------------------------*/
+/*------IE--------------------------------------------------------*/
+#define IRQ_IE_EA_Pos			(7)
+#define IRQ_IE_EA_Msk			(0x1 << IRQ_IE_EA_Pos)
+#define IRQ_IE_ES1_Pos			(6)
+#define IRQ_IE_ES1_Msk			(0x1 << IRQ_IE_ES1_Pos)
+#define IRQ_IE_ET2_Pos			(5)
+#define IRQ_IE_ET2_Msk			(0x1 << IRQ_IE_ET2_Pos)
+#define IRQ_IE_ES0_Pos			(4)
+#define IRQ_IE_ES0_Msk			(0x1 << IRQ_IE_ES0_Pos)
+#define IRQ_IE_ET1_Pos			(3)
+#define IRQ_IE_ET1_Msk			(0x1 << IRQ_IE_ET1_Pos)
+#define IRQ_IE_EX1_Pos			(2)
+#define IRQ_IE_EX1_Msk			(0x1 << IRQ_IE_EX1_Pos)
+#define IRQ_IE_ET0_Pos			(1)
+#define IRQ_IE_ET0_Msk			(0x1 << IRQ_IE_ET0_Pos)
+#define IRQ_IE_EX0_Pos			(0)
+#define IRQ_IE_EX0_Msk			(0x1 << IRQ_IE_EX0_Pos)
+/*------EIE2------------------------------------------------------*/
+#define IRQ_EIE2_SPIIE_Pos		(7)
+#define IRQ_EIE2_SPIIE_Msk		(0x1 << IRQ_EIE2_SPIIE_Pos)
+#define IRQ_EIE2_I2CIE_Pos		(6)
+#define IRQ_EIE2_I2CIE_Msk		(0x1 << IRQ_EIE2_I2CIE_Pos)
+#define IRQ_EIE2_WDTIE_Pos		(5)
+#define IRQ_EIE2_WDTIE_Msk		(0x1 << IRQ_EIE2_WDTIE_Pos)
+#define IRQ_EIE2_ADCIE_Pos		(4)
+#define IRQ_EIE2_ADCIE_Msk		(0x1 << IRQ_EIE2_ADCIE_Pos)
+#define IRQ_EIE2_PWMIE_Pos		(3)
+#define IRQ_EIE2_PWMIE_Msk		(0x1 << IRQ_EIE2_PWMIE_Pos)
+#define IRQ_EIE2_ET4IE_Pos		(1)
+#define IRQ_EIE2_ET4IE_Msk		(0x1 << IRQ_EIE2_ET4IE_Pos)
+#define IRQ_EIE2_ET3IE_Pos		(0)
+#define IRQ_EIE2_ET3IE_Msk		(0x1 << IRQ_EIE2_ET3IE_Pos)
+/*------EIF2------------------------------------------------------*/
+#define IRQ_EIF2_SPIIF_Pos		(7)
+#define IRQ_EIF2_SPIIF_Msk		(0x1 << IRQ_EIF2_SPIIF_Pos)
+#define IRQ_EIF2_I2CIF_Pos		(6)
+#define IRQ_EIF2_I2CIF_Msk		(0x1 << IRQ_EIF2_I2CIF_Pos)
+#define IRQ_EIF2_ADCIF_Pos		(4)
+#define IRQ_EIF2_ADCIF_Msk		(0x1 << IRQ_EIF2_ADCIF_Pos)
+#define IRQ_EIF2_PWMIF_Pos		(3)
+#define IRQ_EIF2_PWMIF_Msk		(0x1 << IRQ_EIF2_PWMIF_Pos)
+#define IRQ_EIF2_TF4_Pos		(1)
+#define IRQ_EIF2_TF4_Msk		(0x1 << IRQ_EIF2_TF4_Pos)
+#define IRQ_EIF2_TF3_Pos		(0)
+#define IRQ_EIF2_TF3_Msk		(0x1 << IRQ_EIF2_TF3_Pos)
+/*------IP--------------------------------------------------------*/
+#define IRQ_IP_PS1_Pos			(6)
+#define IRQ_IP_PS1_Msk			(0x1 << IRQ_IP_PS1_Pos)
+#define IRQ_IP_PT2_Pos			(5)
+#define IRQ_IP_PT2_Msk			(0x1 << IRQ_IP_PT2_Pos)
+#define IRQ_IP_PS0_Pos			(4)
+#define IRQ_IP_PS0_Msk			(0x1 << IRQ_IP_PS0_Pos)
+#define IRQ_IP_PT1_Pos			(3)
+#define IRQ_IP_PT1_Msk			(0x1 << IRQ_IP_PT1_Pos)
+#define IRQ_IP_PX1_Pos			(2)
+#define IRQ_IP_PX1_Msk			(0x1 << IRQ_IP_PX1_Pos)
+#define IRQ_IP_PT0_Pos			(1)
+#define IRQ_IP_PT0_Msk			(0x1 << IRQ_IP_PT0_Pos)
+#define IRQ_IP_PX0_Pos			(0)
+#define IRQ_IP_PX0_Msk			(0x1 << IRQ_IP_PX0_Pos)
+/*------T2IE------------------------------------------------------*/
+#define IRQ_T2IE_T2OVIE_Pos		(7)
+#define IRQ_T2IE_T2OVIE_Msk		(0x1 << IRQ_T2IE_T2OVIE_Pos)
+#define IRQ_T2IE_T2EXIE_Pos		(6)
+#define IRQ_T2IE_T2EXIE_Msk		(0x1 << IRQ_T2IE_T2EXIE_Pos)
+#define IRQ_T2IE_T2C3IE_Pos		(3)
+#define IRQ_T2IE_T2C3IE_Msk		(0x1 << IRQ_T2IE_T2C3IE_Pos)
+#define IRQ_T2IE_T2C2IE_Pos		(2)
+#define IRQ_T2IE_T2C2IE_Msk		(0x1 << IRQ_T2IE_T2C2IE_Pos)
+#define IRQ_T2IE_T2C1IE_Pos		(1)
+#define IRQ_T2IE_T2C1IE_Msk		(0x1 << IRQ_T2IE_T2C1IE_Pos)
+#define IRQ_T2IE_T2C0IE_Pos		(0)
+#define IRQ_T2IE_T2C0IE_Msk		(0x1 << IRQ_T2IE_T2C0IE_Pos)
+/*------T2IF------------------------------------------------------*/
+#define IRQ_T2IF_T2F_Pos		(7)
+#define IRQ_T2IF_T2F_Msk		(0x1 << IRQ_T2IF_T2F_Pos)
+#define IRQ_T2IF_T2EXIF_Pos		(6)
+#define IRQ_T2IF_T2EXIF_Msk		(0x1 << IRQ_T2IF_T2EXIF_Pos)
+#define IRQ_T2IF_T2C3IF_Pos		(3)
+#define IRQ_T2IF_T2C3IF_Msk		(0x1 << IRQ_T2IF_T2C3IF_Pos)
+#define IRQ_T2IF_T2C2IF_Pos		(2)
+#define IRQ_T2IF_T2C2IF_Msk		(0x1 << IRQ_T2IF_T2C2IF_Pos)
+#define IRQ_T2IF_T2C1IF_Pos		(1)
+#define IRQ_T2IF_T2C1IF_Msk		(0x1 << IRQ_T2IF_T2C1IF_Pos)
+#define IRQ_T2IF_T2C0IF_Pos		(0)
+#define IRQ_T2IF_T2C0IF_Msk		(0x1 << IRQ_T2IF_T2C0IF_Pos)
+
+
+
+/*-----------------------------------------------------------------
+**EPWM  
+------------------------------------------------------------------*/
+/*------PWMDTE----------------------------------------------------*/
+#define EPWM_PWMDTE_PWM45DTE_Pos		(2)
+#define EPWM_PWMDTE_PWM45DTE_Msk		(0x1 << EPWM_PWMDTE_PWM45DTE_Pos)
+#define EPWM_PWMDTE_PWM23DTE_Pos		(1)
+#define EPWM_PWMDTE_PWM23DTE_Msk		(0x1 << EPWM_PWMDTE_PWM23DTE_Pos)
+#define EPWM_PWMDTE_PWM01DTE_Pos		(0)
+#define EPWM_PWMDTE_PWM01DTE_Msk		(0x1 << EPWM_PWMDTE_PWM01DTE_Pos)
+/*------PWMFBKC----------------------------------------------------*/
+#define EPWM_PWMFBKC_PWMFBIE_Pos		(7)
+#define EPWM_PWMFBKC_PWMFBIE_Msk		(0x1 << EPWM_PWMFBKC_PWMFBIE_Pos)
+#define EPWM_PWMFBKC_PWMFBF_Pos			(6)
+#define EPWM_PWMFBKC_PWMFBF_Msk			(0x1 << EPWM_PWMFBKC_PWMFBF_Pos)
+#define EPWM_PWMFBKC_PWMFBCCE_Pos		(5)
+#define EPWM_PWMFBKC_PWMFBCCE_Msk		(0x1 << EPWM_PWMFBKC_PWMFBCCE_Pos)
+#define EPWM_PWMFBKC_PWMFBKSW_Pos		(4)
+#define EPWM_PWMFBKC_PWMFBKSW_Msk		(0x1 << EPWM_PWMFBKC_PWMFBKSW_Pos)
+#define EPWM_PWMFBKC_PWMFBES_Pos		(3)
+#define EPWM_PWMFBKC_PWMFBES_Msk		(0x1 << EPWM_PWMFBKC_PWMFBES_Pos)
+#define EPWM_PWMFBKC_PWMFBEN_Pos		(1)
+#define EPWM_PWMFBKC_PWMFBEN_Msk		(0x1 << EPWM_PWMFBKC_PWMFBEN_Pos)
+
+
+/*-----------------------------------------------------------------
+**ACMP  
+------------------------------------------------------------------*/
+/*------C0CON0----------------------------------------------------*/
+#define ACMP_C0CON0_C0EN_Pos		(7)
+#define ACMP_C0CON0_C0EN_Msk		(0x1 << ACMP_C0CON0_C0EN_Pos)
+#define ACMP_C0CON0_C0COFM_Pos		(6)
+#define ACMP_C0CON0_C0COFM_Msk		(0x1 << ACMP_C0CON0_C0COFM_Pos)
+#define ACMP_C0CON0_C0N2G_Pos		(5)
+#define ACMP_C0CON0_C0N2G_Msk		(0x1 << ACMP_C0CON0_C0N2G_Pos)
+#define ACMP_C0CON0_C0NS_Pos		(3)
+#define ACMP_C0CON0_C0NS_Msk		(0x3 << ACMP_C0CON0_C0NS_Pos)
+#define ACMP_C0CON0_C0PS_Pos		(0)
+#define ACMP_C0CON0_C0PS_Msk		(0x7 << ACMP_C0CON0_C0PS_Pos)
+/*------C0CON1----------------------------------------------------*/
+#define ACMP_C0CON1_C0OUT_Pos		(7)
+#define ACMP_C0CON1_C0OUT_Msk		(0x1 << ACMP_C0CON1_C0OUT_Pos)
+#define ACMP_C0CON1_C0CRS_Pos		(6)
+#define ACMP_C0CON1_C0CRS_Msk		(0x1 << ACMP_C0CON1_C0CRS_Pos)
+#define ACMP_C0CON1_C0ADJ_Pos		(0)
+#define ACMP_C0CON1_C0ADJ_Msk		(0x1F<< ACMP_C0CON1_C0ADJ_Pos)
+/*------C0CON2----------------------------------------------------*/
+#define ACMP_C0CON2_C0POS_Pos		(5)
+#define ACMP_C0CON2_C0POS_Msk		(0x1 << ACMP_C0CON2_C0POS_Pos)
+#define ACMP_C0CON2_C0FE_Pos		(4)
+#define ACMP_C0CON2_C0FE_Msk		(0x1 << ACMP_C0CON2_C0FE_Pos)
+#define ACMP_C0CON2_C0FS_Pos		(0)
+#define ACMP_C0CON2_C0FS_Msk		(0xF << ACMP_C0CON2_C0FS_Pos)
+/*------C1CON0----------------------------------------------------*/
+#define ACMP_C1CON0_C1EN_Pos		(7)
+#define ACMP_C1CON0_C1EN_Msk		(0x1 << ACMP_C1CON0_C1EN_Pos)
+#define ACMP_C1CON0_C1COFM_Pos		(6)
+#define ACMP_C1CON0_C1COFM_Msk		(0x1 << ACMP_C1CON0_C1COFM_Pos)
+#define ACMP_C1CON0_C1N2G_Pos		(5)
+#define ACMP_C1CON0_C1N2G_Msk		(0x1 << ACMP_C1CON0_C1N2G_Pos)
+#define ACMP_C1CON0_C1NS_Pos		(3)
+#define ACMP_C1CON0_C1NS_Msk		(0x3 << ACMP_C1CON0_C1NS_Pos)
+#define ACMP_C1CON0_C1PS_Pos		(0)
+#define ACMP_C1CON0_C1PS_Msk		(0x7 << ACMP_C1CON0_C1PS_Pos)
+/*------C1CON1----------------------------------------------------*/
+#define ACMP_C1CON1_C1OUT_Pos		(7)
+#define ACMP_C1CON1_C1OUT_Msk		(0x1 << ACMP_C1CON1_C1OUT_Pos)
+#define ACMP_C1CON1_C1CRS_Pos		(6)
+#define ACMP_C1CON1_C1CRS_Msk		(0x1 << ACMP_C1CON1_C1CRS_Pos)
+#define ACMP_C1CON1_C1ADJ_Pos		(0)
+#define ACMP_C1CON1_C1ADJ_Msk		(0x1F<< ACMP_C1CON1_C1ADJ_Pos)
+/*------C1CON2----------------------------------------------------*/
+#define ACMP_C1CON2_C1POS_Pos		(5)
+#define ACMP_C1CON2_C1POS_Msk		(0x1 << ACMP_C1CON2_C1POS_Pos)
+#define ACMP_C1CON2_C1FE_Pos		(4)
+#define ACMP_C1CON2_C1FE_Msk		(0x1 << ACMP_C1CON2_C1FE_Pos)
+#define ACMP_C1CON2_C1FS_Pos		(0)
+#define ACMP_C1CON2_C1FS_Msk		(0xF << ACMP_C1CON2_C1FS_Pos)
+/*------CNVRCON---------------------------------------------------*/
+#define ACMP_CNVRCON_CNDIVS_Pos		(5)
+#define ACMP_CNVRCON_CNDIVS_Msk		(0x1 << ACMP_CNVRCON_CNDIVS_Pos)
+#define ACMP_CNVRCON_CNSVR_Pos		(4)
+#define ACMP_CNVRCON_CNSVR_Msk		(0x1 << ACMP_CNVRCON_CNSVR_Pos)
+#define ACMP_CNVRCON_CNSVS_Pos		(0)
+#define ACMP_CNVRCON_CNSVS_Msk		(0xF << ACMP_CNVRCON_CNSVS_Pos)
+/*------CNFBCON---------------------------------------------------*/
+#define ACMP_CNFBCON_C1FBEN_Pos		(3)
+#define ACMP_CNFBCON_C1FBEN_Msk		(0x1 << ACMP_CNFBCON_C1FBEN_Pos)
+#define ACMP_CNFBCON_C0FBEN_Pos		(2)
+#define ACMP_CNFBCON_C0FBEN_Msk		(0x1 << ACMP_CNFBCON_C0FBEN_Pos)
+#define ACMP_CNFBCON_C1FBLS_Pos		(1)
+#define ACMP_CNFBCON_C1FBLS_Msk		(0x1 << ACMP_CNFBCON_C1FBLS_Pos)
+#define ACMP_CNFBCON_C0FBLS_Pos		(0)
+#define ACMP_CNFBCON_C0FBLS_Msk		(0x1 << ACMP_CNFBCON_C0FBLS_Pos)
+/*------CNIE-------------------------------------------------------*/
+#define ACMP_CNIE_C1IE_Pos			(1)
+#define ACMP_CNIE_C1IE_Msk			(0x1 << ACMP_CNIE_C1IE_Pos)
+#define ACMP_CNIE_C0IE_Pos			(0)
+#define ACMP_CNIE_C0IE_Msk			(0x1 << ACMP_CNIE_C0IE_Pos)
+/*------CNIF-------------------------------------------------------*/
+#define ACMP_CNIF_C1IF_Pos			(1)
+#define ACMP_CNIF_C1IF_Msk			(0x1 << ACMP_CNIF_C1IF_Pos)
+#define ACMP_CNIF_C0IF_Pos			(0)
+#define ACMP_CNIF_C0IF_Msk			(0x1 << ACMP_CNIF_C0IF_Pos)
+
+/*------C0HYS-------------------------------------------------------*/
+#define ACMP_C0HYS_PNS_Pos			(2)
+#define ACMP_C0HYS_PNS_Msk			(0x3 << ACMP_C0HYS_PNS_Pos)
+#define ACMP_C0HYS_S_Pos			(0)
+#define ACMP_C0HYS_S_Msk			(0x3 << ACMP_C0HYS_S_Pos)
+/*------C1HYS-------------------------------------------------------*/
+#define ACMP_C1HYS_PNS_Pos			(2)
+#define ACMP_C1HYS_PNS_Msk			(0x3 << ACMP_C1HYS_PNS_Pos)
+#define ACMP_C1HYS_S_Pos			(0)
+#define ACMP_C1HYS_S_Msk			(0x3 << ACMP_C1HYS_S_Pos)
+
+/*-----------------------------------------------------------------
+** OPA 
+------------------------------------------------------------------*/
+/*------OP0CON0-------------------------------------------------------*/
+#define OPA_OP0CON0_OP0EN_Pos		(7)
+#define OPA_OP0CON0_OP0EN_Msk		(0x1 << OPA_OP0CON0_OP0EN_Pos)
+#define OPA_OP0CON0_OP0COFM_Pos		(6)
+#define OPA_OP0CON0_OP0COFM_Msk		(0x1 << OPA_OP0CON0_OP0COFM_Pos)
+#define OPA_OP0CON0_OP0FIL_Pos		(5)
+#define OPA_OP0CON0_OP0FIL_Msk		(0x1 << OPA_OP0CON0_OP0FIL_Pos)
+#define OPA_OP0CON0_OP0OS_Pos		(4)
+#define OPA_OP0CON0_OP0OS_Msk		(0x1 << OPA_OP0CON0_OP0OS_Pos)
+#define OPA_OP0CON0_OP0NS_Pos		(2)
+#define OPA_OP0CON0_OP0NS_Msk		(0x3 << OPA_OP0CON0_OP0NS_Pos)
+#define OPA_OP0CON0_OP0PS_Pos		(0)
+#define OPA_OP0CON0_OP0PS_Msk		(0x3 << OPA_OP0CON0_OP0PS_Pos)
+
+/*------OP1CON0-------------------------------------------------------*/
+#define OPA_OP1CON0_OP1EN_Pos		(7)
+#define OPA_OP1CON0_OP1EN_Msk		(0x1 << OPA_OP1CON0_OP1EN_Pos)
+#define OPA_OP1CON0_OP1COFM_Pos		(6)
+#define OPA_OP1CON0_OP1COFM_Msk		(0x1 << OPA_OP1CON0_OP1COFM_Pos)
+#define OPA_OP1CON0_OP1FIL_Pos		(5)
+#define OPA_OP1CON0_OP1FIL_Msk		(0x1 << OPA_OP1CON0_OP1FIL_Pos)
+#define OPA_OP1CON0_OP1OS_Pos		(4)
+#define OPA_OP1CON0_OP1OS_Msk		(0x1 << OPA_OP1CON0_OP1OS_Pos)
+#define OPA_OP1CON0_OP1NS_Pos		(2)
+#define OPA_OP1CON0_OP1NS_Msk		(0x3 << OPA_OP1CON0_OP1NS_Pos)
+#define OPA_OP1CON0_OP1PS_Pos		(0)
+#define OPA_OP1CON0_OP1PS_Msk		(0x3 << OPA_OP1CON0_OP1PS_Pos)
+
+/*------OP0CON1-------------------------------------------------------*/
+#define OPA_OP0CON1_OP0DOUT_Pos		(7)
+#define OPA_OP0CON1_OP0DOUT_Msk		(0x1 << OPA_OP0CON1_OP0DOUT_Pos)
+#define OPA_OP0CON1_OP0CRS_Pos		(6)
+#define OPA_OP0CON1_OP0CRS_Msk		(0x1 << OPA_OP0CON1_OP0CRS_Pos)
+#define OPA_OP0CON1_OP0ADJ_Pos		(0)
+#define OPA_OP0CON1_OP0ADJ_Msk		(0x1F << OPA_OP0CON1_OP0ADJ_Pos)
+/*------OP1CON1-------------------------------------------------------*/
+#define OPA_OP1CON1_OP1DOUT_Pos		(7)
+#define OPA_OP1CON1_OP1DOUT_Msk		(0x1 << OPA_OP1CON1_OP1DOUT_Pos)
+#define OPA_OP1CON1_OP1CRS_Pos		(6)
+#define OPA_OP1CON1_OP1CRS_Msk		(0x1 << OPA_OP1CON1_OP1CRS_Pos)
+#define OPA_OP1CON1_OP1ADJ_Pos		(0)
+#define OPA_OP1CON1_OP1ADJ_Msk		(0x1F << OPA_OP1CON1_OP1ADJ_Pos)
+
+/*-----------------------------------------------------------------
+** PGA 
+------------------------------------------------------------------*/
+/*------PGACON0-------------------------------------------------------*/
+#define PGA_PGACON0_PGAEN_Pos		(7)
+#define PGA_PGACON0_PGAEN_Msk		(0x1 << PGA_PGACON0_PGAEN_Pos)
+#define PGA_PGACON0_PGAGS_Pos		(4)
+#define PGA_PGACON0_PGAGS_Msk		(0x7 << PGA_PGACON0_PGAGS_Pos)
+#define PGA_PGACON0_PGAMS_Pos		(2)
+#define PGA_PGACON0_PGAMS_Msk		(0x3 << PGA_PGACON0_PGAMS_Pos)
+#define PGA_PGACON0_PGAPS_Pos		(0)
+#define PGA_PGACON0_PGAPS_Msk		(0x3 << PGA_PGACON0_PGAPS_Pos)
+/*------PGACON1-------------------------------------------------------*/
+#define PGA_PGACON1_PGAAMS_Pos	(4)
+#define PGA_PGACON1_PGAAMS_Msk	(0x1 << PGA_PGACON1_PGAAMS_Pos)
+#define PGA_PGACON1_PGASHT_Pos		(0)
+#define PGA_PGACON1_PGASHT_Msk		(0xF << PGA_PGACON1_PGASHT_Pos)
+/*------PGACON2-------------------------------------------------------*/
+#define PGA_PGACON2_PGADOUT_Pos	(7)
+#define PGA_PGACON2_PGADOUT_Msk	(0x1 << PGA_PGACON2_PGADOUT_Pos)
+#define PGA_PGACON2_PGATEN_Pos		(3)
+#define PGA_PGACON2_PGATEN_Msk		(0x1 << PGA_PGACON2_PGATEN_Pos)
+/*------PGACON3-------------------------------------------------------*/
+#define PGA_PGACON3_PGAMODE_Pos	(6)
+#define PGA_PGACON3_PGAMODE_Msk	(0x3 << PGA_PGACON3_PGAMODE_Pos)
+#define PGA_PGACON3_PGAADJ_Pos		(0)
+#define PGA_PGACON3_PGAADJ_Msk		(0x3F << PGA_PGACON3_PGAADJ_Pos)
+
+/*-----------------------------------------------------------------
+**ADC  
+------------------------------------------------------------------*/
+/*------ADCON0----------------------------------------------------*/
+#define ADC_ADCON0_ADCHS4_Pos		(7)
+#define ADC_ADCON0_ADCHS4_Msk		(0x1 << ADC_ADCON0_ADCHS4_Pos)
+#define ADC_ADCON0_ADFM_Pos			(6)
+#define ADC_ADCON0_ADFM_Msk			(0x1 << ADC_ADCON0_ADFM_Pos)
+#define ADC_ADCON0_AN31SEL_Pos		(2)
+#define ADC_ADCON0_AN31SEL_Msk		(0x7 << ADC_ADCON0_AN31SEL_Pos)
+#define ADC_ADCON0_ADGO_Pos			(1)
+#define ADC_ADCON0_ADGO_Msk			(0x1 << ADC_ADCON0_ADGO_Pos)
+/*------ADCON1----------------------------------------------------*/
+#define ADC_ADCON1_ADEN_Pos			(7)
+#define ADC_ADCON1_ADEN_Msk			(0x1 << ADC_ADCON1_ADEN_Pos)
+#define ADC_ADCON1_ADCKS_Pos		(4)
+#define ADC_ADCON1_ADCKS_Msk		(0x7 << ADC_ADCON1_ADCKS_Pos)
+#define ADC_ADCON1_ADCHS_Pos		(0)
+#define ADC_ADCON1_ADCHS_Msk		(0xF << ADC_ADCON1_ADCHS_Pos)
+/*------ADCON2----------------------------------------------------*/
+#define ADC_ADCON2_ADCEX_Pos		(7)
+#define ADC_ADCON2_ADCEX_Msk		(0x1 << ADC_ADCON2_ADCEX_Pos)
+#define ADC_ADCON2_ADTGS_Pos		(4)
+#define ADC_ADCON2_ADTGS_Msk		(0x3 << ADC_ADCON2_ADTGS_Pos)
+#define ADC_ADCON2_ADEGS_Pos		(2)
+#define ADC_ADCON2_ADEGS_Msk		(0x3 << ADC_ADCON2_ADEGS_Pos)
+/*------ADCMPC----------------------------------------------------*/
+#define ADC_ADCMPC_ADFBEN_Pos		(7)
+#define ADC_ADCMPC_ADFBEN_Msk		(0x1 << ADC_ADCMPC_ADFBEN_Pos)
+#define ADC_ADCMPC_ADCMPPS_Pos		(6)
+#define ADC_ADCMPC_ADCMPPS_Msk		(0x1 << ADC_ADCMPC_ADCMPPS_Pos)
+#define ADC_ADCMPC_ADCMPO_Pos		(4)
+#define ADC_ADCMPC_ADCMPO_Msk		(0x1 << ADC_ADCMPC_ADCMPO_Pos)
+#define ADC_ADCMPC_ADDLY_Pos		(0)
+#define ADC_ADCMPC_ADDLY_Msk		(0x3 << ADC_ADCMPC_ADDLY_Pos)
+/*------ADCLDO----------------------------------------------------*/
+#define ADC_ADCLDO_LDOEN_Pos		(7)
+#define ADC_ADCLDO_LDOEN_Msk		(0x1 << ADC_ADCLDO_LDOEN_Pos)
+#define ADC_ADCLDO_VSEL_Pos			(5)
+#define ADC_ADCLDO_VSEL_Msk			(0x3 << ADC_ADCLDO_VSEL_Pos)
+
+/*-----------------------------------------------------------------
+**Timer
+------------------------------------------------------------------*/
+/*------TMOD------------------------------------------------------*/
+#define TMR_TMOD_GATE1_Pos				(7)
+#define TMR_TMOD_GATE1_Msk				(0x1 << TMR_TMOD_GATE1_Pos)
+#define TMR_TMOD_CT1_Pos				(6)
+#define TMR_TMOD_CT1_Msk				(0x1 << TMR_TMOD_CT1_Pos)
+#define TMR_TMOD_T1Mn_Pos				(4)
+#define TMR_TMOD_T1Mn_Msk				(0x3 << TMR_TMOD_T1Mn_Pos)
+#define TMR_TMOD_GATE0_Pos				(3)
+#define TMR_TMOD_GATE0_Msk				(0x1 << TMR_TMOD_GATE0_Pos)
+#define TMR_TMOD_CT0_Pos				(2)
+#define TMR_TMOD_CT0_Msk				(0x1 << TMR_TMOD_CT0_Pos)
+#define TMR_TMOD_T0Mn_Pos				(0)
+#define TMR_TMOD_T0Mn_Msk				(0x3 << TMR_TMOD_T0Mn_Pos)
+/*------TCON------------------------------------------------------*/
+#define TMR_TCON_TF1_Pos				(7)
+#define TMR_TCON_TF1_Msk				(0x1 << TMR_TCON_TF1_Pos)
+#define TMR_TCON_TR1_Pos				(6)
+#define TMR_TCON_TR1_Msk				(0x1 << TMR_TCON_TR1_Pos)
+#define TMR_TCON_TF0_Pos				(5)
+#define TMR_TCON_TF0_Msk				(0x1 << TMR_TCON_TF0_Pos)
+#define TMR_TCON_TR0_Pos				(4)
+#define TMR_TCON_TR0_Msk				(0x1 << TMR_TCON_TR0_Pos)
+#define TMR_TCON_IE1_Pos				(3)
+#define TMR_TCON_IE1_Msk				(0x1 << TMR_TCON_IE1_Pos)
+#define TMR_TCON_IT1_Pos				(2)
+#define TMR_TCON_IT1_Msk				(0x1 << TMR_TCON_IT1_Pos)
+#define TMR_TCON_IE0_Pos				(1)
+#define TMR_TCON_IE0_Msk				(0x1 << TMR_TCON_IE0_Pos)
+#define TMR_TCON_IT0_Pos				(0)
+#define TMR_TCON_IT0_Msk				(0x1 << TMR_TCON_IT0_Pos)
+/*------CKCON-----------------------------------------------------*/
+#define TMR_CKCON_WTSn_Pos				(5)
+#define TMR_CKCON_WTSn_Msk				(0x7 << TMR_CKCON_WTSn_Pos)
+#define TMR_CKCON_T1M_Pos				(4)
+#define TMR_CKCON_T1M_Msk				(0x1 << TMR_CKCON_T1M_Pos)
+#define TMR_CKCON_T0M_Pos				(3)
+#define TMR_CKCON_T0M_Msk				(0x1 << TMR_CKCON_T0M_Pos)
+/*------T2CON-----------------------------------------------------*/
+#define TMR_T2CON_T2PS_Pos				(7)
+#define TMR_T2CON_T2PS_Msk				(0x1 << TMR_T2CON_T2PS_Pos)
+#define TMR_T2CON_I3FR_Pos				(6)
+#define TMR_T2CON_I3FR_Msk				(0x1 << TMR_T2CON_I3FR_Pos)
+#define TMR_T2CON_CAPES_Pos				(5)
+#define TMR_T2CON_CAPES_Msk				(0x1 << TMR_T2CON_CAPES_Pos)
+#define TMR_T2CON_T2Rn_Pos				(3)
+#define TMR_T2CON_T2Rn_Msk				(0x3 << TMR_T2CON_T2Rn_Pos)
+#define TMR_T2CON_T2CM_Pos				(2)
+#define TMR_T2CON_T2CM_Msk				(0x1 << TMR_T2CON_T2CM_Pos)
+#define TMR_T2CON_T2In_Pos				(0)
+#define TMR_T2CON_T2In_Msk				(0x3 << TMR_T2CON_T2In_Pos)
+
+/*------CCEN------------------------------------------------------*/
+#define TMR_CCEN_CMn3_Pos				(6)
+#define TMR_CCEN_CMn3_Msk				(0x3 << TMR_CCEN_CMn3_Pos)
+#define TMR_CCEN_CMn2_Pos				(4)
+#define TMR_CCEN_CMn2_Msk				(0x3 << TMR_CCEN_CMn2_Pos)
+#define TMR_CCEN_CMn1_Pos				(2)
+#define TMR_CCEN_CMn1_Msk				(0x3 << TMR_CCEN_CMn1_Pos)
+#define TMR_CCEN_CMn0_Pos				(0)
+#define TMR_CCEN_CMn0_Msk				(0x3 << TMR_CCEN_CMn0_Pos)
+
+/*------T34MOD----------------------------------------------------*/
+#define TMR_T34MOD_TR4_Pos				(7)
+#define TMR_T34MOD_TR4_Msk				(0x1 << TMR_T34MOD_TR4_Pos)
+#define TMR_T34MOD_T4M_Pos				(6)
+#define TMR_T34MOD_T4M_Msk				(0x1 << TMR_T34MOD_T4M_Pos)
+#define TMR_T34MOD_T4Mn_Pos				(4)
+#define TMR_T34MOD_T4Mn_Msk				(0x3 << TMR_T34MOD_T4Mn_Pos)
+#define TMR_T34MOD_TR3_Pos				(3)
+#define TMR_T34MOD_TR3_Msk				(0x1 << TMR_T34MOD_TR3_Pos)
+#define TMR_T34MOD_T3M_Pos				(2)
+#define TMR_T34MOD_T3M_Msk				(0x1 << TMR_T34MOD_T3M_Pos)
+#define TMR_T34MOD_T3Mn_Pos				(0)
+#define TMR_T34MOD_T3Mn_Msk				(0x3 << TMR_T34MOD_T3Mn_Pos)
+
+/*-----------------------------------------------------------------
+**UART
+------------------------------------------------------------------*/
+/*------SCON0------------------------------------------------------*/
+#define UART_SCON0_U0SMn_Pos			(6)
+#define UART_SCON0_U0SMn_Msk			(0x3 << UART_SCON0_U0SMn_Pos)
+#define UART_SCON0_U0SM2_Pos			(5)
+#define UART_SCON0_U0SM2_Msk			(0x1 << UART_SCON0_U0SM2_Pos)
+#define UART_SCON0_U0REN_Pos			(4)
+#define UART_SCON0_U0REN_Msk			(0x1 << UART_SCON0_U0REN_Pos)
+#define UART_SCON0_U0TB8_Pos			(3)
+#define UART_SCON0_U0TB8_Msk			(0x1 << UART_SCON0_U0TB8_Pos)
+#define UART_SCON0_U0RB8_Pos			(2)
+#define UART_SCON0_U0RB8_Msk			(0x1 << UART_SCON0_U0RB8_Pos)
+#define UART_SCON0_TI0_Pos				(1)
+#define UART_SCON0_TI0_Msk				(0x1 << UART_SCON0_TI0_Pos)
+#define UART_SCON0_RI0_Pos				(0)
+#define UART_SCON0_RI0_Msk				(0x1 << UART_SCON0_RI0_Pos)
+/*------SCON1------------------------------------------------------*/
+#define UART_SCON1_U1SMn_Pos			(6)
+#define UART_SCON1_U1SMn_Msk			(0x3 << UART_SCON1_U1SMn_Pos)
+#define UART_SCON1_U1SM2_Pos			(5)
+#define UART_SCON1_U1SM2_Msk			(0x1 << UART_SCON1_U1SM2_Pos)
+#define UART_SCON1_U1REN_Pos			(4)
+#define UART_SCON1_U1REN_Msk			(0x1 << UART_SCON1_U1REN_Pos)
+#define UART_SCON1_U1TB8_Pos			(3)
+#define UART_SCON1_U1TB8_Msk			(0x1 << UART_SCON1_U1TB8_Pos)
+#define UART_SCON1_U1RB8_Pos			(2)
+#define UART_SCON1_U1RB8_Msk			(0x1 << UART_SCON1_U1RB8_Pos)
+#define UART_SCON1_TI1_Pos				(1)
+#define UART_SCON1_TI1_Msk				(0x1 << UART_SCON1_TI1_Pos)
+#define UART_SCON1_RI1_Pos				(0)
+#define UART_SCON1_RI1_Msk				(0x1 << UART_SCON1_RI1_Pos)
+/*------BRTCON-----------------------------------------------------*/
+#define UART_BRTCON_BRTEN_Pos			(7)
+#define UART_BRTCON_BRTEN_Msk			(0x1 << UART_BRTCON_BRTEN_Pos)
+#define UART_BRTCON_BRTCKDIV_Pos		(0)
+#define UART_BRTCON_BRTCKDIV_Msk		(0x7 << UART_BRTCON_BRTCKDIV_Pos)
+
+
+/*-----------------------------------------------------------------
+**System
+------------------------------------------------------------------*/
+/*------PCON------------------------------------------------------*/
+#define SYS_PCON_SMOD0_Pos			(7)
+#define SYS_PCON_SMOD0_Msk			(0x1 << SYS_PCON_SMOD0_Pos)
+#define SYS_PCON_SMOD1_Pos			(6)
+#define SYS_PCON_SMOD1_Msk			(0x1 << SYS_PCON_SMOD1_Pos)
+#define SYS_PCON_SWE_Pos			(2)
+#define SYS_PCON_SWE_Msk			(0x1 << SYS_PCON_SWE_Pos)
+#define SYS_PCON_STOP_Pos			(1)
+#define SYS_PCON_STOP_Msk			(0x1 << SYS_PCON_STOP_Pos)
+#define SYS_PCON_IDLE_Pos			(0)
+#define SYS_PCON_IDLE_Msk			(0x1 << SYS_PCON_IDLE_Pos)
+
+/*------FUNCCR----------------------------------------------------*/
+#define SYS_FUNCCR_UART1_CKS1_Pos	(3)
+#define SYS_FUNCCR_UART1_CKS1_Msk	(0x1 << SYS_FUNCCR_UART1_CKS1_Pos)
+#define SYS_FUNCCR_UART0_CKS1_Pos	(2)
+#define SYS_FUNCCR_UART0_CKS1_Msk	(0x1 << SYS_FUNCCR_UART0_CKS1_Pos)
+#define SYS_FUNCCR_UART1_CKS0_Pos	(1)
+#define SYS_FUNCCR_UART1_CKS0_Msk	(0x1 << SYS_FUNCCR_UART1_CKS0_Pos)
+#define SYS_FUNCCR_UART0_CKS0_Pos	(0)
+#define SYS_FUNCCR_UART0_CKS0_Msk	(0x1 << SYS_FUNCCR_UART0_CKS0_Pos)
+
+/*------SCKSEL----------------------------------------------------*/
+#define SYS_SCKSEL_SEL_Pos			(4)
+#define SYS_SCKSEL_SEL_Msk			(0x1 << SYS_SCKSEL_SEL_Pos)
+#define SYS_SCKSEL_WRITE_Pos		(3)
+#define SYS_SCKSEL_WRITE_Msk		(0x1 << SYS_SCKSEL_WRITE_Pos)
+#define SYS_SCKSEL_CKSEL_Pos		(0)
+#define SYS_SCKSEL_CKSEL_Msk		(0x7 << SYS_SCKSEL_CKSEL_Pos)
+/*------CKSTAU----------------------------------------------------*/
+#define SYS_CKSTAU_LSI_F_Pos		(7)
+#define SYS_CKSTAU_LSI_F_Msk		(0x1 << SYS_CKSTAU_LSI_F_Pos)
+#define SYS_CKSTAU_LSE_F_Pos		(6)
+#define SYS_CKSTAU_LSE_F_Msk		(0x1 << SYS_CKSTAU_LSE_F_Pos)
+#define SYS_CKSTAU_HSE_F_Pos		(5)
+#define SYS_CKSTAU_HSE_F_Msk		(0x1 << SYS_CKSTAU_HSE_F_Pos)
+#define SYS_CKSTAU_HSI_F_Pos		(4)
+#define SYS_CKSTAU_HSI_F_Msk		(0x1 << SYS_CKSTAU_HSI_F_Pos)
+#define SYS_CKSTAU_LSI_E_Pos		(3)
+#define SYS_CKSTAU_LSI_E_Msk		(0x1 << SYS_CKSTAU_LSI_E_Pos)
+#define SYS_CKSTAU_LSE_E_Pos		(2)
+#define SYS_CKSTAU_LSE_E_Msk		(0x1 << SYS_CKSTAU_LSE_E_Pos)
+#define SYS_CKSTAU_HSE_E_Pos		(1)
+#define SYS_CKSTAU_HSE_E_Msk		(0x1 << SYS_CKSTAU_HSE_E_Pos)
+#define SYS_CKSTAU_HSI_E_Pos		(0)
+#define SYS_CKSTAU_HSI_E_Msk		(0x1 << SYS_CKSTAU_HSI_E_Pos)
+
+
+/*------WKTSET----------------------------------------------------*/
+#define SYS_WKTSET_WUEN_Pos			(7)
+#define SYS_WKTSET_WUEN_Msk			(0x1 << SYS_WKTSET_WUEN_Pos)
+#define SYS_WKTSET_XTCNTEN_Pos		(6)
+#define SYS_WKTSET_XTCNTEN_Msk		(0x1 << SYS_WKTSET_XTCNTEN_Pos)
+#define SYS_WKTSET_XTSEL_Pos		(5)
+#define SYS_WKTSET_XTSEL_Msk		(0x1 << SYS_WKTSET_XTSEL_Pos)
+#define SYS_WKTSET_XTINE_Pos		(1)
+#define SYS_WKTSET_XTINE_Msk		(0x1 << SYS_WKTSET_XTINE_Pos)
+#define SYS_WKTSET_XTINF_Pos		(0)
+#define SYS_WKTSET_XTINF_Msk		(0x1 << SYS_WKTSET_XTINF_Pos)
+
+
+
+/*-----------------------------------------------------------------
+**WDT
+------------------------------------------------------------------*/
+/*------WDCON-----------------------------------------------------*/
+#define WDT_WDCON_SWRST_Pos			(7)
+#define WDT_WDCON_SWRST_Msk			(0x1 << WDT_WDCON_SWRST_Pos)
+#define WDT_WDCON_PORF_Pos			(6)
+#define WDT_WDCON_PORF_Msk			(0x1 << WDT_WDCON_PORF_Pos)
+#define WDT_WDCON_WDTIF_Pos			(3)
+#define WDT_WDCON_WDTIF_Msk			(0x1 << WDT_WDCON_WDTIF_Pos)
+#define WDT_WDCON_WDTRF_Pos			(2)
+#define WDT_WDCON_WDTRF_Msk			(0x1 << WDT_WDCON_WDTRF_Pos)
+#define WDT_WDCON_WDTRE_Pos			(1)
+#define WDT_WDCON_WDTRE_Msk			(0x1 << WDT_WDCON_WDTRE_Pos)
+#define WDT_WDCON_WDTCLR_Pos		(0)
+#define WDT_WDCON_WDTCLR_Msk		(0x1 << WDT_WDCON_WDTCLR_Pos)
+/*-----------------------------------------------------------------
+**I2C
+------------------------------------------------------------------*/
+/*------I2CMCR----------------------------------------------------*/
+#define I2C_I2CMCR_RSTS_Pos			(7)
+#define I2C_I2CMCR_RSTS_Msk			(0x1 << I2C_I2CMCR_RSTS_Pos)
+#define I2C_I2CMCR_ACK_Pos			(3)
+#define I2C_I2CMCR_ACK_Msk			(0x1 << I2C_I2CMCR_ACK_Pos)
+#define I2C_I2CMCR_STOP_Pos			(2)
+#define I2C_I2CMCR_STOP_Msk			(0x1 << I2C_I2CMCR_STOP_Pos)
+#define I2C_I2CMCR_START_Pos		(1)
+#define I2C_I2CMCR_START_Msk		(0x1 << I2C_I2CMCR_START_Pos)
+#define I2C_I2CMCR_RUN_Pos			(0)
+#define I2C_I2CMCR_RUN_Msk			(0x1 << I2C_I2CMCR_RUN_Pos)
+/*------I2CMSR----------------------------------------------------*/
+#define I2C_I2CMSR_I2CMIF_Pos		(7)
+#define I2C_I2CMSR_I2CMIF_Msk		(0x1 << I2C_I2CMSR_I2CMIF_Pos)
+#define I2C_I2CMSR_BUS_BUSY_Pos		(6)
+#define I2C_I2CMSR_BUS_BUSY_Msk		(0x1 << I2C_I2CMSR_BUS_BUSY_Pos)
+#define I2C_I2CMSR_IDLE_Pos			(5)
+#define I2C_I2CMSR_IDLE_Msk			(0x1 << I2C_I2CMSR_IDLE_Pos)
+#define I2C_I2CMSR_ARB_LOST_Pos		(4)
+#define I2C_I2CMSR_ARB_LOST_Msk		(0x1 << I2C_I2CMSR_ARB_LOST_Pos)
+#define I2C_I2CMSR_DATA_ACK_Pos		(3)
+#define I2C_I2CMSR_DATA_ACK_Msk		(0x1 << I2C_I2CMSR_DATA_ACK_Pos)
+#define I2C_I2CMSR_ADD_ACK_Pos		(2)
+#define I2C_I2CMSR_ADD_ACK_Msk		(0x1 << I2C_I2CMSR_ADD_ACK_Pos)
+#define I2C_I2CMSR_ERROR_Pos		(1)
+#define I2C_I2CMSR_ERROR_Msk		(0x1 << I2C_I2CMSR_ERROR_Pos)
+#define I2C_I2CMSR_BUSY_Pos			(0)
+#define I2C_I2CMSR_BUSY_Msk		(0x1 << I2C_I2CMSR_BUSY_Pos)
+/*------I2CMSA----------------------------------------------------*/
+#define I2C_I2CMSA_SAn_Pos			(1)
+#define I2C_I2CMSA_SAn_Msk			(0x7F << I2C_I2CMSA_SAn_Pos)
+#define I2C_I2CMSA_RS_Pos			(0)
+#define I2C_I2CMSA_RS_Msk			(0x1 << I2C_I2CMSA_RS_Pos)
+/*------I2CSCR----------------------------------------------------*/
+#define I2C_I2CSCR_RSTS_Pos			(7)
+#define I2C_I2CSCR_RSTS_Msk			(0x1 << I2C_I2CSCR_RSTS_Pos)
+#define I2C_I2CSCR_DA_Pos			(0)
+#define I2C_I2CSCR_DA_Msk			(0x1 << I2C_I2CSCR_DA_Pos)
+/*------I2CSSR----------------------------------------------------*/
+#define I2C_I2CSSR_SENDFIN_Pos		(2)
+#define I2C_I2CSSR_SENDFIN_Msk		(0x1 << I2C_I2CSCR_RSTS_Pos)
+#define I2C_I2CSSR_TREQ_Pos			(1)
+#define I2C_I2CSSR_TREQ_Msk			(0x1 << I2C_I2CSSR_TREQ_Pos)
+#define I2C_I2CSSR_RREQ_Pos			(0)
+#define I2C_I2CSSR_RREQ_Msk			(0x1 << I2C_I2CSSR_RREQ_Pos)
+/*-----------------------------------------------------------------
+**BUZZER
+------------------------------------------------------------------*/
+/*------BUZCON----------------------------------------------------*/
+#define BUZZER_BUZCON_BUZEN_Pos		(7)
+#define BUZZER_BUZCON_BUZEN_Msk		(0x1 << BUZZER_BUZCON_BUZEN_Pos)
+#define BUZZER_BUZCON_BUZCKS_Pos	(0)
+#define BUZZER_BUZCON_BUZCKS_Msk	(0x3 << BUZZER_BUZCON_BUZCKS_Pos)
+/*-----------------------------------------------------------------
+**FLASH
+------------------------------------------------------------------*/
+/*------FLASH----------------------------------------------------*/
+#define FLASH_MCTRL_MERR_Pos		(5)
+#define FLASH_MCTRL_MERR_Msk		(0x1 << FLASH_MCTRL_MERR_Pos)
+#define FLASH_MCTRL_MREG_Pos		(4)
+#define FLASH_MCTRL_MREG_Msk		(0x1 << FLASH_MCTRL_MREG_Pos)
+#define FLASH_MCTRL_MMODE_Pos		(2)
+#define FLASH_MCTRL_MMODE_Msk		(0x3 << FLASH_MCTRL_MMODE_Pos)
+#define FLASH_MCTRL_MSTART_Pos		(0)
+#define FLASH_MCTRL_MSTART_Msk		(0x1 << FLASH_MCTRL_MSTART_Pos)
+/*-----------------------------------------------------------------
+**SPI
+------------------------------------------------------------------*/
+/*------SPCR------------------------------------------------------*/
+#define SPI_SPCR_SPEN_Pos			(6)
+#define SPI_SPCR_SPEN_Msk			(0x1 << SPI_SPCR_SPEN_Pos)
+#define SPI_SPCR_SPR2_Pos			(5)
+#define SPI_SPCR_SPR2_Msk			(0x1 << SPI_SPCR_SPR2_Pos)
+#define SPI_SPCR_MSTR_Pos			(4)
+#define SPI_SPCR_MSTR_Msk			(0x1 << SPI_SPCR_MSTR_Pos)
+#define SPI_SPCR_CPOL_Pos			(3)
+#define SPI_SPCR_CPOL_Msk			(0x1 << SPI_SPCR_CPOL_Pos)
+#define SPI_SPCR_CPHA_Pos			(2)
+#define SPI_SPCR_CPHA_Msk			(0x1 << SPI_SPCR_CPHA_Pos)
+#define SPI_SPCR_SPRn_Pos			(0)
+#define SPI_SPCR_SPRn_Msk			(0x3 << SPI_SPCR_SPRn_Pos)
+
+/*------SPSR------------------------------------------------------*/
+#define SPI_SPSR_SPISIF_Pos			(7)
+#define SPI_SPSR_SPISIF_Msk			(0x1 << SPI_SPSR_SPISIF_Pos)
+#define SPI_SPSR_WCOL_Pos			(6)
+#define SPI_SPSR_WCOL_Msk			(0x1 << SPI_SPSR_WCOL_Pos)
+#define SPI_SPSR_SSCEN_Pos			(0)
+#define SPI_SPSR_SSCEN_Msk			(0x1 << SPI_SPSR_SSCEN_Pos)
+
+/*-----------------------------------------------------------------
+**LSE
+------------------------------------------------------------------*/
+/*------LSE------------------------------------------------------*/
+#define LSE_LSECON_LSEEN_Pos		(7)
+#define LSE_LSECON_LSEEN_Msk		(0x1 << LSE_LSECON_LSEEN_Pos)
+#define LSE_LSECON_LSEWUEN_Pos		(6)
+#define LSE_LSECON_LSEWUEN_Msk		(0x1 << LSE_LSECON_LSEWUEN_Pos)
+#define LSE_LSECON_LSECNTEN_Pos		(5)
+#define LSE_LSECON_LSECNTEN_Msk		(0x1 << LSE_LSECON_LSECNTEN_Pos)
+#define LSE_LSECON_LSESTA_Pos		(4)
+#define LSE_LSECON_LSESTA_Msk		(0x1 << LSE_LSECON_LSESTA_Pos)
+#define LSE_LSECON_LSEIE_Pos		(3)
+#define LSE_LSECON_LSEIE_Msk		(0x1 << LSE_LSECON_LSEIE_Pos)
+#define LSE_LSECON_LSEIF_Pos		(0)
+#define LSE_LSECON_LSEIF_Msk		(0x1 << LSE_LSECON_LSEIF_Pos)
+
+/*-----------------------------------------------------------------
+**LVD
+------------------------------------------------------------------*/
+/*------LVDCON----------------------------------------------------*/
+#define LVD_LVDCON_LVDSEL_Pos		(4)
+#define LVD_LVDCON_LVDSEL_Msk		(0x7 << LVD_LVDCON_LVDSEL_Pos)
+#define LVD_LVDCON_LVDEN_Pos		(3)
+#define LVD_LVDCON_LVDEN_Msk		(0x1 << LVD_LVDCON_LVDEN_Pos)
+#define LVD_LVDCON_LVDINTE_Pos		(1)
+#define LVD_LVDCON_LVDINTE_Msk		(0x1 << LVD_LVDCON_LVDINTE_Pos)
+#define LVD_LVDCON_LVDINTF_Pos		(0)
+#define LVD_LVDCON_LVDINTF_Msk		(0x1 << LVD_LVDCON_LVDINTF_Pos)
+
+
+
+/*-----------------------------------------------------------------
+**жȼģ Priority Module Number
+------------------------------------------------------------------*/
+typedef enum  en_Priority_Module{
+	IRQ_EXINT0	=0,
+	IRQ_TMR0	=1,
+	IRQ_EXINT1	=2,
+	IRQ_TMR1	=3,
+	IRQ_UART0	=4,
+	IRQ_TMR2	=5,
+	IRQ_UART1	=6,	
+	IRQ_P0		=8,
+	IRQ_P1		=9,
+	IRQ_P2		=10,
+	IRQ_P3		=11,	
+	IRQ_LVD	    =13,		
+	IRQ_LSE		=14,	
+	IRQ_ACMP	=15,
+	IRQ_TMR3	=16,
+	IRQ_TMR4	=17,
+	IRQ_PWM		=19,
+	IRQ_ADC 	=20,
+	IRQ_WDT  	=21,
+	IRQ_I2C  	=22,
+	IRQ_SPI  	=23,
+}en_Priority_Module_t;
+
+/*-----------------------------------------------------------------
+**ֹͣģʽ
+------------------------------------------------------------------*/
+#define STOP() PCON|=0x04;PCON|=0x02;
+
+/*-----------------------------------------------------------------
+**жȼ IRQPriority
+------------------------------------------------------------------*/
+#define  IRQ_PRIORITY_LOW		(0x00)
+#define  IRQ_PRIORITY_HIGH		(0x01)	
+
+/********************************************************************************
+ ** \brief	 IRQ_SET_PRIORITY
+ **			 жȼ
+ ** \param [in] none
+ ** \return  none
+ ******************************************************************************/
+#define  IRQ_SET_PRIORITY(IRQ_Module, IRQPriority)  do{\
+														if(IRQ_Module <8)\
+														{\
+															IP &= ~(1<< IRQ_Module);\
+															IP |=(IRQPriority<< IRQ_Module);\
+														}\
+														else if(IRQ_Module <16)\
+														{\
+															EIP1 &= ~(1<< (IRQ_Module-8));\
+															EIP1 |= (IRQPriority<< (IRQ_Module-8));\
+														}\
+														else if(IRQ_Module <24)\
+														{\
+															EIP2 &= ~(1<< (IRQ_Module-16));\
+															EIP2 |=(IRQPriority<< (IRQ_Module-16));\
+														}\
+													}while(0)
+
+/********************************************************************************
+ ** \brief	 IRQ_ALL_ENABLE
+ **			 ʹж
+ ** \param [in] none
+ ** \return  none
+ ******************************************************************************/
+#define  IRQ_ALL_ENABLE()		do{\
+									IE |= (IRQ_IE_EA_Msk);\
+								  }while(0)
+/********************************************************************************
+ ** \brief	 IRQ_ALL_DISABLE
+ **			 رж
+ ** \param [in] none
+ ** \return  none
+ ******************************************************************************/
+#define  IRQ_ALL_DISABLE()		do{\
+									IE &= (~IRQ_IE_EA_Msk);\
+								  }while(0)
+
+/*---------ж---------------------------------------------------------
+ **   interrupt vector all 23
+------------------------------------------------------------------------------*/
+#define INT0_VECTOR /*0*/
+#define TMR0_VECTOR /*1*/
+#define INT1_VECTOR /*2*/
+#define TMR1_VECTOR /*3*/
+#define UART0_VECTOR /*4*/
+#define TMR2_VECTOR /*5*/
+#define UART1_VECTOR /*6*/
+#define P0EI_VECTOR /*7*/
+#define P1EI_VECTOR /*8*/
+#define P2EI_VECTOR /*9*/
+#define P3EI_VECTOR /*10*/
+#define LVD_VECTOR /*12*/
+#define LSE_VECTOR /*13*/
+#define ACMP_VECTOR /*14*/
+#define TMR3_VECTOR /*15*/
+#define TMR4_VECTOR /*16*/
+
+#define EPWM_VECTOR /*18*/
+#define ADC_VECTOR /*19*/
+#define WDT_VECTOR /*20*/
+#define I2C_VECTOR /*21*/
+#define SPI_VECTOR /*22*/
+		
+#define clrwdt()					TA=0xAA, TA=0x55, WDCON=0x01;				
+/*****************************************************************************/
+/* Global variable declarations ('extern', definition in C source) */
+/*****************************************************************************/
+extern  uint32_t  SystemClock;
+/*****************************************************************************/
+/* Global function prototypes for System ('extern', definition in C source) */
+/*****************************************************************************/
+#include "system.h"
+
+/*****************************************************************************/
+/* Global function prototypes	for Periphal('extern', definition in C source) */
+/*****************************************************************************/
+#ifdef EnableStdACMP
+	#include "acmp.h"
+#endif
+
+#ifdef EnableStdADC
+	#include "adc.h"
+#endif
+
+#ifdef EnableStdBuzzer
+	#include "buzzer.h"
+#endif
+
+#ifdef EnableStdEPWM
+	#include "epwm.h"
+#endif
+
+#ifdef EnableStdEXTI
+	#include "extint.h"
+#endif
+
+#ifdef EnableStdFMC
+	#include "flash.h"
+#endif
+
+#ifdef EnableStdGPIO
+	#include "gpio.h"
+#endif
+
+#ifdef EnableStdI2C
+	#include "i2c.h"
+#endif
+
+#ifdef EnableStdLSE
+	#include "lse.h"
+#endif
+
+#ifdef EnableStdOPA
+	#include "opa.h"
+#endif 
+
+#ifdef EnableStdPGA
+	#include "pga.h"
+#endif 
+
+#ifdef EnableStdSPI
+	#include "spi.h"
+#endif 
+
+#ifdef EnableStdTIM
+	#include "tim.h"
+#endif 
+
+#ifdef EnableStdUART
+	#include "uart.h"
+#endif 
+
+#ifdef EnableStdWDT
+	#include "wdt.h"
+#endif 
+
+#endif /* _CMS8S6990_H_ */
+
+
+//˿ΪĴ(ֻHostSFR.cHostGPIO.cʹ)
+#if defined(HostSFRPortAsRAM)&&!defined(HostSFRPortAsRAMDone)
+#define HostSFRPortAsRAMDone
+#undef P0
+#define P0 (HostSFR_Access(0x80)->Byte)
+#undef P1
+#define P1 (HostSFR_Access(0x90)->Byte)
+#undef P2
+#define P2 (HostSFR_Access(0xA0)->Byte)
+#undef P3
+#define P3 (HostSFR_Access(0xB0)->Byte)
+#endif
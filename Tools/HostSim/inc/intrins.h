@@ -0,0 +1,15 @@
+/****************************************************************************/
+/** \file intrins.h
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļKeil C51ڲͷļPC汾ֻṩ̼ʵʹõڲ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+#ifndef _INTRINS_H_
+#define _INTRINS_H_
+
+#define _nop_() ((void)0) //ָPCϲҪȴ
+
+#endif
@@ -0,0 +1,383 @@
+/****************************************************************************/
+/** \file NTCLUTGen.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļPCϵNTCұNTCBֵ25ֵ
+ADC׼ɹ̼ʹõNTC.cļϺģ̼Ĳ㷨
+¶ȷΧɨ裬ͲұռõROMռ䡣
+
+뷽gcc -O2 -o NTCLUTGen NTCLUTGen.c -lm
+ʹ÷NTCLUTGen [ѡ] > ../../FirmwareCode/Hardware/NTC.c
+	-b <Bֵ>             NTCBֵĬ4250
+	-r25 <ֵK>        NTC25µֵĬ100
+	-rup <ֵK>        NTCֵADCCfg.hڵNTCUpperResValueKһ£Ĭ470
+	-vref <mV>           ADCתNTCʱĻ׼ѹĬ0ʾʹVDDΪ׼()
+	-vpu <mV>            NTCĹѹʹVDDΪ׼ʱָ
+	-tmin <> -tmax <> ұ¶ȷΧĬ-1975
+	-step <>            ұ¶ȼĬ1
+	-domain <adc|res>    ұͣadc=12bit ADCֵ(Ĭ)res=NTCֵ()
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+#define ADCFullScale 4096 //ADC(12bit)
+#define MaxTableSize 255 //̼ʹunsigned charΪұ255
+#define KelvinOffset 273.15 //϶ȵĵƫ
+#define ScanStep 0.1 //ɨ¶Ȳ()
+
+/****************************************************************************/
+/*	Local type definitions('typedef')
+****************************************************************************/
+typedef struct
+	{
+	double B; //NTCBֵ
+	double R25; //NTC25µֵ()
+	double RUp; //ֵ()
+	double VRef; //ADC׼ѹ(mV)0ʾʹVDDΪ׼
+	double VPullUp; //蹩ѹ(mV)
+	int TMin; //ұ¶()
+	int TMax; //ұ¶()
+	int Step; //ұ¶Ȳ()
+	int IsResDomain; //ұǷΪֵ
+	}GenCfgDef;
+
+/****************************************************************************/
+/*	Local variable  definitions('static')
+****************************************************************************/
+static long Table[MaxTableSize]; //ɵĲұ
+static int TableSize; //ұ
+
+/****************************************************************************/
+/*	Function implementation - local('static')
+****************************************************************************/
+
+//ʹBֵʽָ¶µNTCֵ()
+static double NTCRes(const GenCfgDef *Cfg,double Temp)
+	{
+	return Cfg->R25*exp(Cfg->B*((1.0/(Temp+KelvinOffset))-(1.0/(25.0+KelvinOffset))));
+	}
+
+//ֵָµADCֵ(ȡ)
+static double NTCADCCode(const GenCfgDef *Cfg,double Res)
+	{
+	double Ratio=Res/(Res+Cfg->RUp);
+	//ʹö׼ʱҪͻ׼ı
+	if(Cfg->VRef>0)Ratio*=Cfg->VPullUp/Cfg->VRef;
+	return (double)ADCFullScale*Ratio;
+	}
+
+//չ̼ķʽADCֵΪֵ(ֵ͵ĲұҪ)
+static long FWCodeToRes(const GenCfgDef *Cfg,long Code)
+	{
+	long RUp=(long)(Cfg->RUp+0.5);
+	if(Code>=ADCFullScale)return 0x7FFFFFFFL;
+	return (long)(((unsigned long)RUp*(unsigned long)Code)/(unsigned long)(ADCFullScale-Code));
+	}
+
+//ģ̼Ĳ㷨0.1Ϊλ¶ȣұΧʱ0x7FFF
+static int FWLookup(const GenCfgDef *Cfg,long Code)
+	{
+	long Key,Span;
+	int Low,High,Mid;
+	//ֵ͵ĲұҪȻֲֵұ¶ߵݼ
+	Key=Cfg->IsResDomain?FWCodeToRes(Cfg,Code):Code;
+	if(Key>Table[0]||Key<Table[TableSize-1])return 0x7FFF;
+	Low=0;
+	High=TableSize-1;
+	while((High-Low)>1)
+		{
+		Mid=(Low+High)>>1;
+		if(Table[Mid]>=Key)Low=Mid;
+		else High=Mid;
+		}
+	Span=Table[Low]-Table[High];
+	Span=(((Table[Low]-Key)*10*Cfg->Step)+(Span>>1))/Span;
+	return ((Cfg->TMin+(Low*Cfg->Step))*10)+(int)Span;
+	}
+
+//ֵKʾ
+static void PrintKOhm(double Res)
+	{
+	printf("%.2fK",Res/1000.0);
+	}
+
+//ļͷ
+static void EmitHeader(const GenCfgDef *Cfg,int ROMSize,double MaxErr)
+	{
+	printf("/****************************************************************************/\n");
+	printf("/** \\file NTC.c\n");
+	printf("/** \\Author [NTC resistor LUT generator BOT] @ redstoner_35\n");
+	printf("/** \\Project Xtern Ripper Laser Edition \n");
+	if(Cfg->IsResDomain)
+		{
+		printf("/** \\Description ļʵָNTCصֵ¶ȵĹܣļ\n");
+		printf("Զɣδ޸ģ\n\n");
+		}
+	else
+		{
+		printf("/** \\Description ļʵָNTCѹADCת¶ȵĹܣļ\n");
+		printf("ɻԶɣδ޸ģ\n\n");
+		}
+	printf("/** \\AdditionINFO  \n");
+	printf("\t\tThis is an automatically generated file by NTC resistor LUT \n");
+	printf("\t\tgenerator. DO NOT EDIT UNLESS YOU FULLY UNDERSTAND WHAT THIS\n");
+	printf("\t\tFILE ACTUALLY DOES!\n");
+	printf("\t\tNTC PARAMETER:");
+	PrintKOhm(Cfg->R25);
+	printf(" @ 25 B%d\n",(int)(Cfg->B+0.5));
+	printf("\t\tPull-up resistor:");
+	PrintKOhm(Cfg->RUp);
+	printf("\n");
+	if(Cfg->VRef>0)printf("\t\tADC reference:%dmV,Pull-up supply:%dmV\n",(int)(Cfg->VRef+0.5),(int)(Cfg->VPullUp+0.5));
+	printf("\t\tTable domain:%s\n",Cfg->IsResDomain?"NTC resistance()":"12bit ADC code");
+	printf("\t\tTable temperature range:%d to %d,%d step\n",Cfg->TMin,Cfg->TMin+((TableSize-1)*Cfg->Step),Cfg->Step);
+	printf("\t\tMax lookup error:%.2f\n",MaxErr);
+	printf("\t\tTotal ROM space for table:%d Bytes\n",ROMSize);
+	printf("\t\tTarget MCU Architecture:8051 Based MCU\n\n");
+	printf("**\tHistory: Initial Release\n");
+	printf("**\t\n");
+	printf("*****************************************************************************/\n");
+	printf("/****************************************************************************/\n");
+	printf("/*\tinclude files\n");
+	printf("*****************************************************************************/\n");
+	printf("#include <stdbool.h>\n");
+	printf("#include \"ADCCfg.h\"\n\n");
+	}
+
+//궨
+static void EmitDefines(const GenCfgDef *Cfg)
+	{
+	printf("/****************************************************************************/\n");
+	printf("/*\tLocal pre-processor symbols/macros('#define')\n");
+	printf("****************************************************************************/\n");
+	printf("#define TemperatureReportOffset 0\t//¶ȷƫֵ㷢¶Ȳ׼¶ȼϵͳTRIM\n");
+	printf("//#define NoTempReport  //ֹϵͳ¶ȼ\n\n");
+	printf("//ұ(Զ)\n");
+	printf("#define NTCTableSize %d //ұ\n",TableSize);
+	printf("#define NTCTableMinTemp %d //ұһӦ¶()\n",Cfg->TMin);
+	printf("#define NTCTableMaxTemp %d //ұһӦ¶()\n",Cfg->TMin+((TableSize-1)*Cfg->Step));
+	printf("#define NTCTableStep %d //ұ¶ȼ()\n",Cfg->Step);
+	printf("#define NTCTablePullUpK %d //ɲұʱʹõֵ(K)\n\n",(int)((Cfg->RUp/1000.0)+0.5));
+	printf("//ұǰָɵģ\n");
+	printf("#if (NTCTablePullUpK != NTCUpperResValueK)\n");
+	printf("\t#error \"Error 003:NTC lookup table was generated for a different pull-up resistor,please regenerate it!\"\n");
+	printf("#endif\n\n");
+	}
+
+//ұ
+static void EmitTable(const GenCfgDef *Cfg)
+	{
+	int i,j,T0,T1,Len;
+	char Line[128];
+	printf("/****************************************************************************/\n");
+	printf("/*\tLocal constant definitions('static const')\n");
+	printf("****************************************************************************/\n");
+	if(Cfg->IsResDomain)
+		{
+		printf("//NTCÿ¶ȵµֵ()¶ߵݼ\n");
+		printf("static code unsigned long NTCTable[NTCTableSize]={\n");
+		}
+	else
+		{
+		printf("//NTCѹADCת(AD=4096*Rt/(Rt+Rup))¶ߵݼ\n");
+		printf("static code unsigned int NTCTable[NTCTableSize]={\n");
+		}
+	//ÿ4渽жӦ¶ȷΧ
+	for(i=0;i<TableSize;i+=4)
+		{
+		Len=0;
+		for(j=i;j<i+4&&j<TableSize;j++)
+			{
+			Len+=sprintf(&Line[Len],"%ld",Table[j]);
+			if(j<TableSize-1)Len+=sprintf(&Line[Len],j<i+3?", ":",");
+			}
+		T0=Cfg->TMin+(i*Cfg->Step);
+		T1=Cfg->TMin+((j-1)*Cfg->Step);
+		if(T0!=T1)printf("%-30s//%d  %d ϶\n",Line,T0,T1);
+		else printf("%-30s//%d϶\n",Line,T0);
+		}
+	printf("};\n\n");
+	}
+
+//
+static void EmitFunction(const GenCfgDef *Cfg)
+	{
+	const char *KeyName=Cfg->IsResDomain?"NTCRes":"ADCCode";
+	printf("/****************************************************************************/\n");
+	printf("/*\tFunction implementation - global ('extern') and local('static')\n");
+	printf("****************************************************************************/\n");
+	printf("#ifdef NoTempReport\n");
+	printf("//debugģʽmask¶ȿʹϵͳԶ\n");
+	printf("int CalcNTCTemp(bool *IsNTCOK,unsigned int ADCCode)\n");
+	printf("\t{\n");
+	printf("\t*IsNTCOK=true;\n");
+	printf("  return 250;\t\n");
+	printf("\t}\n");
+	printf("#else\n");
+	printf("//NTC¶Ȼ㺯\n");
+	printf("//NTCѹADCת(ʹVDDΪ׼),¶ǷЧboolָ\n");
+	printf("//ز¶ֵ(1LSB=0.1)\n");
+	printf("int CalcNTCTemp(bool *IsNTCOK,unsigned int ADCCode){\n");
+	printf("unsigned char Low,High,Mid;\n");
+	if(Cfg->IsResDomain)
+		{
+		printf("unsigned long NTCRes,Span;\n");
+		printf("//ݷѹNTCֵ:Rt=Rup*AD/(4096-AD)\n");
+		printf("if(ADCCode>=4096)ADCCode=4095;\n");
+		printf("NTCRes=((unsigned long)NTCUpperResValueK*1000UL)*(unsigned long)ADCCode;\n");
+		printf("NTCRes/=(unsigned long)(4096-ADCCode);\n");
+		printf("//ֵڲұޣNTC·¶ȹͣ¶쳣\n");
+		}
+	else
+		{
+		printf("unsigned int Span;\n");
+		printf("//ADֵڲұޣNTC·¶ȹͣ¶쳣\n");
+		}
+	printf("if(%s>NTCTable[0])\n",KeyName);
+	printf("  {\n");
+	printf("  *IsNTCOK=false;\n");
+	printf("  return (NTCTableMinTemp+TemperatureReportOffset)*10;\n");
+	printf("  }\n");
+	printf(Cfg->IsResDomain?"//ֵСڲұޣNTC·¶ȹߣ¶쳣\n":"//ADֵСڲұޣNTC·¶ȹߣ¶쳣\n");
+	printf("if(%s<NTCTable[NTCTableSize-1])\n",KeyName);
+	printf("  {\n");
+	printf("  *IsNTCOK=false;\n");
+	printf("  return (NTCTableMaxTemp+TemperatureReportOffset)*10;\n");
+	printf("  }\n");
+	printf("//¶ʹöַ%sڵ䣬ʹNTCTable[Low]>=%s>=NTCTable[High]\n",Cfg->IsResDomain?"ֵ":"ADֵ",KeyName);
+	printf("*IsNTCOK=true;\n");
+	printf("Low=0;\n");
+	printf("High=NTCTableSize-1;\n");
+	printf("while((High-Low)>1)\n");
+	printf("  {\n");
+	printf("  Mid=(Low+High)>>1;\n");
+	printf("  if(NTCTable[Mid]>=%s)Low=Mid;\n",KeyName);
+	printf("  else High=Mid;\n");
+	printf("  }\n");
+	printf("//ڽԲֵõ0.1ֱʵĽ()\n");
+	printf("Span=NTCTable[Low]-NTCTable[High];\n");
+	printf("Span=(((NTCTable[Low]-%s)*(10*NTCTableStep))+(Span>>1))/Span;\n",KeyName);
+	printf("return ((NTCTableMinTemp+TemperatureReportOffset+((int)Low*NTCTableStep))*10)+(int)Span;\n");
+	printf("}\n");
+	printf("#endif\n");
+	}
+
+//в
+static int ParseArgs(GenCfgDef *Cfg,int argc,char *argv[])
+	{
+	int i;
+	for(i=1;i<argc;i++)
+		{
+		if(i+1>=argc)return 0; //вҪֵ
+		if(!strcmp(argv[i],"-b"))Cfg->B=atof(argv[++i]);
+		else if(!strcmp(argv[i],"-r25"))Cfg->R25=atof(argv[++i])*1000.0;
+		else if(!strcmp(argv[i],"-rup"))Cfg->RUp=atof(argv[++i])*1000.0;
+		else if(!strcmp(argv[i],"-vref"))Cfg->VRef=atof(argv[++i]);
+		else if(!strcmp(argv[i],"-vpu"))Cfg->VPullUp=atof(argv[++i]);
+		else if(!strcmp(argv[i],"-tmin"))Cfg->TMin=atoi(argv[++i]);
+		else if(!strcmp(argv[i],"-tmax"))Cfg->TMax=atoi(argv[++i]);
+		else if(!strcmp(argv[i],"-step"))Cfg->Step=atoi(argv[++i]);
+		else if(!strcmp(argv[i],"-domain"))
+			{
+			i++;
+			if(!strcmp(argv[i],"res"))Cfg->IsResDomain=1;
+			else if(!strcmp(argv[i],"adc"))Cfg->IsResDomain=0;
+			else return 0;
+			}
+		else return 0;
+		}
+	//ǷϷ
+	if(Cfg->B<=0||Cfg->R25<=0||Cfg->RUp<=0||Cfg->Step<=0)return 0;
+	if(Cfg->TMax<=Cfg->TMin)return 0;
+	if(Cfg->VRef>0&&Cfg->VPullUp<=0)return 0;
+	return 1;
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+int main(int argc,char *argv[])
+	{
+	GenCfgDef Cfg;
+	int i,Result,ROMSize;
+	long Code,LastCode;
+	double Temp,Err,MaxErr,ErrTemp;
+	//Ĭϲ(100K@25 B4250 NTC470KʹVDDΪ׼)
+	Cfg.B=4250;
+	Cfg.R25=100000;
+	Cfg.RUp=470000;
+	Cfg.VRef=0;
+	Cfg.VPullUp=0;
+	Cfg.TMin=-19;
+	Cfg.TMax=75;
+	Cfg.Step=1;
+	Cfg.IsResDomain=0;
+	if(!ParseArgs(&Cfg,argc,argv))
+		{
+		fprintf(stderr,"Usage:%s [-b B] [-r25 KOhm] [-rup KOhm] [-vref mV -vpu mV] [-tmin C] [-tmax C] [-step C] [-domain adc|res]\n",argv[0]);
+		return 1;
+		}
+	//ɲұ
+	TableSize=((Cfg.TMax-Cfg.TMin)/Cfg.Step)+1;
+	if(TableSize>MaxTableSize)
+		{
+		fprintf(stderr,"Error:table has %d entries,the firmware supports at most %d!\n",TableSize,MaxTableSize);
+		return 1;
+		}
+	for(i=0;i<TableSize;i++)
+		{
+		Temp=Cfg.TMin+(i*Cfg.Step);
+		if(Cfg.IsResDomain)Table[i]=(long)floor(NTCRes(&Cfg,Temp)+0.5);
+		else Table[i]=(long)floor(NTCADCCode(&Cfg,NTCRes(&Cfg,Temp))+0.5);
+		//ұϸ񵥵ݼֵʱֳ0
+		if(i&&Table[i]>=Table[i-1])
+			{
+			fprintf(stderr,"Error:table is not strictly decreasing at %.0fC,ADC resolution is too low for this step!\n",Temp);
+			return 1;
+			}
+		}
+	if(!Cfg.IsResDomain&&(Table[0]>=ADCFullScale||Table[TableSize-1]<=0))
+		{
+		fprintf(stderr,"Error:table exceeds the ADC range!\n");
+		return 1;
+		}
+	ROMSize=TableSize*(Cfg.IsResDomain?4:2);
+	//ɨ¶ȷΧʹADCֵģ̼ͳ(ADC)
+	MaxErr=0;
+	ErrTemp=Cfg.TMin;
+	LastCode=-1;
+	for(Temp=Cfg.TMin;Temp<=(Cfg.TMin+((TableSize-1)*Cfg.Step))+1E-6;Temp+=ScanStep)
+		{
+		Code=(long)floor(NTCADCCode(&Cfg,NTCRes(&Cfg,Temp))+0.5);
+		if(Code==LastCode)continue;
+		LastCode=Code;
+		Result=FWLookup(&Cfg,Code);
+		if(Result==0x7FFF)continue;
+		Err=fabs((Result/10.0)-Temp);
+		if(Err>MaxErr)
+			{
+			MaxErr=Err;
+			ErrTemp=Temp;
+			}
+		}
+	//ļ
+	EmitHeader(&Cfg,ROMSize,MaxErr);
+	EmitDefines(&Cfg);
+	EmitTable(&Cfg);
+	EmitFunction(&Cfg);
+	//
+	fprintf(stderr,"NTC LUT:%d entries,%d bytes of ROM,%s domain\n",TableSize,ROMSize,Cfg.IsResDomain?"resistance":"ADC code");
+	fprintf(stderr,"Max lookup error:%.2fC at %.1fC\n",MaxErr,ErrTemp);
+	return 0;
+	}
@@ -0,0 +1,12 @@
+/****************************************************************************/
+/** \file ModeControl.h
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ̼ԴļModeControl.hõλͷļʵļΪModecontrol.h
+KeilڲִСдWindowsû⡣¿ز̨Linuxϱʱʹļ
+תʵʵͷļ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+#include "../../FirmwareCode/include/Logic/Modecontrol.h"
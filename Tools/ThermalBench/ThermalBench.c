@@ -0,0 +1,409 @@
+/****************************************************************************/
+/** \file ThermalBench.c
+/** \Author redstoner_35
+/** \Project Xtern Ripper Laser Edition
+/** \Description ļPCϵ¿رջ̨ѹ̼ʵʵTempControl.c
+(ThermalPILoopCalcThermalILIMCalcRecalcPILoopThermalMgmtProcess)ӵһ
+һģУͳÿĺ½ʱ䡢˳ʱ䡢λ
+ʱ䡢ƽ͵񵴷ȣÿε¿ز֮󶼿عԱȣֻܵⳡʵ⡣
+
+뷽
+	gcc -O2 -DLD_NUGM06T "-Dbit=unsigned char" -Dxdata= -Dcode=const -I.
+	    -I../../FirmwareCode/include/Hardware -I../../FirmwareCode/include/System
+	    -I../../FirmwareCode/include/Middleware -I../../FirmwareCode/include/Logic
+	    -o ThermalBench ThermalBench.c ../../FirmwareCode/Logic/TempControl.c
+	LD_xxxѡ͹̼ĿһµLDļ-DEnableModelThermalCtrlɲ
+	ģ͵¿أPIԱȡ
+ʹ÷ThermalBench [ѡ]
+	-csv                 ʹöŷָʽһεĽdiff
+	-run <n>             ֻеn
+	-trace               -runһʹãÿһиó¶Ⱥ͵
+	-check <golden.csv>  ȫͻ׼Աȣݲĳᱻǳ
+ⳡȹػʱֵΪ2-checkֽݲʱֵΪ3ֱڻعű
+
+׼Ŀ¼ڵGolden_*.csvʹLD_NUGM06T¿õĻ׼
+	Golden_PI.csv          Ĭ(PI)
+	Golden_Model.csv       -DEnableModelThermalCtrl
+	Golden_TurboBudget.csv -DEnableTurboEnergyBudget
+-checkݲΪ½ʱCheckSettleTol(Ƿ±һ)CheckOvershootTol
+(0.1)ʱCheckFullTimeTol룬ƽCheckAvgCurrentTol(0.1%)޸¿ز֮ȷµĽԤڣ
+-csvɶӦĻ׼ʹһύ
+
+**	History: Initial Release
+**
+*****************************************************************************/
+/****************************************************************************/
+/*	include files
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ADCCfg.h"
+#include "ModeControl.h"
+#include "TempControl.h"
+#include "OutputChannel.h"
+#include "BattDisplay.h"
+#include "SelfTest.h"
+
+/****************************************************************************/
+/*	Local pre-processor symbols/macros('#define')
+****************************************************************************/
+#define TickPerSecond 8 //¿Ƶ(8Hz͹̼һ)
+#define RunTime 1200 //ÿʱ()
+#define ConstantTempX10 450 //̼ں¶(0.1)TempControl.cһ
+#define SettleBandX10 10 //½жΧ(1)
+#define LDDiffRes 0.6 //ܵͨĶ̬()
+#define LDHeatFraction 0.8 //繦бΪı(LDĵתЧʺDCDC)
+#define CheckSettleTol 30 //-checkģʽº½ʱݲ()
+#define CheckOvershootTol 3 //-checkģʽ³ݲ(0.1)
+#define CheckAvgCurrentTol 20 //-checkģʽƽݲ(0.1%)
+#define CheckFullTimeTol 5 //-checkģʽʱݲ()
+
+/****************************************************************************/
+/*	Local type definitions('typedef')
+****************************************************************************/
+typedef struct
+	{
+	const char *Name; //
+	double Capacity; //(J/K)
+	double Resistance; //ǵ(K/W)
+	double Ambient; //¶()
+	double SensorTau; //NTCǵӦʱ䳣()
+	ModeIdxDef StartMode; //λ
+	}BenchPlantDef;
+
+typedef struct
+	{
+	int SettleTime; //һ뿪·Χʱ()-1ʾûдﵽ
+	int Overshoot; //¶ȵֵ(0.1)
+	int CutoffTime; //ǿ˳ʱ()-1ʾûд
+	int ShutDownTime; //ȹػʱ()-1ʾûд
+	int FullTime; //λһα¿֮ǰʱ()-1ʾʼûб
+	long AvgCurrent; //ƽ(mA)
+	int CurrentPP; //1/4ʱķֵ(mA)
+	int TempPP; //1/4ʱ¶ȵķֵ(0.1)
+	}BenchResultDef;
+
+/****************************************************************************/
+/*	Global variable definitions(̼ģṩTempControl.cı)
+****************************************************************************/
+ADCResultStrDef Data;
+ModeStrDef code *CurrentMode;
+int Current;
+int CurrentBuf;
+BattVshowFSMDef VshowFSMState=BattVdis_Waiting;
+FaultCodeDef ErrCode=Fault_None;
+
+/****************************************************************************/
+/*	Local variable  definitions('static')
+****************************************************************************/
+static const BenchPlantDef PlantList[]=
+	{
+	{"Small host 25C still air",40,8,25,5,Mode_Turbo},
+	{"Small host 35C still air",40,8,35,5,Mode_Turbo},
+	{"Small host 0C still air",40,8,0,5,Mode_Turbo},
+	{"Small host 25C airflow",40,3,25,5,Mode_Turbo},
+	{"Large host 25C still air",120,5,25,10,Mode_Turbo},
+	{"Large host 35C still air",120,5,35,10,Mode_Turbo},
+	{"Large host 25C airflow",120,2,25,10,Mode_Turbo},
+	{"Small host 25C high",40,8,25,5,Mode_High},
+	{"Small host 35C high",40,8,35,5,Mode_High},
+	{"Large host 35C high",120,5,35,10,Mode_High}
+	};
+
+#define PlantCount (int)(sizeof(PlantList)/sizeof(BenchPlantDef))
+
+static ModeStrDef ModeLow,ModeHigh,ModeTurbo; //̨õĵλ
+
+/****************************************************************************/
+/*	Function implementation - local('static')
+****************************************************************************/
+
+//ʼ̨õĵλԱʱѡLDļ
+static void BenchModeInit(ModeStrDef *Mode,ModeIdxDef Idx,int ModeCurrent)
+	{
+	memset(Mode,0,sizeof(ModeStrDef));
+	Mode->ModeIdx=Idx;
+	Mode->Current=ModeCurrent;
+	Mode->IsNeedStepDown=true;
+	}
+
+//͹̼SwitchToGearһµĻ
+static void BenchSwitchToGear(ModeStrDef *Target)
+	{
+	bool IsLastModeNeedStepDown=CurrentMode->IsNeedStepDown;
+	CurrentMode=Target;
+	if(IsLastModeNeedStepDown)RecalcPILoop(Current);
+	}
+
+//е
+static void BenchRunPlant(const BenchPlantDef *Plant,BenchResultDef *Result,int IsTrace)
+	{
+	double HostTemp,SensorTemp,Vout,Heat,dt;
+	long Tick,CurrentSum=0;
+	int Sec,ILIM,CurMin=0x7FFF,CurMax=0,TempMin=0x7FFF,TempMax=-0x7FFF,IsReached=0;
+	//ʼλ͹̼
+	BenchModeInit(&ModeLow,Mode_Low,LDLowCurrent);
+	BenchModeInit(&ModeHigh,Mode_High,LDHighCurrent);
+	BenchModeInit(&ModeTurbo,Mode_Turbo,LDICCMAX);
+	CurrentMode=Plant->StartMode==Mode_Turbo?&ModeTurbo:&ModeHigh;
+	Current=0;
+	CurrentBuf=0;
+	Data.IsNTCOK=true;
+	memset(Result,0,sizeof(BenchResultDef));
+	Result->SettleTime=-1;
+	Result->CutoffTime=-1;
+	Result->ShutDownTime=-1;
+	Result->FullTime=-1;
+	//Ǵӻ¶ȿʼ
+	HostTemp=Plant->Ambient;
+	SensorTemp=Plant->Ambient;
+	dt=1.0/TickPerSecond;
+	if(IsTrace)printf("Time(s),HostTemp(C),NTCTemp(C),ModeCurrent(mA),OutputCurrent(mA)\n");
+	for(Tick=0;Tick<(long)RunTime*TickPerSecond;Tick++)
+		{
+		Sec=(int)(Tick/TickPerSecond);
+		//ģ
+		Vout=CurrentBuf>0?LDThresholdVolt+(CurrentBuf*LDDiffRes):0;
+		Heat=(Vout*CurrentBuf*LDHeatFraction)/1000000.0;
+		HostTemp+=((Heat-((HostTemp-Plant->Ambient)/Plant->Resistance))*dt)/Plant->Capacity;
+		SensorTemp+=((HostTemp-SensorTemp)*dt)/Plant->SensorTau;
+		//ADCADCCfg.c봦һ
+		Data.SystempX10=(int)(SensorTemp*10+(SensorTemp<0?-0.5:0.5));
+		if(Data.SystempX10<0)Data.Systemp=(Data.SystempX10-5)/10;
+		else Data.Systemp=(Data.SystempX10+5)/10;
+		Data.OutputVoltage=(int)Vout;
+		//¶ȹȹػ
+		ThermalMgmtProcess();
+		if(ErrCode==Fault_OverHeat)
+			{
+			Result->ShutDownTime=Sec;
+			break;
+			}
+		//͹̼λ״̬һ£¶ȴﵽ޺ǿƷص
+		if(CurrentMode->ModeIdx==Mode_Turbo&&IsForceLeaveTurbo)
+			{
+			if(Result->CutoffTime<0)Result->CutoffTime=Sec;
+			BenchSwitchToGear(&ModeLow);
+			}
+		Current=QueryCurrentGearILED();
+		IsPauseStepDownCalc=Current<450?1:0;
+		//¿PIͨ
+		ThermalPILoopCalc();
+		ILIM=ThermalILIMCalc();
+		CurrentBuf=Current<ILIM?Current:ILIM;
+		//ͳƽ
+		CurrentSum+=CurrentBuf;
+		if(Result->FullTime<0&&CurrentBuf<Current)Result->FullTime=Sec;
+		if(Data.SystempX10-ConstantTempX10>Result->Overshoot)Result->Overshoot=Data.SystempX10-ConstantTempX10;
+		if(Data.SystempX10>=ConstantTempX10-SettleBandX10)IsReached=1;
+		if(IsReached&&(Data.SystempX10>ConstantTempX10+SettleBandX10||Data.SystempX10<ConstantTempX10-SettleBandX10))Result->SettleTime=Sec;
+		if(Tick>=((long)RunTime*TickPerSecond*3)/4)
+			{
+			if(CurrentBuf<CurMin)CurMin=CurrentBuf;
+			if(CurrentBuf>CurMax)CurMax=CurrentBuf;
+			if(Data.SystempX10<TempMin)TempMin=Data.SystempX10;
+			if(Data.SystempX10>TempMax)TempMax=Data.SystempX10;
+			}
+		if(IsTrace&&!(Tick%TickPerSecond))printf("%d,%.2f,%.1f,%d,%d\n",Sec,HostTemp,Data.SystempX10/10.0,Current,CurrentBuf);
+		}
+	//ͳƽ
+	Result->AvgCurrent=CurrentSum/(Tick?Tick:1);
+	Result->CurrentPP=CurMax>=CurMin?CurMax-CurMin:0;
+	Result->TempPP=TempMax>=TempMin?TempMax-TempMin:0;
+	//ûдﵽ·Χ߽ʱȻں·Χ֮⣬ʱЧ
+	if(!IsReached||Result->SettleTime>=RunTime-1)Result->SettleTime=-1;
+	else if(Result->SettleTime<0)Result->SettleTime=0;
+	}
+
+//Ľ
+static void BenchPrintResult(int Index,const BenchResultDef *Result,int IsCSV)
+	{
+	const char *Fmt;
+	Fmt=IsCSV?"%d,%s,%d,%d.%d,%d,%d,%ld,%d,%d.%d,%d\n":"%-3d%-28s%-10d%4d.%-6d%-10d%-10d%-10ld%-10d%3d.%-6d%d\n";
+	printf(Fmt,Index,PlantList[Index].Name,Result->SettleTime,
+		Result->Overshoot/10,Result->Overshoot%10,
+		Result->CutoffTime,Result->ShutDownTime,Result->AvgCurrent,Result->CurrentPP,
+		Result->TempPP/10,Result->TempPP%10,Result->FullTime);
+	}
+
+//-csvʽһннźͽʽ󷵻0
+static int BenchParseResult(const char *Line,int *Index,BenchResultDef *Result)
+	{
+	int OSInt,OSFrac,TPPInt,TPPFrac;
+	memset(Result,0,sizeof(BenchResultDef));
+	if(sscanf(Line,"%d,%*[^,],%d,%d.%d,%d,%d,%ld,%d,%d.%d,%d",Index,&Result->SettleTime,&OSInt,&OSFrac,
+		&Result->CutoffTime,&Result->ShutDownTime,&Result->AvgCurrent,&Result->CurrentPP,&TPPInt,&TPPFrac,&Result->FullTime)!=11)return 0;
+	Result->Overshoot=(OSInt*10)+OSFrac;
+	Result->TempPP=(TPPInt*10)+TPPFrac;
+	return 1;
+	}
+
+//Ĳֵľֵ(FastOp.hڵabsûűڱʽ)
+static int BenchAbsDiff(int A,int B)
+	{
+	return A>B?A-B:B-A;
+	}
+
+//ԱȵĽͻ׼ݲ1ԭ
+static int BenchCompareResult(int Index,const BenchResultDef *Result,const BenchResultDef *Golden)
+	{
+	int IsDrift=0;
+	long Tol;
+	//½ʱ䣬Ƿ±һ
+	if((Result->SettleTime<0)!=(Golden->SettleTime<0)||BenchAbsDiff(Result->SettleTime,Golden->SettleTime)>CheckSettleTol)
+		{
+		printf("    #%d settle time %d s, golden %d s (tolerance %d s)\n",Index,Result->SettleTime,Golden->SettleTime,CheckSettleTol);
+		IsDrift=1;
+		}
+	//
+	if(BenchAbsDiff(Result->Overshoot,Golden->Overshoot)>CheckOvershootTol)
+		{
+		printf("    #%d overshoot %d.%d C, golden %d.%d C (tolerance 0.%d C)\n",Index,
+			Result->Overshoot/10,Result->Overshoot%10,Golden->Overshoot/10,Golden->Overshoot%10,CheckOvershootTol);
+		IsDrift=1;
+		}
+	//ʱ䣬Ƿһ
+	if((Result->FullTime<0)!=(Golden->FullTime<0)||BenchAbsDiff(Result->FullTime,Golden->FullTime)>CheckFullTimeTol)
+		{
+		printf("    #%d full output time %d s, golden %d s (tolerance %d s)\n",Index,Result->FullTime,Golden->FullTime,CheckFullTimeTol);
+		IsDrift=1;
+		}
+	//ƽ
+	Tol=(Golden->AvgCurrent*CheckAvgCurrentTol)/1000;
+	if(labs(Result->AvgCurrent-Golden->AvgCurrent)>Tol)
+		{
+		printf("    #%d average current %ld mA, golden %ld mA (tolerance %d.%d%%)\n",Index,
+			Result->AvgCurrent,Golden->AvgCurrent,CheckAvgCurrentTol/10,CheckAvgCurrentTol%10);
+		IsDrift=1;
+		}
+	//ȹػǿ˳״̬һ
+	if((Result->ShutDownTime<0)!=(Golden->ShutDownTime<0)||(Result->CutoffTime<0)!=(Golden->CutoffTime<0))
+		{
+		printf("    #%d turbo cutoff or overheat shutdown differs from golden\n",Index);
+		IsDrift=1;
+		}
+	return IsDrift;
+	}
+
+//ȫͻ׼ļԱȣݲ3
+static int BenchCheckGolden(const char *Self,const char *GoldenFile)
+	{
+	FILE *fp,*Pipe;
+	char Cmd[512],Line[256];
+	BenchResultDef Result,Golden[PlantCount];
+	int i,Index,IsLoaded[PlantCount],DriftCount=0,Ret=0;
+	//ȡ׼
+	fp=fopen(GoldenFile,"r");
+	if(fp==NULL)
+		{
+		fprintf(stderr,"Unable to open golden file %s\n",GoldenFile);
+		return 1;
+		}
+	memset(IsLoaded,0,sizeof(IsLoaded));
+	while(fgets(Line,sizeof(Line),fp)!=NULL)
+		if(BenchParseResult(Line,&Index,&Result)&&Index>=0&&Index<PlantCount)
+			{
+			Golden[Index]=Result;
+			IsLoaded[Index]=1;
+			}
+	fclose(fp);
+	//вԱ(ÿһΣԭmain)
+	printf("%-3s%-28s%-10s%-11s%-10s%-10s%-10s%-10s%-10s%s\n","#","Scenario","Settle(s)","Overshoot","Cutoff(s)","OHOff(s)","Avg(mA)","IPP(mA)","TPP(C)","Full(s)");
+	for(i=0;i<PlantCount;i++)
+		{
+		sprintf(Cmd,"\"%s\" -run %d -csv",Self,i);
+		Pipe=popen(Cmd,"r");
+		if(Pipe==NULL||fgets(Line,sizeof(Line),Pipe)==NULL||!BenchParseResult(Line,&Index,&Result))
+			{
+			fprintf(stderr,"Scenario %d failed to run\n",i);
+			if(Pipe!=NULL)pclose(Pipe);
+			return 1;
+			}
+		if(pclose(Pipe))Ret=2;
+		BenchPrintResult(i,&Result,0);
+		if(!IsLoaded[i])
+			{
+			printf("    #%d missing in golden file\n",i);
+			DriftCount++;
+			}
+		else DriftCount+=BenchCompareResult(i,&Result,&Golden[i]);
+		}
+	//
+	if(DriftCount)
+		{
+		printf("%d scenario(s) drifted from %s\n",DriftCount,GoldenFile);
+		return 3;
+		}
+	printf("All scenarios match %s\n",GoldenFile);
+	return Ret;
+	}
+
+/****************************************************************************/
+/*	Function implementation - global ('extern')
+****************************************************************************/
+
+//̼ģṩTempControl.cĺ
+bit GetIfOutputEnabled(void)
+	{
+	return CurrentBuf>0?1:0;
+	}
+
+void ReportError(FaultCodeDef Code)
+	{
+	ErrCode=Code;
+	}
+
+void ClearError(void)
+	{
+	ErrCode=Fault_None;
+	}
+
+int main(int argc,char *argv[])
+	{
+	BenchResultDef Result;
+	char Cmd[512];
+	const char *GoldenFile=NULL;
+	int i,Run=-1,IsCSV=0,IsTrace=0,Ret=0;
+	//в
+	for(i=1;i<argc;i++)
+		{
+		if(!strcmp(argv[i],"-csv"))IsCSV=1;
+		else if(!strcmp(argv[i],"-trace"))IsTrace=1;
+		else if(!strcmp(argv[i],"-run")&&i+1<argc)Run=atoi(argv[++i]);
+		else if(!strcmp(argv[i],"-check")&&i+1<argc)GoldenFile=argv[++i];
+		else
+			{
+			fprintf(stderr,"Usage:%s [-csv] [-run n [-trace]] [-check golden.csv]\n",argv[0]);
+			return 1;
+			}
+		}
+	if(Run>=PlantCount||(IsTrace&&Run<0)||(GoldenFile!=NULL&&Run>=0))
+		{
+		fprintf(stderr,"Invalid scenario,valid range is 0-%d, -trace requires -run and -check runs all scenarios\n",PlantCount-1);
+		return 1;
+		}
+	//ͻ׼Ա
+	if(GoldenFile!=NULL)return BenchCheckGolden(argv[0],GoldenFile);
+	//е
+	if(Run>=0)
+		{
+		BenchRunPlant(&PlantList[Run],&Result,IsTrace);
+		if(!IsTrace)BenchPrintResult(Run,&Result,IsCSV);
+		return Result.ShutDownTime>=0?2:0;
+		}
+	/**************************************************************
+	¿ģ״̬ȫTempControl.cڵľ̬޷ڳ֮
+	λÿʹ-runһαУ֤
+	ÿȫͬĳʼ״̬ʼ
+	**************************************************************/
+	if(IsCSV)printf("Index,Scenario,SettleTime(s),Overshoot(C),TurboCutoff(s),OverHeatOff(s),AvgCurrent(mA),CurrentPP(mA),TempPP(C),FullOutput(s)\n");
+	else printf("%-3s%-28s%-10s%-11s%-10s%-10s%-10s%-10s%-10s%s\n","#","Scenario","Settle(s)","Overshoot","Cutoff(s)","OHOff(s)","Avg(mA)","IPP(mA)","TPP(C)","Full(s)");
+	for(i=0;i<PlantCount;i++)
+		{
+		fflush(stdout);
+		sprintf(Cmd,"\"%s\" -run %d%s",argv[0],i,IsCSV?" -csv":"");
+		if(system(Cmd))Ret=2;
+		}
+	return Ret;
+	}